@@ -0,0 +1,55 @@
+-- daily_attendance.sql
+-- 일자별 근태 요약 테이블 + gate_check 삽입 시 증분 갱신 트리거
+--
+-- 배경
+--  - 근태 조회가 매번 gate_check 원본을 DATE(check_time)로 GROUP BY 했다.
+--    DATE()를 씌운 열은 인덱스를 못 타므로 기간이 길수록 원본 전체 스캔에 가까워진다.
+--  - 요약 테이블은 (day, emp_id)당 1행 → 조회 비용이 O(일수 × 인원)으로 고정된다.
+--
+-- 적용 순서
+--  1) mysql -h <host> -u <user> -p safetydb < daily_attendance.sql
+--  2) python3 출입/attendance_tools.py backfill        (기존 gate_check로 요약 채우기, 1회)
+--     - 트리거 생성 후 backfill을 돌리면, 그 사이 들어온 행도 LEAST/GREATEST 병합이라 중복 반영되지 않는다
+--       (check_count만 겹칠 수 있음 → backfill은 check_count를 원본 기준으로 다시 계산한다)
+--
+-- 열 의미
+--  - first_in / last_out : 그날 첫/마지막 게이트 통과 시각(입/퇴근 구분이 없는 스키마 → MIN/MAX)
+--  - worked_sec          : last_out - first_in (초)
+--  - check_count         : 그날 통과 기록 수(중복 포함, 압축/재계산 시 보정)
+--  - updated_at          : 마지막 갱신 시각(클라이언트 증분 동기화의 기준점)
+
+CREATE TABLE IF NOT EXISTS `daily_attendance` (
+  `day`         DATE         NOT NULL,
+  `emp_id`      INT          NOT NULL,
+  `first_in`    DATETIME     NOT NULL,
+  `last_out`    DATETIME     NOT NULL,
+  `worked_sec`  INT          NOT NULL DEFAULT 0,
+  `check_count` INT          NOT NULL DEFAULT 0,
+  `updated_at`  TIMESTAMP(3) NOT NULL DEFAULT CURRENT_TIMESTAMP(3) ON UPDATE CURRENT_TIMESTAMP(3),
+  PRIMARY KEY (`day`, `emp_id`),
+  KEY `idx_da_day_desc` (`day` DESC, `emp_id`),   -- 근태 표 정렬(최신 일자 DESC, 사번 ASC)과 동일 순서
+  KEY `idx_da_emp_day` (`emp_id`, `day`),
+  KEY `idx_da_updated` (`updated_at`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+-- 원본 조회(원본 CSV 내보내기/백필/압축)에 쓰이는 gate_check 인덱스
+-- (이미 있으면 오류가 나므로 한 번만 실행)
+-- ALTER TABLE `gate_check` ADD KEY `idx_gc_time` (`check_time`), ADD KEY `idx_gc_emp_time` (`emp_id`, `check_time`);
+
+DROP TRIGGER IF EXISTS `trg_gate_check_daily`;
+
+DELIMITER $$
+CREATE TRIGGER `trg_gate_check_daily`
+AFTER INSERT ON `gate_check`
+FOR EACH ROW
+BEGIN
+  -- ON DUPLICATE KEY UPDATE의 대입은 왼쪽부터 갱신된 값을 사용 → worked_sec는 새 first_in/last_out 기준
+  INSERT INTO `daily_attendance` (`day`, `emp_id`, `first_in`, `last_out`, `worked_sec`, `check_count`)
+  VALUES (DATE(NEW.check_time), NEW.emp_id, NEW.check_time, NEW.check_time, 0, 1)
+  ON DUPLICATE KEY UPDATE
+    `first_in`    = LEAST(`first_in`, NEW.check_time),
+    `last_out`    = GREATEST(`last_out`, NEW.check_time),
+    `worked_sec`  = TIMESTAMPDIFF(SECOND, `first_in`, `last_out`),
+    `check_count` = `check_count` + 1;
+END$$
+DELIMITER ;
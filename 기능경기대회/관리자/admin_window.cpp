@@ -16,7 +16,6 @@
 #include <QSizePolicy>                   // 위젯 크기 정책(버튼 높이 고정 등)
 #include <QButtonGroup>                  // 메뉴 라디오 그룹(단일 선택 보장)
 #include <QCoreApplication>              // 실행 파일 경로(ini 로딩)
-#include <QSettings>                     // INI 설정 읽기(카메라 URL)
 #include <QJsonValue>                    // JSON 값 타입 유틸
 #include <QJsonObject>                   // JSON 오브젝트(서버 메시지)
 #include <QJsonDocument>                 // JSON 직렬화(로그/표시)
@@ -32,6 +31,7 @@
 #include "manual_control_page.h"
 #include "camera_viewer_page.h"
 #include "notification.h"
+#include "clip_recorder.h"
 
 AdminWindow::AdminWindow(QWidget* parent)
     : QWidget(parent)
@@ -301,18 +301,21 @@ void AdminWindow::buildUi() {
 
     root->addWidget(stack, 1);                       // 우측 스택: stretch 1(남는 너비 차지)
 
-    // ✅ 초기 카메라 URL을 INI에서 읽어 주입 (없으면 빈 문자열 유지)
-    {
-        QSettings ini(QCoreApplication::applicationDirPath() + "/admin_client.ini",
-                      QSettings::IniFormat);         // 실행 파일 옆의 INI 로딩
-        ini.beginGroup("camera");                    // [camera] 섹션
-        const QString entrance = ini.value("entrance_url").toString(); // 출입구 카메라 URL
-        const QString fire     = ini.value("fire_url").toString();     // 화재 카메라 URL
-        ini.endGroup();
-
-        monPage->setEntranceCamUrl(entrance);        // 모니터링 타일에 초기 URL 주입
-        monPage->setFireCamUrl(fire);
-    }
+    // ✅ 카메라 목록/영상 벽 배치를 INI에서 읽어 타일 구성 ([camera], [wall])
+    monPage->loadCameras(QCoreApplication::applicationDirPath() + "/admin_client.ini");
+
+    // 화재 증거 녹화: 카메라 스트림을 계속 받아 사건 이전 구간을 메모리에 보관
+    clipRecorder = new ClipRecorder(this);
+    connect(clipRecorder, &ClipRecorder::clipSaved, this, [this](const QString& path, int frames) {
+        if (alertsPage)
+            alertsPage->appendNotification(u8"화재 영상 저장",
+                                           QString::fromUtf8("%1 (%2프레임)").arg(path).arg(frames));
+    });
+    connect(clipRecorder, &ClipRecorder::clipFailed, this, [this](const QString& path, const QString& error) {
+        if (alertsPage)
+            alertsPage->appendNotification(u8"화재 영상 저장 실패",
+                                           QString::fromUtf8("%1 — %2 (이 카메라 녹화 중단)").arg(path, error));
+    });
 
     // 모니터링에서 특정 카메라 선택 시 단일 뷰로 전환
     connect(monPage, &MonitoringPage::cameraSelected,
@@ -592,6 +595,8 @@ void AdminWindow::handleServerMessage(const QJsonObject& msg) {
                     lastFireConfirmedMs_ = now;                        // 마지막 확정 시각 갱신
                 }
             }
+            // 녹화는 쿨다운과 무관하게 확정이 올 때마다 연장(사건이 이어지는 동안 계속 저장)
+            if (clipRecorder) clipRecorder->trigger(id);
             return;      // 확정 이벤트는 이중 기록 방지를 위해 Alerts 포워딩 차단
         }
         // (2) 세션 종료: 후속 처리(업로드/정리) 전환 시점 알림
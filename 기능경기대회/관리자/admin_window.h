@@ -27,6 +27,7 @@ class SettingsPage;          // 설정/권한(초기 권한/유저 목록 요청
 class ManualControlPage;     // 설비 수동 제어(ESTOP/문/가동 상태 표시·명령)
 class CameraViewerPage;      // 단일 카메라 확대 뷰(뒤로가기 내장)
 class NotificationListPopup; // 알림 목록 팝업(배지 클릭으로 토글)
+class ClipRecorder;          // 화재 사건 증거 영상 녹화(사건 이전 구간 포함)
 
 // ===== 메인 윈도우(좌측 사이드바 + 우측 스택) =====
 class AdminWindow : public QWidget {
@@ -112,6 +113,7 @@ private:
     AlertsPage*        alertsPage{};     // 알림 로그(appendJson/브릿지 이벤트 소스)
     ManualControlPage* manualPage{};     // 설비 수동 조작(ESTOP/문/가동)
     CameraViewerPage*  camViewer{};      // 단일 카메라 뷰(뒤로 전환 포함)
+    ClipRecorder*      clipRecorder{};   // FIRE_EVENT 확정 시 카메라 영상 저장([record] 설정)
 
     // ===================== 사이드바(메뉴/버튼) =====================
     QButtonGroup* menuGroup{}; // 메뉴 단일 선택 보장(라디오 그룹 역할)
@@ -17,6 +17,19 @@
 #include <QThread>                // 스레드 확인(메인/UI 스레드 보장)
 #include <QApplication>           // qApp (전역 QApplication 인스턴스 접근)
 #include <QMetaObject>            // invokeMethod(스레드 전환/큐잉)
+#include <QBrush>                 // 폭주 행 배경색
+#include <QFileDialog>            // CSV 저장 경로 선택
+#include <QDir>                   // 기본 저장 위치(홈 디렉터리)
+
+#include "table_fit.h"            // 표본 기반 열 너비 추정(ResizeToContents 대체)
+#include "csv_export.h"           // 백그라운드 CSV 내보내기
+
+namespace {
+// 표 열 번호(7열 스키마)
+enum AlertCol { ColTime = 0, ColType, ColLevel, ColState, ColLoc, ColCount, ColDesc, ColTotal };
+constexpr int kMaxRows = 1000;     // 행 수 상한(무한 증가 방지)
+const QColor kBurstBg("#fff4d6");  // 폭주 행 배경(옅은 주황)
+}
 
 // ---- 관리자/설정 계열 메시지 필터 (표에 표시하지 않음) ----
 // - 유저/관리자 관리용 트래픽(리스트, 추가/수정/삭제)은 Alerts 테이블의 "사고/이벤트 로그"
@@ -89,6 +102,10 @@ void AlertsPage::buildUi() {
     btnRefresh = new QPushButton(u8"새로고침", this);
     btnRefresh->setObjectName("priBtn"); // 스타일 시트에서 프라이머리 버튼 룩 적용
 
+    // CSV 내보내기(표 값만 GUI 스레드에서 복사, 파일 기록은 워커 스레드)
+    btnExport = new QPushButton(u8"CSV 내보내기", this);
+    connect(btnExport, &QPushButton::clicked, this, &AlertsPage::exportCsv);
+
     // 필터 바 레이아웃 구성
     bar->addWidget(new QLabel(u8"기간"));
     bar->addWidget(startDate);
@@ -101,22 +118,26 @@ void AlertsPage::buildUi() {
     bar->addWidget(new QLabel(u8"레벨"));
     bar->addWidget(levelCombo);
     bar->addStretch();            // 우측 정렬: 새로고침 버튼을 맨 오른쪽으로
+    bar->addWidget(btnExport);
     bar->addWidget(btnRefresh);
 
     root->addLayout(bar);
 
-    // 이벤트 테이블 구성(6열: 시간, 유형, 레벨, 상태, 위치/라인, 설명)
-    table = new QTableWidget(0, 6, this);
+    // 이벤트 테이블 구성(7열: 시간, 유형, 레벨, 상태, 위치/라인, 횟수, 설명)
+    // - 시간 = 마지막 수신 시각(집계 행은 최초 시각을 툴팁으로)
+    table = new QTableWidget(0, ColTotal, this);
     table->setObjectName("alertsTable");
-    QStringList headers{u8"시간", u8"유형", u8"레벨", u8"상태", u8"위치/라인", u8"설명"};
+    QStringList headers{u8"시간", u8"유형", u8"레벨", u8"상태", u8"위치/라인", u8"횟수", u8"설명"};
     table->setHorizontalHeaderLabels(headers);
     table->horizontalHeader()->setStretchLastSection(true);         // 마지막 열(설명) 가변 확장
-    table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents); // 내용 기반 리사이즈
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);  // 전체 재측정(ResizeToContents) 대신 표본 추정
     table->verticalHeader()->setVisible(false);                     // 행 헤더 숨김
     table->setSelectionBehavior(QTableWidget::SelectRows);          // 행 단위 선택
     table->setEditTriggers(QTableWidget::NoEditTriggers);           // 사용자 편집 비활성화
     table->setAlternatingRowColors(true);                           // 홀/짝 줄 배경 교차
     table->setMinimumHeight(420);                                   // 최소 높이(스크롤 영역 확보)
+    table->setWordWrap(false);                                      // 긴 JSON 설명은 한 줄 + 말줄임(툴팁으로 전체 확인)
+    TableColumnFitter::install(table);                              // 표본 행 기반 열 너비 추정(유휴 시에만 재계산)
 
     root->addWidget(table, 1); // stretch=1: 테이블이 남는 세로 공간 채움
 
@@ -138,30 +159,15 @@ void AlertsPage::appendNotification(const QString& title, const QString& message
     }
 
     // 도착 시각 스탬프(로컬 시간대) — 외부에서 별도 ts 없을 때 사용
-    const QString ts = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-
-    // 테이블 최상단(행 0)에 새 알림 삽입
-    table->insertRow(0);
-    table->setItem(0,0,new QTableWidgetItem(ts));       // 시간
-    table->setItem(0,1,new QTableWidgetItem("NOTICE")); // 유형 고정: NOTICE
-    table->setItem(0,2,new QTableWidgetItem("INFO"));   // 레벨: INFO
-    table->setItem(0,3,new QTableWidgetItem("-"));      // 상태: 없음
-
-    auto *locItem  = new QTableWidgetItem(title.isEmpty()? "-" : title); // 위치/라인: 제목 대체
-    locItem->setToolTip(title);                                          // 전체 제목 툴팁
-    table->setItem(0,4,locItem);
-
-    auto *descItem = new QTableWidgetItem(message);      // 설명: 본문
-    descItem->setToolTip(message);                       // 전체 메시지 툴팁
-    table->setItem(0,5,descItem);
-
-    table->clearSelection();  // 삽입 후 포커스 표시 제거
-    table->scrollToTop();     // 맨 위로 스크롤(최신 항목 가시성 확보)
-
-    // 행 수 상한 관리(무한 증가 방지)
-    const int MAX_ROWS = 1000;
-    while (table->rowCount() > MAX_ROWS)
-        table->removeRow(table->rowCount()-1);
+    AlertRow r;
+    r.ts     = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
+    r.type   = "NOTICE";                      // 유형 고정: NOTICE
+    r.level  = "INFO";                        // 레벨: INFO
+    r.state  = "-";                           // 상태: 없음
+    r.loc    = title.isEmpty() ? "-" : title; // 위치/라인: 제목 대체
+    r.desc   = message;                       // 설명: 본문
+    r.source = title;                         // 같은 제목의 반복 알림은 한 행으로 집계
+    addRow(r);
 }
 
 void AlertsPage::appendJson(const QJsonObject& m)
@@ -191,78 +197,62 @@ void AlertsPage::appendJson(const QJsonObject& m)
     if (cmd == "FACTORY_DATA" || cmd == "FACTORY_UPDATE" || cmd == "FACTORY_DATA_PUSH")
         return;
 
+    // 집계 키 구성 요소: 출처(로봇 이름 등)와 사건(incident_id → session_id)
+    auto pick = [](const QJsonObject& o, std::initializer_list<const char*> keys)->QString {
+        for (const char* k : keys) {
+            const QJsonValue v = o.value(QLatin1String(k));
+            if (v.isString() && !v.toString().isEmpty()) return v.toString();
+            if (v.isDouble()) return QString::number(v.toVariant().toLongLong());
+        }
+        return QString();
+    };
+    const auto payload = m.value("payload").toObject();
+    AlertRow r;
+    r.source   = pick(m, {"robot", "name", "source", "from"});
+    r.incident = pick(m, {"incident_id", "session_id"});
+    if (r.incident.isEmpty()) r.incident = pick(payload, {"incident_id", "session_id"});
+    r.ts       = fmtTs(m);
+
     // ✅ FIRE_EVENT: 표에 축약 표시(핵심 필드만) 후 처리 종료
     // - 중복/이중 경로 기록 방지를 위해 일반 경로로 내려보내지 않음
     if (cmd == "FIRE_EVENT") {
-        const auto payload = m.value("payload").toObject();
         const QString ev    = payload.value("event").toString();      // 예: session_started / fire_confirmed
         const QString fname = payload.value("filename").toString();   // 관련 파일명(있을 때)
-        const QString ts    = fmtTs(m);
-
-        table->insertRow(0);
-        table->setItem(0, 0, new QTableWidgetItem(ts));               // 시간
-        table->setItem(0, 1, new QTableWidgetItem("FIRE_EVENT"));     // 유형
-        table->setItem(0, 2, new QTableWidgetItem("INFO"));           // 레벨(간단 고정)
-        table->setItem(0, 3, new QTableWidgetItem(ev));               // 상태 = payload.event
-        table->setItem(0, 4, new QTableWidgetItem("-"));              // 위치/라인 = 없음
-        auto *d = new QTableWidgetItem(fname.isEmpty() ? ev : fname); // 설명 = 파일명 또는 이벤트
-        d->setToolTip(fname);
-        table->setItem(0, 5, d);
-
-        table->clearSelection();
-        table->scrollToTop();
-        const int MAX_ROWS = 1000;
-        while (table->rowCount() > MAX_ROWS) table->removeRow(table->rowCount() - 1);
+
+        r.type  = "FIRE_EVENT";                   // 유형
+        r.kind  = ev;                             // 단계(session_started/fire_confirmed…)별로 따로 집계
+        r.level = "INFO";                         // 레벨(간단 고정)
+        r.state = ev;                             // 상태 = payload.event
+        r.loc   = "-";                            // 위치/라인 = 없음
+        r.desc  = fname.isEmpty() ? ev : fname;   // 설명 = 파일명 또는 이벤트
+        addRow(r);
         return;  // ⬅️ 일반 경로로 내려가지 않음(이중 기록 차단)
     }
 
-    // ↓ 일반 경로: 다양한 cmd를 공통 형식(6열)으로 테이블에 표준화하여 삽입
+    // ↓ 일반 경로: 다양한 cmd를 공통 형식(7열)으로 테이블에 표준화하여 삽입
     auto asText = [](const QJsonObject& o)->QString {
         return QString::fromUtf8(QJsonDocument(o).toJson(QJsonDocument::Compact)); // JSON 전체 축약 문자열
     };
 
-    const QString ts    = fmtTs(m);              // 시간(서버 ts 있으면 사용)
-    QString type        = cmd;                   // 유형 = cmd 기본
-    QString level       = m.value("level").toString().toUpper(); // 레벨(없으면 아래서 추론)
-    QString state       = "-";                   // 상태 기본값
-    QString loc         = m.value("saved_path").toString();      // 위치/라인: 우선순위 path 필드들
-    if (loc.isEmpty()) loc = m.value("path").toString();
-    if (loc.isEmpty()) loc = m.value("file").toString();
-    QString desc        = m.value("msg").toString();             // 설명: msg 없으면 원문 JSON
-
-    if (desc.isEmpty()) desc = asText(m);
+    r.type   = cmd;                                 // 유형 = cmd 기본
+    r.level  = m.value("level").toString().toUpper(); // 레벨(없으면 아래서 추론)
+    r.state  = "-";                                 // 상태 기본값
+    r.loc    = m.value("saved_path").toString();    // 위치/라인: 우선순위 path 필드들
+    if (r.loc.isEmpty()) r.loc = m.value("path").toString();
+    if (r.loc.isEmpty()) r.loc = m.value("file").toString();
+    r.desc   = m.value("msg").toString();           // 설명: msg 없으면 원문 JSON
+    if (r.desc.isEmpty()) r.desc = asText(m);
 
     // 레벨 기본값 추론 규칙(없을 때)
-    if (level.isEmpty()) {
-        if (cmd == "ROBOT_ERROR") level = "ERROR";
-        else if (cmd == "UPLOAD_DONE") level = m.value("ok").toBool() ? "INFO" : "ERROR";
-        else level = "INFO";
+    if (r.level.isEmpty()) {
+        if (cmd == "ROBOT_ERROR") r.level = "ERROR";
+        else if (cmd == "UPLOAD_DONE") r.level = m.value("ok").toBool() ? "INFO" : "ERROR";
+        else r.level = "INFO";
     }
-    // 상태 표시(UPLOAD_DONE 전용)
-    if (cmd == "UPLOAD_DONE") state = m.value("ok").toBool() ? "OK" : "FAIL";
+    // 상태 표시(UPLOAD_DONE 전용) — 성공/실패는 따로 집계
+    if (cmd == "UPLOAD_DONE") r.state = r.kind = m.value("ok").toBool() ? "OK" : "FAIL";
 
-    // 6열 스키마에 맞춰 한 행 삽입
-    table->insertRow(0);
-    table->setItem(0, 0, new QTableWidgetItem(ts));    // 시간
-    table->setItem(0, 1, new QTableWidgetItem(type));  // 유형
-    table->setItem(0, 2, new QTableWidgetItem(level)); // 레벨
-    table->setItem(0, 3, new QTableWidgetItem(state)); // 상태
-
-    auto *locItem = new QTableWidgetItem(loc);         // 위치/라인(파일/경로 등)
-    locItem->setToolTip(loc);
-    table->setItem(0, 4, locItem);
-
-    auto *descItem = new QTableWidgetItem(desc);       // 설명(요약/원문)
-    descItem->setToolTip(desc);
-    table->setItem(0, 5, descItem);
-
-    table->clearSelection();
-    table->scrollToTop();
-
-    // 행 수 상한 관리
-    const int MAX_ROWS = 1000;
-    while (table->rowCount() > MAX_ROWS)
-        table->removeRow(table->rowCount()-1);
+    addRow(r);
 
     // RobotPage 브릿지: 로봇 콘솔/미디어 재생/에러 상태와의 연동
     if (cmd == "UPLOAD_DONE" && m.value("ok").toBool()) {
@@ -277,6 +267,104 @@ void AlertsPage::appendJson(const QJsonObject& m)
     }
 }
 
+// ===== 집계 규칙 =====
+// - 키(유형+세분|출처|사건)가 같고 마지막 수신 후 aggWindowMs_ 이내면 기존 행을 갱신(창은 수신마다 연장)
+// - 그 외에는 최상단에 새 행을 삽입하고 집계 상태를 새로 시작
+// - 폭주: 같은 키가 burstWindowMs_ 안에 burstLimit_건을 넘으면 BURST 표시
+void AlertsPage::addRow(const AlertRow& r)
+{
+    const QString key = r.type + '/' + r.kind + '|' + r.source + '|' + r.incident;
+    const qint64 now  = QDateTime::currentMSecsSinceEpoch();
+
+    auto it = agg_.find(key);
+    if (it != agg_.end() && it->row.isValid() && now - it->lastMs <= aggWindowMs_) {
+        AggState& st = *it;
+        const int row = st.row.row();   // 영속 인덱스: 삽입/삭제로 밀려도 O(1)
+        st.count  += 1;
+        st.lastMs  = now;
+        st.recent.enqueue(now);
+        while (!st.recent.isEmpty() && now - st.recent.head() > burstWindowMs_) st.recent.dequeue();
+        while (st.recent.size() > burstLimit_ + 1) st.recent.dequeue();
+        if (!st.burst && st.recent.size() > burstLimit_) st.burst = true;
+
+        // 바뀐 셀만 갱신(새 아이템 생성 없음 → 폭주 중에도 dataChanged 몇 건으로 끝남)
+        auto setText = [&](int col, const QString& text, bool tip) {
+            QTableWidgetItem* cell = table->item(row, col);
+            if (!cell) { cell = new QTableWidgetItem; table->setItem(row, col, cell); }
+            if (cell->text() != text) cell->setText(text);
+            if (tip) cell->setToolTip(text);
+        };
+        setText(ColTime,  r.ts,    false);
+        table->item(row, ColTime)->setToolTip(QString(u8"최초 %1 / 마지막 %2").arg(st.firstTs, r.ts));
+        setText(ColLevel, r.level, false);
+        setText(ColState, st.burst ? "BURST " + r.state : r.state, false);
+        setText(ColLoc,   r.loc,   true);
+        setText(ColCount, QString::number(st.count), false);
+        setText(ColDesc,  r.desc,  true);
+        if (st.burst && table->item(row, ColType)->background().color() != kBurstBg) {
+            for (int c = 0; c < ColTotal; ++c)
+                if (auto* cell = table->item(row, c)) cell->setBackground(kBurstBg);
+        }
+        return;
+    }
+
+    // 새 행(최상단)
+    table->insertRow(0);
+    auto *timeItem = new QTableWidgetItem(r.ts);                 // 시간(마지막 수신)
+    timeItem->setData(Qt::UserRole, key);                        // 행 제거 시 집계 상태 정리에 사용
+    table->setItem(0, ColTime,  timeItem);
+    table->setItem(0, ColType,  new QTableWidgetItem(r.type));   // 유형
+    table->setItem(0, ColLevel, new QTableWidgetItem(r.level));  // 레벨
+    table->setItem(0, ColState, new QTableWidgetItem(r.state));  // 상태
+
+    auto *locItem = new QTableWidgetItem(r.loc);                 // 위치/라인(파일/경로 등)
+    locItem->setToolTip(r.loc);
+    table->setItem(0, ColLoc, locItem);
+
+    auto *cntItem = new QTableWidgetItem("1");                   // 횟수
+    cntItem->setTextAlignment(Qt::AlignCenter);
+    table->setItem(0, ColCount, cntItem);
+
+    auto *descItem = new QTableWidgetItem(r.desc);               // 설명(요약/원문)
+    descItem->setToolTip(r.desc);
+    table->setItem(0, ColDesc, descItem);
+
+    AggState st;
+    st.row     = table->model()->index(0, ColTime);
+    st.count   = 1;
+    st.lastMs  = now;
+    st.firstTs = r.ts;
+    st.recent.enqueue(now);
+    agg_.insert(key, st);   // 창이 지난 같은 키는 새 행으로 교체(이전 행은 기록으로 남음)
+
+    table->clearSelection();
+    table->scrollToTop();   // 맨 위로 스크롤(최신 항목 가시성 확보)
+    trimRows();
+}
+
+void AlertsPage::trimRows()
+{
+    while (table->rowCount() > kMaxRows) {
+        const int last = table->rowCount() - 1;
+        if (auto* it = table->item(last, ColTime)) {
+            const auto found = agg_.find(it->data(Qt::UserRole).toString());
+            if (found != agg_.end() && found->row.row() == last) agg_.erase(found);
+        }
+        table->removeRow(last);
+    }
+}
+
+void AlertsPage::exportCsv()
+{
+    const QString def = QDir::homePath() + "/alerts_"
+                      + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss") + ".csv";
+    const QString path = QFileDialog::getSaveFileName(this, u8"CSV로 내보내기", def, "CSV (*.csv)");
+    if (path.isEmpty()) return;
+
+    // 스냅샷 이후 들어오는 알림은 표에만 반영되고 파일에는 영향 없음
+    CsvExportJob::startWithProgress(CsvExportJob::fromModel(table->model(), path, this), this);
+}
+
 void AlertsPage::applyStyle() {
     // 페이지 배경 톤 지정(팔레트 기반) — 상위 스타일과 독립적으로 일괄 적용
     QPalette pal = palette();
@@ -2,19 +2,28 @@
 // 중복 인클루드 방지. 이 헤더는 AlertsPage(알람/이벤트 로그 화면)의 공개 인터페이스를 정의한다.
 
 #include <QWidget>    // QWidget 기반: 독립 페이지로서 UI 컨테이너 역할
+#include <QHash>      // 집계 키 → 행 상태
+#include <QQueue>     // 폭주 판정용 최근 수신 시각
+#include <QPersistentModelIndex>  // 행 삽입/삭제에도 유지되는 행 참조
 
 // ===== 전방 선언 (빌드 의존 최소화/컴파일 시간 최적화) =====
 class QLineEdit;      // 기간 필터 입력(시작/종료일)
 class QComboBox;      // 유형/레벨(심각도) 드롭다운
-class QPushButton;    // 새로고침 버튼
-class QTableWidget;   // 알람/이벤트 로그 테이블(6열 스키마)
+class QPushButton;    // 새로고침/CSV 내보내기 버튼
+class QTableWidget;   // 알람/이벤트 로그 테이블(7열 스키마)
 class QLabel;         // 페이지 타이틀/하단 페이지 라벨
 class QJsonObject;    // 서버 원시 메시지(JSON) 한 건
 
 // ===== 알람/이벤트 로그 페이지 =====
 // - 상단: 기간/유형/레벨 필터 + 새로고침
-// - 본문: 로그 테이블(시간/유형/레벨/상태/위치/설명)
+// - 본문: 로그 테이블(시간/유형/레벨/상태/위치/횟수/설명)
 // - 하단: 페이지 표시 라벨 (실제 페이징 연동은 선택)
+//
+// 집계/폭주 제어
+// - (유형, 출처, 사건) 키가 같은 알림이 aggWindowMs_(기본 10초, setAggregationWindow) 안에 반복되면
+//   새 행 대신 기존 행을 갱신(횟수 +1, 시간=마지막 수신, 레벨/상태/설명=최신 값, 툴팁에 최초 수신 시각)
+// - 같은 키가 폭주 창(burstWindowMs_) 안에서 허용치(burstLimit_)를 넘으면 행에 "BURST" 표시(상태 접두 + 배경색)
+// - 화재 세션 중 ROBOT_EVENT/UPLOAD_DONE 폭주에도 행 수와 렌더링 비용이 일정하게 유지된다.
 class AlertsPage : public QWidget
 {
     Q_OBJECT
@@ -32,9 +41,14 @@ public slots:
     // 서버에서 수신한 원시 JSON 메시지 한 건을 테이블 포맷으로 표준화하여 추가
     // - 관리자/설정류(HELLO/USER_*/ADMIN_* 등)와 FACTORY_* 상태 푸시는 표 노이즈를 줄이기 위해 제외
     // - FIRE_EVENT는 축약 필드만 표시 후 일반 경로로 내려보내지 않음(중복 기록 방지)
-    // - 다른 cmd는 공통 6열 스키마로 삽입(레벨/상태는 규칙에 따라 추론)
+    // - 다른 cmd는 공통 7열 스키마로 삽입(레벨/상태는 규칙에 따라 추론, 반복은 집계)
     void appendJson(const QJsonObject& m);
 
+public:
+    // 집계 파라미터(기본값: 10초 창, 5초에 10건 초과 시 폭주)
+    void setAggregationWindow(int ms)        { aggWindowMs_ = ms; }
+    void setBurstLimit(int count, int perMs) { burstLimit_ = count; burstWindowMs_ = perMs; }
+
 signals:
     // RobotPage로 이벤트를 브릿징하기 위한 시그널 세트
     // - 업로드 성공 시: 저장 경로와 원문 JSON을 전달(재생/미디어 열람 등 후속 처리 용도)
@@ -49,6 +63,21 @@ private:
     // - 타이틀 → 필터바 → 테이블 → 하단 라벨 순서
     void buildUi();
 
+    // 표준화된 한 건(7열 값 + 집계 키 구성 요소)
+    struct AlertRow {
+        QString ts, type, level, state, loc, desc;
+        QString kind;      // 유형 세분(같은 유형 안에서 따로 모을 값, 예: FIRE_EVENT의 payload.event)
+        QString source;    // 출처(로봇/클라이언트 이름 등, 없으면 빈 값)
+        QString incident;  // 사건 식별자(incident_id → session_id 순, 없으면 빈 값)
+    };
+    // 집계 규칙 적용: 창 안의 반복이면 기존 행 갱신, 아니면 최상단에 새 행 삽입
+    void addRow(const AlertRow& r);
+    // 행 수 상한 유지(잘려나가는 행의 집계 상태도 함께 정리)
+    void trimRows();
+
+    // 현재 표 내용을 CSV로 저장(워커 스레드 기록, 진행/취소 대화상자)
+    void exportCsv();
+
     // 페이지 전반의 룩앤필(폰트/색/버튼/테이블 헤더 등)을 적용한다.
     void applyStyle();
 
@@ -60,8 +89,23 @@ private:
     QComboBox*   typeCombo   = nullptr;  // 유형 필터(전체/침입/화재/근접/시스템 경고 등)
     QComboBox*   levelCombo  = nullptr;  // 레벨 필터(ALL/LOW/MEDIUM/HIGH/CRITICAL)
     QPushButton* btnRefresh  = nullptr;  // 새로고침 트리거(필터 적용/재조회와 연결 가능)
+    QPushButton* btnExport   = nullptr;  // CSV 내보내기(표 스냅샷 → 백그라운드 기록)
 
     // ===== 본문/하단 =====
-    QTableWidget* table      = nullptr;  // 알림/이벤트 로그 테이블(6열: 시간/유형/레벨/상태/위치/설명)
+    QTableWidget* table      = nullptr;  // 알림/이벤트 로그 테이블(7열: 시간/유형/레벨/상태/위치/횟수/설명)
     QLabel*       pagerLabel = nullptr;  // 하단 페이지 표시 라벨(“현재/전체 페이지” 단순 표기)
+
+    // ===== 집계 상태 =====
+    struct AggState {
+        QPersistentModelIndex row;   // 집계 행(0열) — insertRow(0)/removeRow에도 행 번호 자동 추적
+        int    count     = 0;        // 누적 수신 횟수
+        qint64 lastMs    = 0;        // 마지막 수신(클라이언트 시계, 창 판정용)
+        QString firstTs;             // 최초 수신 표시 시각(툴팁)
+        QQueue<qint64> recent;       // 폭주 창 안의 수신 시각(최대 burstLimit_+1개만 유지)
+        bool   burst     = false;    // 폭주 표시 여부(한 번 표시되면 행이 사라질 때까지 유지)
+    };
+    QHash<QString, AggState> agg_;   // 키 = 유형(+세분)|출처|사건
+    int aggWindowMs_   = 10000;
+    int burstLimit_    = 10;
+    int burstWindowMs_ = 5000;
 };
@@ -0,0 +1,311 @@
+#include "attendance_analytics.h"
+#include "db_service.h"
+#include <QtConcurrent>          // mappedReduced(날짜 구간 병렬 집계)
+#include <QThreadPool>
+#include <QSettings>             // [analytics] 섹션 읽기
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QMap>
+#include <algorithm>
+
+namespace {
+
+/*
+ * 연속 구간 요약(run-length 모노이드)
+ * - 한 파티션 안의 참/거짓 열을 (길이, 앞쪽 연속, 뒤쪽 연속, 최장)으로 줄인다.
+ * - 두 요약을 순서대로 이으면 경계를 넘는 연속(a의 뒤 + b의 앞)까지 정확히 합쳐진다.
+ */
+struct Run {
+    int len = 0, prefix = 0, suffix = 0, best = 0;
+
+    void push(bool hit) {
+        if (hit) {
+            if (prefix == len) ++prefix;   // 지금까지 전부 참이면 앞쪽 연속도 늘어남
+            ++suffix;
+            best = std::max(best, suffix);
+        } else {
+            suffix = 0;
+        }
+        ++len;
+    }
+    void append(const Run& b) {
+        Run r;
+        r.len    = len + b.len;
+        r.prefix = (prefix == len) ? len + b.prefix : prefix;
+        r.suffix = (b.suffix == b.len) ? b.len + suffix : b.suffix;
+        r.best   = std::max({best, b.best, suffix + b.prefix});
+        *this = r;
+    }
+};
+
+/// 사원 한 명의 누계(파티션 단위 → 병합)
+struct Acc {
+    int days = 0, late = 0, missingOut = 0, absent = 0;
+    qint64 workedSec = 0, overtimeSec = 0, lateSec = 0;
+    Run lateRun;     ///< 출근한 평일마다 지각 여부
+    Run absentRun;   ///< 평일마다 결근 여부(재직자)
+
+    void append(const Acc& b) {
+        days += b.days; late += b.late; missingOut += b.missingOut; absent += b.absent;
+        workedSec += b.workedSec; overtimeSec += b.overtimeSec; lateSec += b.lateSec;
+        lateRun.append(b.lateRun);
+        absentRun.append(b.absentRun);
+    }
+};
+using Partial = QHash<int, Acc>;
+
+/// 날짜 구간 하나(rows의 [begin, end) — rows는 day 오름차순)
+struct Partition {
+    QDate from, to;
+    int begin = 0, end = 0;
+};
+
+/// 병렬 작업이 공유하는 읽기 전용 입력
+struct Input {
+    QVector<QVector<QVariant>> rows;   ///< day, emp_id, name, department, first_in, worked_sec, check_count
+    QVector<QPair<int, QDate>> active; ///< 재직 사원(결근 판정 대상)과 첫 기록일(무효 = 기록 없음)
+    QDate today;                       ///< 결근은 이 날짜 전까지만(오늘은 아직 출근 전일 수 있음)
+    AnalyticsRules rules;
+};
+
+// SQLite 캐시는 시각을 문자열로, MySQL은 QDateTime으로 돌려준다
+QTime timeOf(const QVariant& v)
+{
+    if (v.typeId() == QMetaType::QDateTime) return v.toDateTime().time();
+    return QDateTime::fromString(v.toString(), "yyyy-MM-dd HH:mm:ss").time();
+}
+
+bool isWeekday(const QDate& d) { return d.dayOfWeek() <= 5; }
+
+Partial mapPartition(const Input& in, const Partition& p)
+{
+    Partial out;
+    const AnalyticsRules& R = in.rules;
+    const QTime lateAfter = R.startTime.addSecs(R.graceMin * 60);
+
+    int i = p.begin;
+    QSet<int> present;
+    for (QDate day = p.from; day <= p.to; day = day.addDays(1)) {
+        const bool weekday = isWeekday(day);
+        present.clear();
+
+        // 이 날짜의 행(정렬되어 있으므로 연속 구간)
+        for (; i < p.end && in.rows[i].value(0).toDate() == day; ++i) {
+            const auto& row = in.rows[i];
+            const int emp    = row.value(1).toInt();
+            const int worked = row.value(5).toInt();
+            const int checks = row.value(6).toInt();
+            Acc& a = out[emp];
+            present.insert(emp);
+
+            ++a.days;
+            a.workedSec   += worked;
+            a.overtimeSec += std::max(0, worked - R.standardSec);
+            if (checks <= 1 || worked < R.minSpanSec) ++a.missingOut;
+
+            if (weekday) {
+                const QTime firstIn = timeOf(row.value(4));
+                const bool late = firstIn.isValid() && firstIn > lateAfter;
+                a.lateRun.push(late);
+                if (late) {
+                    ++a.late;
+                    a.lateSec += R.startTime.secsTo(firstIn);
+                }
+            }
+        }
+
+        // 결근: 지난 평일만, 사원별로 첫 기록일 이후만(입사 전/미래/오늘 진행 중은 결근이 아님)
+        if (weekday && day < in.today) {
+            for (const auto& [emp, since] : in.active) {
+                if (!since.isValid() || day < since) continue;
+                const bool absent = !present.contains(emp);
+                Acc& a = out[emp];
+                a.absentRun.push(absent);
+                if (absent) ++a.absent;
+            }
+        }
+    }
+    return out;
+}
+
+// OrderedReduce: 파티션 순서대로 호출됨 → Run 이어 붙이기가 날짜 순서를 유지
+void mergePartial(Partial& total, const Partial& part)
+{
+    for (auto it = part.cbegin(); it != part.cend(); ++it)
+        total[it.key()].append(it.value());
+}
+
+} // namespace
+
+// ===================== AnalyticsRules =====================
+
+AnalyticsRules AnalyticsRules::fromIni(const QString& iniPath, const QString& group)
+{
+    AnalyticsRules r;
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup(group);
+    const QTime t = QTime::fromString(ini.value("start", r.startTime.toString("HH:mm")).toString(), "HH:mm");
+    if (t.isValid()) r.startTime = t;
+    r.graceMin    = qBound(0, ini.value("grace_min", r.graceMin).toInt(), 120);
+    r.standardSec = int(ini.value("standard_hours", r.standardSec / 3600.0).toDouble() * 3600);
+    r.minSpanSec  = qMax(0, ini.value("min_span_sec", r.minSpanSec).toInt());
+    ini.endGroup();
+    return r;
+}
+
+QString AnalyticsRules::key() const
+{
+    return QString("%1/%2/%3/%4").arg(startTime.toString("HH:mm")).arg(graceMin).arg(standardSec).arg(minSpanSec);
+}
+
+// ===================== AttendanceAnalytics =====================
+
+AttendanceAnalytics::AttendanceAnalytics(QObject* parent)
+    : QObject(parent)
+{
+}
+
+DbService* AttendanceAnalytics::service() const
+{
+    return svc_ ? svc_.data() : DbService::instance();
+}
+
+void AttendanceAnalytics::setService(DbService* svc)
+{
+    svc_ = svc;
+    cache_.clear();
+}
+
+void AttendanceAnalytics::compute(const QDate& from, const QDate& to)
+{
+    const quint64 gen = ++gen_;
+    running_.cancel();   // 이전 요청의 병렬 집계(남은 파티션은 건너뜀)
+    service()->cancelChannel("ana.employees");   // 이전 요청의 조회(대기/실행 중)
+    service()->cancelChannel("ana.rows");
+
+    const QString key = from.toString(Qt::ISODate) + '~' + to.toString(Qt::ISODate) + '|' + rules_.key();
+    if (AttendanceReportPtr* hit = cache_.object(key)) {
+        emit ready(*hit, true);
+        return;
+    }
+
+    const qint64 started = QDateTime::currentMSecsSinceEpoch();
+    DbService* db = service();
+    // 첫 기록일: 스키마에 입사일 열이 없으므로 그 사원의 가장 이른 근태 기록을 재직 시작으로 본다
+    db->submit("SELECT e.emp_id, e.name, e.department, "
+               "(SELECT MIN(d.day) FROM daily_attendance d WHERE d.emp_id = e.emp_id) "
+               "FROM employee e WHERE e.status = 1", {}, "ana.employees")
+        .then(this, [this, db, gen, from, to, key, started](const DbResult& e) {
+            if (gen != gen_ || e.canceled) return;
+            if (!e.ok) { emit failed(e.error); return; }
+
+            // 두 방언(MySQL/SQLite) 공통 SQL — 요약 행만 날짜 순으로(파티션 경계를 이분 탐색으로 찾음)
+            db->submit("SELECT d.day, d.emp_id, e.name, e.department, d.first_in, d.worked_sec, d.check_count "
+                       "FROM daily_attendance d LEFT JOIN employee e ON e.emp_id = d.emp_id "
+                       "WHERE d.day BETWEEN :from AND :to ORDER BY d.day, d.emp_id",
+                       {{":from", from.toString("yyyy-MM-dd")}, {":to", to.toString("yyyy-MM-dd")}},
+                       "ana.rows")
+                .then(this, [this, gen, from, to, key, started, emps = e.rows](const DbResult& r) {
+                    if (gen != gen_ || r.canceled) return;
+                    if (!r.ok) { emit failed(r.error); return; }
+                    aggregate(from, to, key, emps, r.rows, started);
+                });
+        });
+}
+
+void AttendanceAnalytics::aggregate(const QDate& from, const QDate& to, const QString& key,
+                                    const QVector<QVector<QVariant>>& employees,
+                                    const QVector<QVector<QVariant>>& rows, qint64 startedMs)
+{
+    auto in = std::make_shared<Input>();
+    in->rows  = rows;   // 암시적 공유 — 복사 비용 없음
+    in->rules = rules_;
+    in->today = QDate::currentDate();
+
+    // 이름/부서: 재직자 목록 + 행(퇴사자 기록도 표시)
+    QHash<int, QPair<QString, QString>> info;
+    for (const auto& e : employees) {
+        const int id = e.value(0).toInt();
+        // SQLite 캐시는 날짜를 문자열로, MySQL은 QDate로 돌려준다
+        const QVariant first = e.value(3);
+        const QDate since = first.typeId() == QMetaType::QDate
+                          ? first.toDate() : QDate::fromString(first.toString().left(10), "yyyy-MM-dd");
+        in->active << qMakePair(id, since);
+        info.insert(id, {e.value(1).toString(), e.value(2).toString()});
+    }
+
+    // 파티션: 스레드 수의 2배 정도로 나눠 부하가 고르게(구간별 행 수가 달라도 남는 스레드가 이어받음)
+    const int totalDays = int(from.daysTo(to)) + 1;
+    const int want      = qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 2);
+    const int span      = qMax(1, (totalDays + want - 1) / want);
+    QVector<Partition> parts;
+    auto lower = [&rows](const QDate& d) {
+        return int(std::lower_bound(rows.cbegin(), rows.cend(), d,
+                   [](const QVector<QVariant>& row, const QDate& v){ return row.value(0).toDate() < v; })
+                   - rows.cbegin());
+    };
+    for (QDate a = from; a <= to; a = a.addDays(span)) {
+        Partition p;
+        p.from  = a;
+        p.to    = std::min(to, a.addDays(span - 1));
+        p.begin = lower(p.from);
+        p.end   = lower(p.to.addDays(1));
+        parts << p;
+    }
+    std::shared_ptr<const Input> shared = in;
+
+    QFuture<Partial> f = QtConcurrent::mappedReduced<Partial>(
+        parts,
+        [shared](const Partition& p) { return mapPartition(*shared, p); },
+        mergePartial,
+        QtConcurrent::ReduceOptions(QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce));
+    running_ = f;
+
+    const quint64 gen = gen_;
+    const int nParts = parts.size();
+    f.then(this, [this, gen, from, to, key, startedMs, nParts, rows, info](const Partial& total) {
+        if (gen != gen_) return;
+
+        auto rep = std::make_shared<AttendanceReport>();
+        rep->from = from;
+        rep->to   = to;
+        rep->partitions = nParts;
+
+        // 퇴사자 등 재직 목록에 없는 사원의 이름/부서는 행에서 보충
+        QHash<int, QPair<QString, QString>> names = info;
+        for (const auto& row : rows) {
+            const int id = row.value(1).toInt();
+            if (!names.contains(id)) names.insert(id, {row.value(2).toString(), row.value(3).toString()});
+        }
+
+        QList<int> ids = total.keys();
+        std::sort(ids.begin(), ids.end());
+        QMap<QString, DeptStats> depts;   // 부서명 정렬
+        for (int id : ids) {
+            const Acc& a = total[id];
+            WorkerStats w;
+            w.empId = id;
+            w.name  = names.value(id).first;
+            w.dept  = names.value(id).second;
+            w.days = a.days; w.late = a.late; w.missingOut = a.missingOut; w.absent = a.absent;
+            w.longestLateRun   = a.lateRun.best;
+            w.longestAbsentRun = a.absentRun.best;
+            w.workedSec = a.workedSec; w.overtimeSec = a.overtimeSec; w.lateSec = a.lateSec;
+            rep->workers << w;
+
+            DeptStats& d = depts[w.dept];
+            d.dept = w.dept;
+            ++d.workers;
+            d.days += w.days; d.late += w.late; d.missingOut += w.missingOut; d.absent += w.absent;
+            d.workedSec += w.workedSec; d.overtimeSec += w.overtimeSec;
+        }
+        rep->depts = depts.values();
+        rep->elapsedMs = QDateTime::currentMSecsSinceEpoch() - startedMs;
+
+        AttendanceReportPtr ptr = rep;
+        // 오늘이 포함된 기간은 계속 바뀌므로 보관하지 않음(다음 요청은 항상 새로 계산)
+        if (to < QDate::currentDate()) cache_.insert(key, new AttendanceReportPtr(ptr));
+        emit ready(ptr, false);
+    });
+}
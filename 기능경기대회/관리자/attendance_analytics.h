@@ -0,0 +1,119 @@
+#pragma once
+/**
+ * @file attendance_analytics.h
+ * @brief 기간별 근태 통계(지각/초과근무/퇴근 누락/결근/연속 기록) 계산 엔진.
+ *
+ * 배경
+ *  - 근태 표는 일자별 출근/퇴근 시각만 보여 준다. 월간 점검 때마다 원본을 CSV로 내려받아
+ *    스프레드시트에서 다시 집계했다.
+ *
+ * 동작
+ *  - daily_attendance 요약((day, emp_id)당 1행)과 재직 사원 목록을 DbService로 읽는다(캐시가 있으면 로컬).
+ *  - 기간을 날짜 구간(파티션)으로 나눠 QtConcurrent::mappedReduced로 병렬 집계:
+ *    · map   : 파티션 하나의 사원별 누계(합계 + 연속 구간 요약)
+ *    · reduce: 파티션 순서대로 병합(OrderedReduce) — 파티션 경계를 넘는 연속 지각/결근도 이어서 계산
+ *  - 결과는 (기간, 규칙) 키로 QCache에 보관(오늘이 포함된 기간은 보관하지 않음).
+ *    캐시 동기화/수동 새로 고침으로 근태가 바뀌면 invalidate().
+ *
+ * 판정 기준(AnalyticsRules, admin_client.ini [analytics])
+ *  - 지각     : 평일 첫 통과(first_in)가 출근 기준 시각 + 유예(분) 이후
+ *  - 초과근무 : 하루 근무(worked_sec)가 기준 근무시간을 넘은 부분
+ *  - 퇴근 누락: 하루 통과 기록이 1건뿐이거나 첫/마지막 통과 간격이 최소 간격 미만
+ *  - 결근     : 재직 사원이 평일에 기록이 없음(공휴일 달력은 없으므로 평일 = 월~금)
+ *              오늘/미래 날짜와 그 사원의 첫 근태 기록 이전(입사 전, 입사일 열이 없어 첫 기록으로 대신)은 제외
+ */
+
+#include <QObject>
+#include <QCache>
+#include <QDate>
+#include <QTime>
+#include <QString>
+#include <QVector>
+#include <QVariant>
+#include <QPointer>
+#include <QFuture>
+#include <memory>
+
+class DbService;
+
+/// 판정 기준
+struct AnalyticsRules {
+    QTime startTime   = QTime(9, 0);   ///< 출근 기준 시각
+    int   graceMin    = 5;             ///< 지각 유예(분)
+    int   standardSec = 8 * 3600;      ///< 기준 근무시간(초) — 넘는 부분이 초과근무
+    int   minSpanSec  = 60;            ///< 첫/마지막 통과 간격이 이보다 짧으면 퇴근 누락
+
+    /// INI 섹션에서 읽기(start=09:00, grace_min, standard_hours, min_span_sec)
+    static AnalyticsRules fromIni(const QString& iniPath, const QString& group = "analytics");
+    /// 캐시 키 구성용 문자열
+    QString key() const;
+};
+
+/// 사원별 통계
+struct WorkerStats {
+    int     empId = 0;
+    QString name, dept;
+    int     days = 0;              ///< 출근(기록 있는) 일수
+    int     late = 0;              ///< 지각 일수
+    int     missingOut = 0;        ///< 퇴근 누락 일수
+    int     absent = 0;            ///< 결근 일수(평일, 재직자만)
+    int     longestLateRun = 0;    ///< 최장 연속 지각(출근한 평일 기준)
+    int     longestAbsentRun = 0;  ///< 최장 연속 결근(평일 기준)
+    qint64  workedSec = 0;
+    qint64  overtimeSec = 0;
+    qint64  lateSec = 0;           ///< 지각 누적(기준 시각 대비, 유예 제외 전)
+};
+
+/// 부서별 합계
+struct DeptStats {
+    QString dept;
+    int     workers = 0;
+    int     days = 0, late = 0, missingOut = 0, absent = 0;
+    qint64  workedSec = 0, overtimeSec = 0;
+};
+
+/// 계산 결과(불변 — 캐시와 화면이 공유)
+struct AttendanceReport {
+    QDate from, to;
+    QVector<WorkerStats> workers;   ///< 사번 오름차순
+    QVector<DeptStats>   depts;     ///< 부서명 오름차순
+    int    partitions = 0;          ///< 병렬 처리한 날짜 구간 수
+    qint64 elapsedMs  = 0;          ///< 조회 + 집계 소요 시간
+};
+using AttendanceReportPtr = std::shared_ptr<const AttendanceReport>;
+
+class AttendanceAnalytics : public QObject {
+    Q_OBJECT
+public:
+    explicit AttendanceAnalytics(QObject* parent = nullptr);
+
+    /// 조회 서비스(nullptr = DbService::instance()). 바꾸면 캐시를 비운다.
+    void setService(DbService* svc);
+    /// 판정 기준 변경(캐시 키에 포함되므로 이전 결과는 자연히 재사용되지 않음)
+    void setRules(const AnalyticsRules& rules) { rules_ = rules; }
+    const AnalyticsRules& rules() const { return rules_; }
+
+    /**
+     * @brief [from, to] 통계 요청. 캐시에 있으면 즉시 ready, 없으면 비동기 계산 후 ready.
+     * 계산 중 새 요청이 오면 이전 요청의 조회(DbService 채널 취소)/병렬 집계(퓨처 취소)는 취소한다.
+     */
+    void compute(const QDate& from, const QDate& to);
+    /// 원본 데이터가 바뀜 → 캐시 비움
+    void invalidate() { cache_.clear(); }
+
+signals:
+    void ready(AttendanceReportPtr report, bool cached);
+    void failed(const QString& error);
+
+private:
+    DbService* service() const;
+    void aggregate(const QDate& from, const QDate& to, const QString& key,
+                   const QVector<QVector<QVariant>>& employees,
+                   const QVector<QVector<QVariant>>& rows, qint64 startedMs);
+
+    QPointer<DbService> svc_;
+    AnalyticsRules rules_;
+    QCache<QString, AttendanceReportPtr> cache_{16};   ///< (기간+규칙) → 결과, 최근 16개
+    quint64 gen_ = 0;                                  ///< 요청 세대(이전 요청 결과 폐기)
+    QFuture<void> running_;                            ///< 진행 중 병렬 집계(새 요청 시 취소)
+};
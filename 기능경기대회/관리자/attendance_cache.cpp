@@ -0,0 +1,316 @@
+#include "attendance_cache.h"
+#include "db_service.h"
+#include <QTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QSettings>             // [cache] 섹션 읽기
+#include <QStandardPaths>        // 기본 캐시 위치
+#include <QCoreApplication>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+
+constexpr int kPageRows = 2000;   // 원격 근태 요약 한 번에 가져올 행 수(로컬 트랜잭션 1회)
+constexpr int kLagSec   = 5;      // 고수위 겹침 — 늦게 커밋된(타임스탬프가 더 이른) 행을 놓치지 않도록
+const char* const kEpoch = "1970-01-01 00:00:00.000000";
+
+// 로컬 스키마: 원격과 같은 테이블/열 이름(모델 SQL을 최대한 공유)
+const char* const kSchema[] = {
+    "PRAGMA journal_mode=WAL",   // 동기화 쓰기 중에도 CSV 내보내기 커넥션이 읽을 수 있도록
+    "PRAGMA synchronous=NORMAL",
+    "CREATE TABLE IF NOT EXISTS employee ("
+    "  emp_id INTEGER PRIMARY KEY, name TEXT, department TEXT, position TEXT,"
+    "  status INTEGER, phone TEXT)",
+    "CREATE INDEX IF NOT EXISTS idx_emp_name ON employee(name)",
+    "CREATE TABLE IF NOT EXISTS daily_attendance ("
+    "  day TEXT NOT NULL, emp_id INTEGER NOT NULL, first_in TEXT, last_out TEXT,"
+    "  worked_sec INTEGER, check_count INTEGER, updated_at TEXT,"
+    "  PRIMARY KEY (day, emp_id)) WITHOUT ROWID",
+    "CREATE INDEX IF NOT EXISTS idx_da_day_desc ON daily_attendance(day DESC, emp_id)",
+    "CREATE INDEX IF NOT EXISTS idx_da_emp_day ON daily_attendance(emp_id, day)",
+    "CREATE TABLE IF NOT EXISTS employee_ngram ("
+    "  gram TEXT NOT NULL, emp_id INTEGER NOT NULL, PRIMARY KEY (gram, emp_id)) WITHOUT ROWID",
+    "CREATE TABLE IF NOT EXISTS cache_meta (k TEXT PRIMARY KEY, v TEXT)",
+    // n-gram 색인 도입 전 캐시: 서명을 지워 다음 동기화에서 사원 목록(+색인)을 다시 받게 한다
+    "DELETE FROM cache_meta WHERE k = 'emp_sig' AND NOT EXISTS (SELECT 1 FROM employee_ngram)",
+};
+
+/// execBatch 한 번 분량: sql(위치 바인딩) + 행들
+struct Batch {
+    QString sql;
+    QVector<QVector<QVariant>> rows;
+};
+
+/**
+ * 로컬 쓰기 한 묶음(트랜잭션 1회)
+ * - before : 먼저 실행할 문장(전체 교체 시 DELETE 등)
+ * - batches: 순서대로 execBatch
+ * - meta   : 같은 트랜잭션에서 갱신할 cache_meta 값 → 행과 고수위가 함께 커밋/롤백된다
+ */
+DbResult writeBatch(QSqlDatabase& db, const QStringList& before, const QVector<Batch>& batches,
+                    const QVariantMap& meta, const std::atomic_bool& cancel)
+{
+    DbResult r;
+    if (!db.transaction()) { r.error = db.lastError().text(); return r; }
+    auto fail = [&](const QSqlQuery& q) {
+        r.error = q.lastError().text();
+        db.rollback();
+        return r;
+    };
+
+    QSqlQuery q(db);
+    for (const QString& s : before)
+        if (!q.exec(s)) return fail(q);
+
+    int written = 0;
+    for (const Batch& b : batches) {
+        if (b.rows.isEmpty()) continue;
+        if (!q.prepare(b.sql)) return fail(q);
+        // execBatch: 열마다 값 목록 하나(행 수만큼) — 문장 준비/바인딩을 한 번만 한다
+        const int cols = b.rows.first().size();
+        for (int c = 0; c < cols; ++c) {
+            QVariantList col;
+            col.reserve(b.rows.size());
+            for (const auto& row : b.rows) col << row.value(c);
+            q.addBindValue(col);
+        }
+        if (!q.execBatch()) return fail(q);
+        written += b.rows.size();
+    }
+
+    if (!meta.isEmpty()) {
+        if (!q.prepare("INSERT OR REPLACE INTO cache_meta (k, v) VALUES (?, ?)")) return fail(q);
+        for (auto it = meta.cbegin(); it != meta.cend(); ++it) {
+            q.addBindValue(it.key());
+            q.addBindValue(it.value());
+            if (!q.exec()) return fail(q);
+        }
+    }
+
+    if (cancel.load()) { db.rollback(); r.canceled = true; return r; }
+    if (!db.commit()) { r.error = db.lastError().text(); db.rollback(); return r; }
+    r.ok = true;
+    r.numRowsAffected = written;
+    return r;
+}
+
+} // namespace
+
+AttendanceCache::AttendanceCache(const QString& path, DbService* remote, QObject* parent)
+    : QObject(parent), remote_(remote)
+{
+    if (!QSqlDatabase::isDriverAvailable("QSQLITE")) {
+        qWarning() << "AttendanceCache: QSQLITE driver not available";
+        failed_ = true;
+        return;
+    }
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    DbConfig cfg;
+    cfg.driver   = "QSQLITE";
+    cfg.database = path;
+    cfg.options  = "QSQLITE_BUSY_TIMEOUT=3000";
+    cfg.poolSize = 1;   // 조회/쓰기 순서 보장 + SQLite 쓰기 잠금 경합 없음
+    local_ = new DbService(cfg, this);
+
+    // 스키마 생성은 첫 작업 → 이후 조회는 반드시 테이블이 있는 상태에서 실행된다
+    local_->submitJob([](QSqlDatabase& db, const std::atomic_bool& cancel) {
+        DbResult r;
+        for (const char* s : kSchema) {
+            r = DbService::exec(db, QString::fromLatin1(s), {}, cancel);
+            if (!r.ok) return r;
+        }
+        return r;
+    }).then(this, [this](const DbResult& r) {
+        if (r.ok || r.canceled) return;
+        qWarning() << "AttendanceCache: schema failed:" << r.error;
+        failed_ = true;
+        emit localFailed(r.error);
+    });
+
+    timer_ = new QTimer(this);
+    connect(timer_, &QTimer::timeout, this, &AttendanceCache::sync);
+}
+
+AttendanceCache::~AttendanceCache()
+{
+    if (remote_) remote_->cancelChannel("cache.sync");
+}
+
+AttendanceCache* AttendanceCache::instance()
+{
+    static QPointer<AttendanceCache> s;
+    static bool disabled = false;
+    if (!s && !disabled) {
+        QSettings ini(QCoreApplication::applicationDirPath() + "/admin_client.ini", QSettings::IniFormat);
+        ini.beginGroup("cache");
+        if (!ini.value("enabled", true).toBool()) {
+            disabled = true;
+            return nullptr;
+        }
+        QString path = ini.value("path").toString();
+        if (path.isEmpty())
+            path = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+                 + "/attendance_cache.sqlite";
+        const int syncSec = ini.value("sync_sec", 30).toInt();
+        ini.endGroup();
+
+        s = new AttendanceCache(path, DbService::instance(), qApp);
+        s->setSyncInterval(syncSec);
+    }
+    return s;
+}
+
+QStringList AttendanceCache::nameGrams(const QString& name, bool forIndex)
+{
+    const QString s = name.simplified().toLower();
+    QStringList out;
+    if (s.isEmpty()) return out;
+    if (forIndex) {
+        for (int i = 0; i < s.size(); ++i) {
+            out << s.mid(i, 1);
+            if (i + 1 < s.size()) out << s.mid(i, 2);
+        }
+    } else if (s.size() == 1) {
+        out << s;
+    } else {
+        for (int i = 0; i + 1 < s.size(); ++i) out << s.mid(i, 2);
+    }
+    out.removeDuplicates();   // PK(gram, emp_id) 중복 방지 + 검색 시 HAVING COUNT 기준
+    return out;
+}
+
+void AttendanceCache::setSyncInterval(int sec)
+{
+    if (!timer_) return;
+    if (sec > 0) timer_->start(sec * 1000);
+    else         timer_->stop();
+}
+
+void AttendanceCache::sync()
+{
+    if (!local() || !remote_ || syncing_) return;
+    syncing_    = true;
+    empChanged_ = false;
+    attChanged_ = 0;
+
+    local_->submit("SELECT k, v FROM cache_meta")
+        .then(this, [this](const DbResult& r) {
+            if (!r.ok) { finishSync(false, r.error); return; }
+            QString sig;
+            hwm_ = QString::fromLatin1(kEpoch);
+            for (const auto& row : r.rows) {
+                const QString k = row.value(0).toString();
+                if (k == "emp_sig") sig  = row.value(1).toString();
+                if (k == "att_hwm") hwm_ = row.value(1).toString();
+            }
+            hwmStart_ = hwm_;
+            syncEmployees(sig);
+        });
+}
+
+void AttendanceCache::syncEmployees(const QString& knownSig)
+{
+    // 서명: 행 수 + 행 내용 CRC32의 XOR — employee에는 변경 시각 열이 없어 내용으로 비교
+    remote_->submit(
+        "SELECT COUNT(*), COALESCE(BIT_XOR(CRC32(CONCAT_WS('|', emp_id, name, department, "
+        "       position, status, phone))), 0) FROM employee", {}, "cache.sync")
+        .then(this, [this, knownSig](const DbResult& s) {
+            if (!s.ok || s.rows.isEmpty()) { finishSync(false, s.error); return; }
+            const QString sig = s.rows[0].value(0).toString() + ':' + s.rows[0].value(1).toString();
+            if (sig == knownSig) { syncAttendance({}); return; }
+
+            remote_->submit(
+                "SELECT emp_id, name, department, position, status, phone FROM employee",
+                {}, "cache.sync")
+                .then(this, [this, sig](const DbResult& r) {
+                    if (!r.ok) { finishSync(false, r.error); return; }
+                    QVector<QVector<QVariant>> grams;
+                    for (const auto& row : r.rows)
+                        for (const QString& g : nameGrams(row.value(1).toString(), true))
+                            grams.push_back({g, row.value(0)});
+                    const QVector<Batch> batches{
+                        {"INSERT INTO employee (emp_id, name, department, position, status, phone) "
+                         "VALUES (?, ?, ?, ?, ?, ?)", r.rows},
+                        {"INSERT INTO employee_ngram (gram, emp_id) VALUES (?, ?)", grams},
+                    };
+                    local_->submitJob([batches, sig](QSqlDatabase& db, const std::atomic_bool& cancel) {
+                        return writeBatch(db, {"DELETE FROM employee", "DELETE FROM employee_ngram"},
+                                          batches, {{"emp_sig", sig}}, cancel);
+                    }).then(this, [this](const DbResult& w) {
+                        if (!w.ok) { finishSync(false, w.error); return; }
+                        empChanged_ = true;
+                        syncAttendance({});
+                    });
+                });
+        });
+}
+
+void AttendanceCache::syncAttendance(const QVector<QVariant>& after)
+{
+    /*
+     * 원격 daily_attendance를 (updated_at, day, emp_id) 순 keyset 페이지로 읽는다.
+     * - 첫 페이지: 고수위 - kLagSec 부터(겹치는 행은 upsert라 중복 반영 없음)
+     * - 다음 페이지: 직전 페이지 마지막 (ts, day, emp) 다음부터 — 같은 ms에 갱신된 수천 행(백필)도 빠짐없이
+     * - idx_da_updated(updated_at) + InnoDB 보조 인덱스의 PK(day, emp_id) 순서 = 정렬 순서
+     */
+    QString sql =
+        "SELECT DATE_FORMAT(day, '%Y-%m-%d'), emp_id, "
+        "       DATE_FORMAT(first_in, '%Y-%m-%d %H:%i:%s'), DATE_FORMAT(last_out, '%Y-%m-%d %H:%i:%s'), "
+        "       worked_sec, check_count, DATE_FORMAT(updated_at, '%Y-%m-%d %H:%i:%s.%f') "
+        "FROM daily_attendance ";
+    QVariantMap binds;
+    if (after.isEmpty()) {
+        sql += QString("WHERE updated_at >= TIMESTAMP(:since) - INTERVAL %1 SECOND ").arg(kLagSec);
+        binds.insert(":since", hwm_);
+    } else {
+        sql += "WHERE (updated_at > :k_ts_gt OR (updated_at = :k_ts_eq AND "
+               "       (day > :k_day_gt OR (day = :k_day_eq AND emp_id > :k_emp)))) ";
+        binds.insert(":k_ts_gt",  after.value(0));
+        binds.insert(":k_ts_eq",  after.value(0));
+        binds.insert(":k_day_gt", after.value(1));
+        binds.insert(":k_day_eq", after.value(1));
+        binds.insert(":k_emp",    after.value(2));
+    }
+    sql += QString("ORDER BY updated_at, day, emp_id LIMIT %1").arg(kPageRows);
+
+    remote_->submit(sql, binds, "cache.sync")
+        .then(this, [this](const DbResult& r) {
+            if (!r.ok) { finishSync(false, r.error); return; }
+            if (r.rows.isEmpty()) { finishSync(true, {}); return; }
+
+            // 정렬이 updated_at 오름차순 → 마지막 행이 이 페이지의 최대값
+            const QVector<QVariant>& last = r.rows.last();
+            const QString ts = last.value(6).toString();
+            if (ts > hwm_) hwm_ = ts;
+            for (const auto& row : r.rows)
+                if (row.value(6).toString() > hwmStart_) ++attChanged_;
+
+            const bool more = r.rows.size() >= kPageRows;
+            const QVector<QVariant> next{last.value(6), last.value(0), last.value(1)};
+            local_->submitJob([rows = r.rows, hwm = hwm_](QSqlDatabase& db, const std::atomic_bool& cancel) {
+                const QVector<Batch> batches{
+                    {"INSERT OR REPLACE INTO daily_attendance "
+                     "(day, emp_id, first_in, last_out, worked_sec, check_count, updated_at) "
+                     "VALUES (?, ?, ?, ?, ?, ?, ?)", rows},
+                };
+                return writeBatch(db, {}, batches, {{"att_hwm", hwm}}, cancel);
+            }).then(this, [this, more, next](const DbResult& w) {
+                if (!w.ok) { finishSync(false, w.error); return; }
+                if (more) syncAttendance(next);
+                else      finishSync(true, {});
+            });
+        });
+}
+
+void AttendanceCache::finishSync(bool ok, const QString& error)
+{
+    syncing_ = false;
+    online_  = ok;
+    if (ok) lastSync_ = QDateTime::currentDateTime();
+    else    qWarning() << "AttendanceCache: sync failed:" << error;
+    emit synced(ok, empChanged_, attChanged_, error);
+}
@@ -0,0 +1,94 @@
+#pragma once
+/**
+ * @file attendance_cache.h
+ * @brief 사원/일자별 근태를 로컬 SQLite에 복제해 두는 읽기 캐시(증분 동기화).
+ *
+ * 배경
+ *  - 근태 탭은 방문/조회/스크롤마다 LAN 건너 MySQL에 질의했다. DB 링크가 끊기면 탭 전체가 비었다.
+ *
+ * 구조
+ *  - local(): QSQLITE 드라이버로 연 DbService(워커 1개) — 사원/근태 표 모델은 이 서비스에서 조회한다.
+ *    워커 하나가 FIFO로 처리하므로 스키마 생성 → 조회 → 동기화 쓰기 순서가 보장된다.
+ *  - sync(): 원격(DbService::instance())에서 바뀐 부분만 가져와 로컬에 반영.
+ *    · employee        : 행 서명(COUNT + CRC32 XOR)이 달라졌을 때만 전체 교체(수백 행 규모)
+ *                        + 이름 n-gram 색인(employee_ngram)도 같은 트랜잭션에서 재생성
+ *    · daily_attendance: updated_at 고수위(high-water mark) 이후 행만 keyset 페이지로 가져와 upsert
+ *      (고수위는 행과 같은 트랜잭션에서 갱신 → 중간에 끊겨도 다음 동기화가 이어서 받는다)
+ *  - 동기화 실패(연결 끊김)는 오프라인 상태로만 표시 — 조회는 마지막으로 받은 캐시로 계속 동작.
+ *
+ * 설정(admin_client.ini [cache])
+ *  - enabled  : false면 캐시를 쓰지 않고 원격에서 직접 조회(기본 true)
+ *  - path     : SQLite 파일 경로(기본: 앱 로컬 데이터 폴더/attendance_cache.sqlite)
+ *  - sync_sec : 자동 동기화 주기(초, 0=수동만, 기본 30)
+ */
+
+#include <QObject>
+#include <QPointer>
+#include <QDateTime>
+#include <QVector>
+#include <QVariant>
+#include <QStringList>
+
+class QTimer;
+class DbService;
+
+class AttendanceCache : public QObject {
+    Q_OBJECT
+public:
+    /// path: SQLite 파일, remote: 원본 MySQL 서비스
+    AttendanceCache(const QString& path, DbService* remote, QObject* parent = nullptr);
+    ~AttendanceCache() override;   ///< 진행 중인 원격 동기화 질의 취소
+
+    /// 앱 공용 인스턴스(admin_client.ini [cache]). enabled=false면 nullptr.
+    static AttendanceCache* instance();
+
+    /// 로컬 조회용 서비스(SQLite 드라이버가 없거나 스키마 생성에 실패하면 nullptr)
+    DbService* local() const { return failed_ ? nullptr : local_; }
+
+    /// 증분 동기화 시작(이미 진행 중이면 무시)
+    void sync();
+    /// 자동 동기화 주기(0 이하 = 끔)
+    void setSyncInterval(int sec);
+
+    /**
+     * @brief 이름 n-gram(employee_ngram 색인/검색 키)
+     * - forIndex=true : 저장용 — 모든 1글자 + 2글자 조각
+     * - forIndex=false: 검색용 — 1글자 키워드는 그 글자, 2글자 이상은 겹치는 2글자 조각(중복 제거)
+     * 한글 이름(2~4자)에서 "부분 일치"를 앞 와일드카드 LIKE 없이 색인 범위로 찾기 위한 것.
+     */
+    static QStringList nameGrams(const QString& name, bool forIndex);
+
+    bool isSyncing() const { return syncing_; }
+    bool isOnline() const { return online_; }           ///< 마지막 동기화 성공 여부
+    QDateTime lastSync() const { return lastSync_; }    ///< 마지막 성공 시각(없으면 invalid)
+
+signals:
+    /**
+     * @brief 동기화 종료
+     * @param employeesChanged 사원 목록이 교체됨(콤보/사원 표 갱신 필요)
+     * @param attendanceRows   새로 바뀐 근태 요약 행 수
+     */
+    void synced(bool ok, bool employeesChanged, int attendanceRows, const QString& error);
+    /// 로컬 캐시를 쓸 수 없게 됨(파일 권한/디스크 등) → 호출측은 원격 조회로 되돌아가야 한다
+    void localFailed(const QString& error);
+
+private:
+    void syncEmployees(const QString& knownSig);
+    void syncAttendance(const QVector<QVariant>& after);   // after: 직전 페이지 마지막 (ts, day, emp)
+    void finishSync(bool ok, const QString& error);
+
+    DbService*           local_ = nullptr;
+    QPointer<DbService>  remote_;
+    QTimer*              timer_ = nullptr;
+
+    bool      failed_  = false;
+    bool      syncing_ = false;
+    bool      online_  = false;
+    QDateTime lastSync_;
+
+    // 진행 중 동기화 상태
+    QString hwmStart_;        ///< 시작 시점 고수위(이보다 큰 updated_at = 새 변경)
+    QString hwm_;             ///< 지금까지 반영한 최대 updated_at
+    bool    empChanged_ = false;
+    int     attChanged_ = 0;
+};
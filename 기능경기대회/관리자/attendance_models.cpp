@@ -0,0 +1,235 @@
+#include "attendance_models.h"
+#include "db_service.h"   // 비동기 질의(워커 스레드 커넥션 풀)
+#include "attendance_cache.h"   // 이름 n-gram(로컬 캐시 검색 색인)
+
+// ===================== KeysetTableModel =====================
+
+KeysetTableModel::KeysetTableModel(const QString& channel, QObject* parent)
+    : QAbstractTableModel(parent), channel_(channel)
+{
+}
+
+int KeysetTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : rows_.size();
+}
+
+int KeysetTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : headers_.size();
+}
+
+QVariant KeysetTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows_.size()) return QVariant();
+    if (role == Qt::DisplayRole)
+        return displayValue(rows_[index.row()], index.column());
+    if (role == Qt::TextAlignmentRole)
+        return int(Qt::AlignCenter);   // 표 텍스트 가운데 정렬(기존 표와 동일)
+    return QVariant();
+}
+
+QVariant KeysetTableModel::headerData(int section, Qt::Orientation o, int role) const
+{
+    if (o == Qt::Horizontal && role == Qt::DisplayRole)
+        return headers_.value(section);
+    return QAbstractTableModel::headerData(section, o, role);
+}
+
+bool KeysetTableModel::canFetchMore(const QModelIndex& parent) const
+{
+    // 이미 요청 중이면 false — 스크롤 이벤트마다 같은 페이지를 중복 요청하지 않도록
+    return !parent.isValid() && !atEnd_ && !loading_;
+}
+
+void KeysetTableModel::fetchMore(const QModelIndex& parent)
+{
+    if (canFetchMore(parent)) requestPage();
+}
+
+void KeysetTableModel::reload()
+{
+    beginResetModel();
+    rows_.clear();
+    atEnd_   = false;
+    loading_ = false;
+    ++gen_;
+    endResetModel();
+    requestPage();   // 첫 페이지는 뷰의 요청을 기다리지 않고 바로
+}
+
+DbService* KeysetTableModel::service() const
+{
+    return svc_ ? svc_.data() : DbService::instance();
+}
+
+QString KeysetTableModel::fullSql(QVariantMap& binds) const
+{
+    return selectSql(binds) + tailSql();
+}
+
+void KeysetTableModel::requestPage()
+{
+    QVariantMap binds;
+    QString sql = selectSql(binds);
+    if (!rows_.isEmpty()) sql += keysetSql(rows_.last(), binds);
+    sql += tailSql() + QString(" LIMIT %1").arg(pageSize_);
+
+    loading_ = true;
+    const quint64 gen = gen_;
+    service()->submit(sql, binds, channel_)
+        .then(this, [this, gen](const DbResult& r) {
+            if (gen != gen_) return;   // reload 이전 조건의 결과
+            loading_ = false;
+            if (r.canceled) return;    // 다음 fetchMore에서 다시 요청
+            if (!r.ok) {
+                atEnd_ = true;
+                emit loadFailed(r.error);
+                return;
+            }
+            atEnd_ = r.rows.size() < pageSize_;
+            if (!r.rows.isEmpty()) {
+                beginInsertRows(QModelIndex(), rows_.size(), rows_.size() + r.rows.size() - 1);
+                rows_ += r.rows;
+                endInsertRows();
+            }
+            emit pageLoaded(r.rows.size(), atEnd_);
+        });
+}
+
+// ===================== EmployeeModel =====================
+
+EmployeeModel::EmployeeModel(QObject* parent)
+    : KeysetTableModel("att.employees", parent)
+{
+    headers_ = QStringList{u8"사번", u8"이름", u8"부서", u8"직무", u8"상태", u8"연락처", u8"비고"};
+}
+
+bool EmployeeModel::setFilter(const QString& name, const QString& dept, int status)
+{
+    if (name == name_ && dept == dept_ && status == status_) return false;
+    name_   = name;
+    dept_   = dept;
+    status_ = status;
+    return true;
+}
+
+QString EmployeeModel::selectSql(QVariantMap& binds) const
+{
+    // 기본 SELECT: NULL 대비 COALESCE로 표시 일관성 유지
+    QString sql =
+        "SELECT emp_id, name, COALESCE(department,''), COALESCE(position,''), "
+        "       status, COALESCE(phone,''), '' AS etc "
+        "FROM employee WHERE 1=1 ";
+
+    // 조건절 — 입력값이 있을 때만 추가
+    //  - 같은 조건 조합이면 SQL 문자열이 같도록(값은 전부 바인딩) → 워커의 준비된 문장 재사용
+    if (!name_.isEmpty()) {
+        // 로컬 캐시: 앞 와일드카드 LIKE(전체 스캔) 대신 n-gram 색인으로 후보를 좁힌 뒤 LIKE로 확정
+        //  - 키워드의 모든 조각을 가진 사원만 후보(PK(gram, emp_id) 범위 조회)
+        //  - 조각 수만큼 SQL 모양이 달라지지만 이름 길이로 제한됨
+        const QStringList grams = service()->config().driver == QLatin1String("QSQLITE")
+                                ? AttendanceCache::nameGrams(name_, false) : QStringList();
+        if (!grams.isEmpty()) {
+            QStringList ph;
+            for (int i = 0; i < grams.size(); ++i) {
+                ph << QString(":g%1").arg(i);
+                binds.insert(ph.last(), grams[i]);
+            }
+            sql += QString(" AND emp_id IN (SELECT emp_id FROM employee_ngram WHERE gram IN (%1) "
+                           "GROUP BY emp_id HAVING COUNT(*) = %2) ").arg(ph.join(", ")).arg(grams.size());
+        }
+        sql += " AND name LIKE :name ";
+        binds.insert(":name", "%" + name_ + "%");
+    }
+    if (!dept_.isEmpty()) {
+        sql += " AND department = :dept ";
+        binds.insert(":dept", dept_);
+    }
+    if (status_ >= 0) {
+        sql += " AND status = :status ";
+        binds.insert(":status", status_);
+    }
+    return sql;
+}
+
+QString EmployeeModel::keysetSql(const QVector<QVariant>& last, QVariantMap& binds) const
+{
+    binds.insert(":k_emp", last.value(0));
+    return " AND emp_id > :k_emp ";   // PK 순서로 이어 읽기
+}
+
+QString EmployeeModel::tailSql() const
+{
+    return " ORDER BY emp_id ASC";
+}
+
+QVariant EmployeeModel::displayValue(const QVector<QVariant>& row, int col) const
+{
+    // 상태 코드 → 한글 라벨(현재 스키마 기준: 1=재직, 그 외=퇴사)
+    if (col == 4) return row.value(4).toInt() == 1 ? u8"재직" : u8"퇴사";
+    return row.value(col);
+}
+
+// ===================== AttendanceModel =====================
+
+AttendanceModel::AttendanceModel(QObject* parent)
+    : KeysetTableModel("att.attendance", parent)
+{
+    headers_ = QStringList{u8"일자", u8"사번", u8"이름", u8"부서", u8"출근", u8"퇴근", u8"근무시간"};
+}
+
+void AttendanceModel::setFilter(const QDate& from, const QDate& to, const QVariant& empId)
+{
+    from_  = from;
+    to_    = to;
+    empId_ = empId;
+}
+
+QString AttendanceModel::selectSql(QVariantMap& binds) const
+{
+    /*
+     * daily_attendance: gate_check 삽입 트리거가 (day, emp_id)당 1행으로 유지하는 요약
+     * - first_in/last_out = 그날 첫/마지막 통과(입/퇴근 구분 없는 스키마 → MIN/MAX)
+     * - 원본 스캔/GROUP BY 없이 PK(day, emp_id) 범위만 읽음 → 비용 O(일수 × 인원)
+     * - 로컬 캐시(SQLite)는 같은 테이블/열 이름 — 시각 서식 함수만 방언이 다르다
+     */
+    const bool lite = service()->config().driver == QLatin1String("QSQLITE");
+    QString sql = lite
+        ? "SELECT d.day, d.emp_id, e.name, e.department, "
+          "       strftime('%H:%M', d.first_in) AS in_time, "
+          "       strftime('%H:%M', d.last_out) AS out_time, "
+          "       time(d.worked_sec, 'unixepoch') AS hours "
+        : "SELECT d.day, d.emp_id, e.name, e.department, "
+          "       DATE_FORMAT(d.first_in, '%H:%i') AS in_time, "
+          "       DATE_FORMAT(d.last_out, '%H:%i') AS out_time, "
+          "       SEC_TO_TIME(d.worked_sec) AS hours ";
+    sql +=
+        "FROM daily_attendance d "
+        "JOIN employee e ON e.emp_id = d.emp_id "
+        "WHERE d.day BETWEEN :from AND :to ";
+    binds.insert(":from", from_.toString("yyyy-MM-dd"));
+    binds.insert(":to",   to_.toString("yyyy-MM-dd"));
+
+    if (empId_.isValid()) {
+        sql += " AND d.emp_id = :emp ";   // (emp_id, day) 보조 인덱스
+        binds.insert(":emp", empId_.toInt());
+    }
+    return sql;
+}
+
+QString AttendanceModel::keysetSql(const QVector<QVariant>& last, QVariantMap& binds) const
+{
+    // (day DESC, emp_id ASC)의 "다음": 더 이전 날짜이거나, 같은 날짜에서 더 큰 사번
+    const QString day = last.value(0).toDate().toString("yyyy-MM-dd");
+    binds.insert(":k_day_lt", day);
+    binds.insert(":k_day_eq", day);
+    binds.insert(":k_emp",    last.value(1));
+    return " AND (d.day < :k_day_lt OR (d.day = :k_day_eq AND d.emp_id > :k_emp)) ";
+}
+
+QString AttendanceModel::tailSql() const
+{
+    // 정렬: 최신 일자 DESC → 사번 ASC (idx_da_day_desc 인덱스 순서 그대로 → filesort 없음)
+    return " ORDER BY d.day DESC, d.emp_id ASC";
+}
@@ -0,0 +1,129 @@
+#pragma once
+/**
+ * @file attendance_models.h
+ * @brief 사원/근태 표용 지연 로딩(keyset 페이지) 모델.
+ *
+ * 배경
+ *  - 기존 방식은 결과 전체를 받아 insertRow로 채웠다. gate_check가 1년치 × 수백 명이 되면
+ *    첫 화면을 보여주려고 수만 행을 가져오게 된다.
+ *
+ * 동작
+ *  - 첫 페이지(pageSize 행)만 요청하고, 뷰가 스크롤 끝에 닿으면 canFetchMore/fetchMore로 다음 페이지 요청.
+ *  - OFFSET 대신 keyset: "마지막으로 받은 행의 정렬 키 다음부터"를 WHERE 조건으로 준다
+ *    (뒤 페이지로 갈수록 느려지는 OFFSET 스캔이 없음, 인덱스 순서 그대로 이어 읽기).
+ *  - 질의는 DbService 워커에서 실행 — 스크롤 중에도 GUI가 멈추지 않음.
+ *    기본은 원격 MySQL, setService()로 로컬 캐시(AttendanceCache::local(), SQLite)를 지정할 수 있다.
+ *  - reload()는 세대 번호를 올려 이전 조건의 늦게 도착한 결과를 버린다.
+ *
+ * 모델별 키
+ *  - EmployeeModel   : emp_id ASC
+ *  - AttendanceModel : (day DESC, emp_id ASC)
+ */
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+#include <QVariant>
+#include <QVariantMap>
+#include <QDate>
+#include <QPointer>
+
+class DbService;
+
+class KeysetTableModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    /// channel: DbService 채널(같은 모델의 이전 질의는 새 질의로 취소됨)
+    explicit KeysetTableModel(const QString& channel, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation o, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    /// 비우고 첫 페이지부터 다시 요청(조건 변경 후 호출)
+    void reload();
+    void setPageSize(int n) { pageSize_ = qMax(20, n); }
+    bool isLoading() const { return loading_; }
+    bool atEnd() const { return atEnd_; }
+
+    /// 질의를 보낼 서비스(nullptr = DbService::instance()). 바꾼 뒤에는 reload() 필요.
+    void setService(DbService* svc) { svc_ = svc; }
+    DbService* service() const;
+
+    /**
+     * @brief 페이지 없이 전체 결과를 내는 SQL(같은 조건/정렬). CSV 스트리밍 내보내기용.
+     * @param binds 조건 바인딩 값이 채워진다
+     */
+    QString fullSql(QVariantMap& binds) const;
+
+signals:
+    /// 질의 실패(연결 끊김 등). 실패 후에는 reload() 전까지 더 불러오지 않는다.
+    void loadFailed(const QString& error);
+    /// 페이지 도착(added=추가 행 수, atEnd=마지막 페이지 여부)
+    void pageLoaded(int added, bool atEnd);
+
+protected:
+    /// "SELECT … FROM … WHERE <조건>" — 반드시 WHERE 절로 끝나야 keyset 조건을 AND로 붙일 수 있다
+    virtual QString selectSql(QVariantMap& binds) const = 0;
+    /// last(직전 페이지 마지막 행) 다음부터를 뜻하는 " AND (...)" 조건
+    virtual QString keysetSql(const QVector<QVariant>& last, QVariantMap& binds) const = 0;
+    /// " [GROUP BY …] ORDER BY …" — 정렬은 keyset 키와 일치해야 한다
+    virtual QString tailSql() const = 0;
+    /// 원본 값 → 표시 값(기본: 그대로)
+    virtual QVariant displayValue(const QVector<QVariant>& row, int col) const { return row.value(col); }
+
+    QStringList headers_;   ///< 열 제목(열 수 = headers_.size())
+
+private:
+    void requestPage();
+
+    QString channel_;
+    QPointer<DbService> svc_;
+    QVector<QVector<QVariant>> rows_;   ///< 받은 행(원본 값, 앞쪽 열에 keyset 키 포함)
+    int     pageSize_ = 200;
+    bool    atEnd_    = true;
+    bool    loading_  = false;
+    quint64 gen_      = 0;              ///< reload 세대(이전 세대 결과 폐기)
+};
+
+/// 사원 목록(employee) — 키: emp_id ASC
+class EmployeeModel : public KeysetTableModel {
+    Q_OBJECT
+public:
+    explicit EmployeeModel(QObject* parent = nullptr);
+
+    /// 검색 조건(빈 문자열/음수 = 조건 없음). 적용하려면 reload() 호출. 반환: 조건이 바뀌었는지
+    bool setFilter(const QString& name, const QString& dept, int status);
+
+protected:
+    QString selectSql(QVariantMap& binds) const override;
+    QString keysetSql(const QVector<QVariant>& last, QVariantMap& binds) const override;
+    QString tailSql() const override;
+    QVariant displayValue(const QVector<QVariant>& row, int col) const override;
+
+private:
+    QString name_, dept_;
+    int     status_ = -1;
+};
+
+/// 일자별 근태(daily_attendance 요약 테이블) — 키: (day DESC, emp_id ASC)
+class AttendanceModel : public KeysetTableModel {
+    Q_OBJECT
+public:
+    explicit AttendanceModel(QObject* parent = nullptr);
+
+    /// 조회 조건(empId invalid = 전체 근로자). 적용하려면 reload() 호출.
+    void setFilter(const QDate& from, const QDate& to, const QVariant& empId);
+
+protected:
+    QString selectSql(QVariantMap& binds) const override;
+    QString keysetSql(const QVector<QVariant>& last, QVariantMap& binds) const override;
+    QString tailSql() const override;
+
+private:
+    QDate    from_, to_;
+    QVariant empId_;
+};
@@ -6,18 +6,35 @@
 #include <QLineEdit>              // 텍스트 입력(검색/기간)
 #include <QComboBox>              // 드롭다운(부서/상태/근로자)
 #include <QPushButton>            // 버튼(검색/추가/수정/삭제/조회)
-#include <QTableWidget>           // 테이블(사원/근태 목록 표시)
+#include <QTableView>             // 테이블(사원/근태 목록 표시, 모델 기반)
 #include <QHeaderView>            // 테이블 헤더 설정(리사이즈/정렬)
 #include <QPalette>               // 위젯 배경/전경 팔레트
 #include <QStringList>            // 문자열 목록(헤더 라벨 등)
 #include <QDate>                  // 날짜 처리(기간 기본값/파싱)
-#include <QSqlQuery>              // SQL 실행(SELECT/바인딩)
-#include <QSqlError>              // SQL 에러 추적
-#include <QSqlRecord>             // 결과 레코드 접근
+#include <QDateTime>              // 캐시 마지막 동기화 시각 표시
+#include <QDebug>                 // 질의 실패 로그
 #include <QMessageBox>            // 사용자 피드백(알림/경고)
 #include <QVariant>               // 타입 안전 값 컨테이너(SQL 바인딩/읽기)
 #include <QApplication>           // qApp(전역 스타일/팔레트 접근)
 #include <QStyleFactory>          // 스타일 팩토리(Fusion 강제)
+#include <QMenu>                  // CSV 내보내기 대상 선택 메뉴
+#include <QAction>
+#include <QFileDialog>            // CSV 저장 경로 선택
+#include <QDir>                   // 기본 저장 위치(홈 디렉터리)
+#include <QScrollBar>             // 동기화 후 자동 갱신 여부(맨 위에 있을 때만)
+#include <QTimer>                 // 입력 중 검색 디바운스
+#include <QTableWidget>           // 통계 표(결과 행 수가 작아 아이템 기반으로 충분)
+#include <QSplitter>              // 통계 탭: 사원별/부서별 표 상하 분할
+#include <QCoreApplication>       // 실행 파일 경로(admin_client.ini)
+
+#include "table_fit.h"            // 표본 기반 열 너비 추정(ResizeToContents 대체)
+#include "csv_export.h"           // 백그라운드 CSV 내보내기(스냅샷/DB 스트리밍)
+#include "db_service.h"           // 비동기 DB 서비스(워커 스레드 커넥션 풀)
+#include "attendance_models.h"    // keyset 페이지 지연 로딩 모델(사원/근태)
+#include "attendance_cache.h"     // 로컬 SQLite 읽기 캐시(증분 동기화)
+#include "attendance_analytics.h" // 기간별 근태 통계(병렬 집계)
+#include "employee_io.h"          // 사원 CSV 일괄 가져오기/내보내기
+#include <QProgressDialog>        // 가져오기 진행(취소 가능)
 
 AttendancePage::AttendancePage(QWidget *parent)
     : QWidget(parent)
@@ -25,25 +42,74 @@ AttendancePage::AttendancePage(QWidget *parent)
     buildUi();    // 페이지 UI 트리 구성(탭, 검색바, 테이블 등)
     applyStyle(); // 일관된 룩앤필 적용(폰트/색/테이블/탭)
 
-    // DB 연결 시도(필수 의존성: Qt::Sql 링크 + QMYSQL 드라이버)
-    if (!openDb()) {
-        QMessageBox::warning(this, u8"DB 연결 실패",
-                             u8"DB에 연결할 수 없습니다.\nCMake에 Qt::Sql이 링크되었는지, MySQL(QMYSQL) 드라이버가 설치되었는지 확인하세요.");
-        return; // DB 없이는 목록/근태 로딩 불가 → 초기화 중단
-    }
+    // 입력 중 검색 디바운스(조회 함수가 참조하므로 초기 로딩 전에 생성)
+    searchDebounce_ = new QTimer(this);
+    searchDebounce_->setSingleShot(true);
+    searchDebounce_->setInterval(250);
+    connect(searchDebounce_, &QTimer::timeout, this, [this]{ searchEmployees(false); });
 
     // 기본 조회 기간: 최근 7일
     atTo->setText(QDate::currentDate().toString("yyyy-MM-dd"));
     atFrom->setText(QDate::currentDate().addDays(-7).toString("yyyy-MM-dd"));
 
+    // 조회는 로컬 캐시에서(있으면) — LAN 왕복 없이 응답, DB 링크가 끊겨도 마지막 동기화 데이터로 동작
+    cache_ = AttendanceCache::instance();
+    empModel_->setService(readDb());
+    attModel_->setService(readDb());
+
+    // 통계 엔진: 판정 기준은 admin_client.ini [analytics](없으면 09:00 / 유예 5분 / 8시간)
+    analytics_ = new AttendanceAnalytics(this);
+    analytics_->setRules(AnalyticsRules::fromIni(QCoreApplication::applicationDirPath() + "/admin_client.ini"));
+    analytics_->setService(readDb());
+    anTo->setText(QDate::currentDate().toString("yyyy-MM-dd"));
+    anFrom->setText(QDate(QDate::currentDate().year(), QDate::currentDate().month(), 1).toString("yyyy-MM-dd"));
+
     // 초기 데이터 로딩: 콤보/사원 목록/근태 기록
+    //  - 모두 DbService 워커에서 실행되고 결과만 도착 순서대로 표에 반영(생성자는 즉시 반환)
     reloadWorkerCombo(); // 근로자 드롭다운(“전체 근로자”+이름(사번))
     loadEmployees();     // 사원 테이블
-    loadAttendance();    // 근태 테이블
+    loadAttendance();    // 근태 테이블(캐시 동기화도 함께 요청)
+
+    if (cache_) {
+        connect(cache_, &AttendanceCache::synced, this, &AttendancePage::onCacheSynced);
+        connect(cache_, &AttendanceCache::localFailed, this, [this](const QString& e) {
+            // 캐시 파일을 쓸 수 없으면 원격 직접 조회로 되돌림
+            qWarning() << "attendance cache disabled:" << e;
+            cache_ = nullptr;
+            cacheStatus->clear();
+            empModel_->setService(readDb());
+            attModel_->setService(readDb());
+            analytics_->setService(readDb());
+            reloadWorkerCombo();
+            loadEmployees();
+            loadAttendance();
+        });
+    }
 
     // 사용자 액션 연결: 검색/조회
     connect(btnSearch,  &QPushButton::clicked, this, &AttendancePage::loadEmployees);
+    connect(kwName,     &QLineEdit::returnPressed, this, &AttendancePage::loadEmployees);
     connect(btnRefresh, &QPushButton::clicked, this, &AttendancePage::loadAttendance);
+    connect(btnExport,  &QPushButton::clicked, this, &AttendancePage::exportAttendanceCsv);
+    connect(btnImport,    &QPushButton::clicked, this, &AttendancePage::importEmployeesCsv);
+    connect(btnEmpExport, &QPushButton::clicked, this, &AttendancePage::exportEmployeesCsv);
+    connect(btnAnalyze, &QPushButton::clicked, this, &AttendancePage::runAnalytics);
+    connect(btnAnaExport, &QPushButton::clicked, this, &AttendancePage::exportAnalyticsCsv);
+    connect(analytics_, &AttendanceAnalytics::ready, this,
+            [this](AttendanceReportPtr rep, bool cached){ showReport(*rep, cached); });
+    connect(analytics_, &AttendanceAnalytics::failed, this, [this](const QString& e) {
+        anStatus->setText(u8"계산 실패");
+        reportDbError("analytics", e);
+    });
+
+    // 입력 중 검색: 마지막 입력 후 250ms 동안 추가 입력이 없을 때 한 번만 조회
+    connect(kwName,   &QLineEdit::textEdited,          searchDebounce_, qOverload<>(&QTimer::start));
+    connect(kwDept,   &QComboBox::currentIndexChanged, searchDebounce_, qOverload<>(&QTimer::start));
+    connect(kwStatus, &QComboBox::currentIndexChanged, searchDebounce_, qOverload<>(&QTimer::start));
+    connect(empModel_, &KeysetTableModel::loadFailed, this,
+            [this](const QString& e){ reportDbError("loadEmployees", e); });
+    connect(attModel_, &KeysetTableModel::loadFailed, this,
+            [this](const QString& e){ reportDbError("loadAttendance", e); });
 }
 
 
@@ -96,7 +162,9 @@ void AttendancePage::buildUi() {
         btnAdd    = new QPushButton(u8"추가", page);
         btnEdit   = new QPushButton(u8"수정", page);
         btnRemove = new QPushButton(u8"삭제", page);
-        for (auto *b : {btnAdd, btnEdit, btnRemove}) b->setObjectName("secBtn"); // 세컨더리 룩
+        btnImport    = new QPushButton(u8"CSV 가져오기", page);   // 일괄 등록(검증 → 트랜잭션 반영)
+        btnEmpExport = new QPushButton(u8"CSV 내보내기", page);   // 같은 형식으로 내보내기
+        for (auto *b : {btnAdd, btnEdit, btnRemove, btnImport, btnEmpExport}) b->setObjectName("secBtn"); // 세컨더리 룩
 
         // 검색/액션 바 좌→우 배치: 필터들 → (빈공간) → 검색/CRUD 버튼
         bar->addWidget(new QLabel(u8"이름"));
@@ -111,21 +179,26 @@ void AttendancePage::buildUi() {
         bar->addWidget(btnAdd);
         bar->addWidget(btnEdit);
         bar->addWidget(btnRemove);
+        bar->addSpacing(8);         // CRUD와 일괄 처리 버튼군 사이 간격
+        bar->addWidget(btnImport);
+        bar->addWidget(btnEmpExport);
 
         // 사원 테이블(7열 스키마): 사번/이름/부서/직무/상태/연락처/비고
-        tblWorkers = new QTableWidget(0, 7, page);
+        //  - 모델은 첫 페이지만 받고, 스크롤이 끝에 닿을 때 다음 페이지를 요청(keyset: emp_id)
+        empModel_  = new EmployeeModel(this);
+        tblWorkers = new QTableView(page);
         tblWorkers->setObjectName("workersTable");     // 스타일/테스트 식별자
-        QStringList headers{u8"사번", u8"이름", u8"부서", u8"직무", u8"상태", u8"연락처", u8"비고"};
-        tblWorkers->setHorizontalHeaderLabels(headers);
+        tblWorkers->setModel(empModel_);
         tblWorkers->horizontalHeader()->setStretchLastSection(true);             // 마지막 열(비고) 확장
-        tblWorkers->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents); // 내용 기반 폭 조절
+        tblWorkers->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);      // 폭은 TableColumnFitter가 표본 추정
         tblWorkers->verticalHeader()->setVisible(false);                         // 좌측 행 번호 숨김
-        tblWorkers->setSelectionBehavior(QTableWidget::SelectRows);              // 셀 대신 "행" 선택
-        tblWorkers->setEditTriggers(QTableWidget::NoEditTriggers);               // 직접 편집 금지(보기 전용)
+        tblWorkers->setSelectionBehavior(QAbstractItemView::SelectRows);         // 셀 대신 "행" 선택
+        tblWorkers->setEditTriggers(QAbstractItemView::NoEditTriggers);          // 직접 편집 금지(보기 전용)
         tblWorkers->setAlternatingRowColors(false);                              // 교차색 비활성(테마 일관)
         tblWorkers->setMinimumHeight(420);                                       // 최소 높이(스크롤 확보)
         tblWorkers->verticalHeader()->setDefaultSectionSize(32);                 // 행 높이(가독성)
         tblWorkers->setShowGrid(true);                                           // 그리드 표시(셀 구분 명확)
+        TableColumnFitter::install(tblWorkers);                                  // 행 삽입마다 전체 재측정하지 않도록
 
         // 탭1 완성: 상단 바 + 테이블
         v->addLayout(bar);
@@ -159,6 +232,9 @@ void AttendancePage::buildUi() {
         btnRefresh = new QPushButton(u8"조회", page);   // 근태 데이터 로딩 트리거
         btnRefresh->setObjectName("priBtn");           // 프라이머리 룩
 
+        btnExport = new QPushButton(u8"CSV 내보내기", page); // 현재 표 / 원본 출입 기록
+        btnExport->setObjectName("secBtn");
+
         // 조건 바 배치: 기간 → (간격) → 근로자 → (빈공간) → 조회
         bar->addWidget(new QLabel(u8"기간"));
         bar->addWidget(atFrom);
@@ -168,29 +244,109 @@ void AttendancePage::buildUi() {
         bar->addWidget(new QLabel(u8"근로자"));
         bar->addWidget(atWorker);
         bar->addStretch();
+        cacheStatus = new QLabel(page);                 // 캐시 동기화 상태(오프라인 여부)
+        cacheStatus->setObjectName("cacheStatus");
+
+        bar->addWidget(cacheStatus);
+        bar->addSpacing(8);
         bar->addWidget(btnRefresh);
+        bar->addWidget(btnExport);
 
         // 근태 테이블(7열): 일자/사번/이름/부서/출근/퇴근/근무시간
-        //  - gate_check에서 같은 날짜의 MIN=출근, MAX=퇴근으로 취급(스키마 특성 반영)
-        tblAttendance = new QTableWidget(0, 7, page);
+        //  - 같은 날짜의 MIN=출근, MAX=퇴근(daily_attendance 요약, 스키마 특성 반영)
+        //  - keyset(day DESC, emp_id ASC) 페이지 단위로 스크롤 시 추가 로딩
+        attModel_     = new AttendanceModel(this);
+        tblAttendance = new QTableView(page);
         tblAttendance->setObjectName("attTable");
-        QStringList headers{u8"일자", u8"사번", u8"이름", u8"부서", u8"출근", u8"퇴근", u8"근무시간"};
-        tblAttendance->setHorizontalHeaderLabels(headers);
+        tblAttendance->setModel(attModel_);
         tblAttendance->horizontalHeader()->setStretchLastSection(true);          // 근무시간 열 확장
-        tblAttendance->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        tblAttendance->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
         tblAttendance->verticalHeader()->setVisible(false);
-        tblAttendance->setSelectionBehavior(QTableWidget::SelectRows);
-        tblAttendance->setEditTriggers(QTableWidget::NoEditTriggers);
+        tblAttendance->setSelectionBehavior(QAbstractItemView::SelectRows);
+        tblAttendance->setEditTriggers(QAbstractItemView::NoEditTriggers);
         tblAttendance->setAlternatingRowColors(false);
         tblAttendance->setMinimumHeight(420);
         tblAttendance->verticalHeader()->setDefaultSectionSize(32);
         tblAttendance->setShowGrid(true);
+        TableColumnFitter::install(tblAttendance);
 
         // 탭2 완성: 상단 조건 바 + 근태 테이블
         v->addLayout(bar);
         v->addWidget(tblAttendance, 1);
         tabs->addTab(page, u8"근태");
     }
+
+    // ===== 탭3: 통계(기간별 사원/부서 지각·초과근무·퇴근 누락·결근) =====
+    {
+        auto *page = new QWidget(this);
+        page->setAttribute(Qt::WA_StyledBackground, true);
+        auto *v = new QVBoxLayout(page);
+        v->setSpacing(10);
+        v->setContentsMargins(12,8,12,8);
+
+        // 조건 바: 기간 → (빈공간) → 상태 → 계산/내보내기
+        auto *bar = new QHBoxLayout;
+        bar->setSpacing(8);
+
+        anFrom = new QLineEdit(page);
+        anTo   = new QLineEdit(page);
+        anFrom->setPlaceholderText("YYYY-MM-DD");
+        anTo->setPlaceholderText("YYYY-MM-DD");
+        anFrom->setFixedWidth(140);
+        anTo->setFixedWidth(140);
+        anFrom->setAlignment(Qt::AlignCenter);
+        anTo->setAlignment(Qt::AlignCenter);
+
+        btnAnalyze = new QPushButton(u8"계산", page);
+        btnAnalyze->setObjectName("priBtn");
+        btnAnaExport = new QPushButton(u8"CSV 내보내기", page);
+        btnAnaExport->setObjectName("secBtn");
+
+        anStatus = new QLabel(page);                    // 소요 시간/캐시 여부
+        anStatus->setObjectName("anStatus");
+
+        bar->addWidget(new QLabel(u8"기간"));
+        bar->addWidget(anFrom);
+        bar->addWidget(new QLabel("~"));
+        bar->addWidget(anTo);
+        bar->addStretch();
+        bar->addWidget(anStatus);
+        bar->addSpacing(8);
+        bar->addWidget(btnAnalyze);
+        bar->addWidget(btnAnaExport);
+
+        // 결과 표: 결과 행 수 = 사원 수/부서 수 → 아이템 기반 표 + 헤더 클릭 정렬
+        auto makeTable = [page](const QStringList& headers, const char* name) {
+            auto *t = new QTableWidget(0, headers.size(), page);
+            t->setObjectName(name);
+            t->setHorizontalHeaderLabels(headers);
+            t->horizontalHeader()->setStretchLastSection(true);
+            t->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+            t->verticalHeader()->setVisible(false);
+            t->setSelectionBehavior(QAbstractItemView::SelectRows);
+            t->setEditTriggers(QAbstractItemView::NoEditTriggers);
+            t->verticalHeader()->setDefaultSectionSize(32);
+            t->setShowGrid(true);
+            TableColumnFitter::install(t);
+            return t;
+        };
+        tblWorkerStats = makeTable({u8"사번", u8"이름", u8"부서", u8"출근일", u8"지각", u8"최장 연속 지각",
+                                    u8"초과근무(h)", u8"퇴근 누락", u8"결근", u8"최장 연속 결근", u8"총 근무(h)"},
+                                   "workerStatsTable");
+        tblDeptStats   = makeTable({u8"부서", u8"인원", u8"출근일", u8"지각", u8"초과근무(h)",
+                                    u8"퇴근 누락", u8"결근", u8"평균 근무(h/일)"},
+                                   "deptStatsTable");
+
+        auto *split = new QSplitter(Qt::Vertical, page);
+        split->addWidget(tblWorkerStats);
+        split->addWidget(tblDeptStats);
+        split->setStretchFactor(0, 3);
+        split->setStretchFactor(1, 1);
+
+        v->addLayout(bar);
+        v->addWidget(split, 1);
+        tabs->addTab(page, u8"통계");
+    }
 }
 
 void AttendancePage::applyStyle() {
@@ -316,7 +472,7 @@ void AttendancePage::applyStyle() {
         }
 
         /* ====== 테이블(사원/근태 공통) ====== */
-        QTableWidget#workersTable, QTableWidget#attTable{
+        QTableView#workersTable, QTableView#attTable{
             background:%15;                   /* 카드형 흰 배경 */
             color:%2;
             border:1px solid #dbe3ff;
@@ -332,7 +488,7 @@ void AttendancePage::applyStyle() {
         }
 
         /* 행 선택 강조색 */
-        QTableWidget::item:selected{
+        QTableView::item:selected{
             background:%9;
             color:%2;
         }
@@ -405,230 +561,341 @@ void AttendancePage::applyStyle() {
 }
 
 // ===== DB 연결 =====
-// - 단일 커넥션 이름("att_conn")을 사용해 재진입/재사용 가능하도록 구성
-// - QMYSQL 드라이버로 MySQL/MariaDB에 연결하며, 드라이버 미설치 시 open()에서 실패 반환
-bool AttendancePage::openDb() {
-    // 이미 동일 이름의 커넥션이 존재하면 재사용(중복 연결 방지)
-    if (QSqlDatabase::contains("att_conn"))
-        db_ = QSqlDatabase::database("att_conn");
-    else
-        db_ = QSqlDatabase::addDatabase("QMYSQL", "att_conn"); // 새 커넥션 생성(QMYSQL 드라이버)
-
-    // ⏱ 연결/읽기/쓰기 타임아웃(초) 설정으로 지연 발생 시 빠르게 실패하도록 유도
-    //    - 지원 드라이버(QMYSQL)에서만 실제 적용, 미지원 환경에서도 무해(무시됨)
-    db_.setConnectOptions("MYSQL_OPT_CONNECT_TIMEOUT=3;"
-                          "MYSQL_OPT_READ_TIMEOUT=5;"
-                          "MYSQL_OPT_WRITE_TIMEOUT=5");
-
-    // 접속 파라미터(예시값) — 실제 배포 시 환경변수/설정파일(.ini)로 분리 권장
-    db_.setHostName("192.168.0.15");
-    db_.setPort(3306);
-    db_.setDatabaseName("safetydb");
-    db_.setUserName("user1");
-    db_.setPassword("1234");
-
-    // 실제 DB 연결 시도
-    if (!db_.open()) {
-        // 실패 시 에러 메시지를 로그로 남기고 false 반환(상위에서 사용자 알림 처리)
-        qWarning() << "DB open failed:" << db_.lastError().text();
-        return false;
+// - 실제 커넥션은 DbService 워커 스레드가 보유(admin_client.ini [db], 없으면 기본값)
+// - 이 페이지는 질의를 예약만 하고 결과는 GUI 스레드에서 받아 표에 채운다
+//   → DB 호스트가 느리거나 죽어 있어도 페이지 생성/탭 전환/카메라 타일이 멈추지 않음
+DbService* AttendancePage::readDb() const {
+    DbService* local = cache_ ? cache_->local() : nullptr;
+    return local ? local : DbService::instance();
+}
+
+// ===== 캐시 동기화 결과 =====
+// - 조회는 이미 로컬에서 끝났으므로 여기서는 "새 데이터가 왔는지"만 반영
+// - 표를 다시 읽으면 스크롤 위치가 처음으로 돌아가므로, 맨 위를 보고 있을 때만 자동 갱신
+void AttendancePage::onCacheSynced(bool ok, bool employeesChanged, int attendanceRows, const QString& error) {
+    if (!ok) {
+        const QDateTime last = cache_ ? cache_->lastSync() : QDateTime();
+        cacheStatus->setText(last.isValid()
+            ? u8"오프라인 · 캐시 " + last.toString("MM-dd HH:mm")
+            : u8"오프라인 · 캐시 없음");
+        cacheStatus->setToolTip(error);
+        return;
     }
-    return true; // 연결 성공
+    cacheStatus->setText(u8"동기화 " + QTime::currentTime().toString("HH:mm:ss"));
+    cacheStatus->setToolTip(QString());
+
+    if (employeesChanged) {
+        reloadWorkerCombo();
+        if (tblWorkers->verticalScrollBar()->value() == 0) empModel_->reload();
+    }
+    if (attendanceRows > 0 && tblAttendance->verticalScrollBar()->value() == 0)
+        attModel_->reload();
+    if (employeesChanged || attendanceRows > 0)
+        analytics_->invalidate();   // 다음 계산은 새 데이터로(현재 표시 중인 결과는 그대로)
 }
 
-// 직원 상태 코드 → 한글 라벨 변환(표시 전용)
-// - 현재 스키마 기준: 1=재직, 그 외=퇴사 (필요 시 확장 가능)
-QString AttendancePage::statusToKorean(int s) const {
-    return s == 1 ? u8"재직" : u8"퇴사";
+void AttendancePage::reportDbError(const QString& where, const QString& error) {
+    qWarning() << where << "err:" << error;
+    if (dbErrorShown_) return;   // 연결 실패 안내는 한 번만(재조회마다 대화상자 반복 방지)
+    dbErrorShown_ = true;
+    QMessageBox::warning(this, u8"DB 연결 실패",
+                         u8"DB에 연결할 수 없습니다.\nCMake에 Qt::Sql이 링크되었는지, MySQL(QMYSQL) 드라이버가 설치되었는지 확인하세요.\n\n"
+                         + error);
 }
 
 // ===== 근로자 콤보 리로드 =====
 // - atWorker 콤보박스의 항목을 DB에서 재구성
 // - 첫 항목은 "전체 근로자"(data 없음)로, 조회 시 직원 필터 미적용을 의미
 void AttendancePage::reloadWorkerCombo() {
-    atWorker->clear();
-    atWorker->addItem(u8"전체 근로자"); // data()가 invalid → 전체 검색
-
-    QSqlQuery q(db_);
     // 이름 기준 정렬로 사용자 선택 편의성 향상
-    if (!q.exec("SELECT emp_id, name FROM employee ORDER BY name ASC")) {
-        qWarning() << "reloadWorkerCombo err:" << q.lastError().text();
-        return;
-    }
-    // 각 항목: "이름 (사번)" 형태의 표시 텍스트 + 사용자 데이터(data)=emp_id
-    while (q.next()) {
-        const int empId = q.value(0).toInt();
-        const QString name = q.value(1).toString();
-        atWorker->addItem(QString("%1 (%2)").arg(name).arg(empId), empId);
-    }
+    readDb()->submit("SELECT emp_id, name FROM employee ORDER BY name ASC",
+                                  {}, "att.workers")
+        .then(this, [this](const DbResult& r) {
+            if (r.canceled) return;   // 더 최근 요청이 있음
+            if (!r.ok) { reportDbError("reloadWorkerCombo", r.error); return; }
+
+            // 선택 유지: 재구성 전 선택된 사번 기억
+            const QVariant keep = atWorker->currentData();
+            atWorker->clear();
+            atWorker->addItem(u8"전체 근로자"); // data()가 invalid → 전체 검색
+            // 각 항목: "이름 (사번)" 형태의 표시 텍스트 + 사용자 데이터(data)=emp_id
+            for (const auto& row : r.rows) {
+                const int empId = row.value(0).toInt();
+                const QString name = row.value(1).toString();
+                atWorker->addItem(QString("%1 (%2)").arg(name).arg(empId), empId);
+            }
+            if (keep.isValid()) {
+                const int i = atWorker->findData(keep);
+                if (i >= 0) atWorker->setCurrentIndex(i);
+            }
+        });
 }
 
 // ===== 근로자 목록 로딩 (employee) =====
-// - 검색바(이름/부서/상태) 조건을 적용해 사원 테이블(tblWorkers)을 채움
-// - 바인딩(:name, :dept, :status) 사용으로 SQL 인젝션 방지 및 캐시 힌트 제공
-void AttendancePage::loadEmployees() {
-    // 기존 행 제거 후 재구성
-    tblWorkers->setRowCount(0);
+// - 검색바(이름/부서/상태) 조건을 모델에 넘기고 첫 페이지부터 다시 로딩
+// - 이후 페이지는 스크롤 시 모델이 keyset(emp_id)으로 이어서 요청
+// - 검색을 연달아 누르면 이전 질의는 채널 교체로 취소(오래된 결과가 최신 결과를 덮어쓰지 않음)
+// - 입력 중 검색(force=false)은 조건이 그대로면(예: 글자를 지웠다 다시 입력) 질의하지 않음
+void AttendancePage::searchEmployees(bool force) {
+    searchDebounce_->stop();   // 버튼으로 바로 조회한 경우 대기 중인 디바운스는 불필요
+    const QString name = kwName->text().trimmed();
+    const QString dept = kwDept->currentText() != u8"전체 부서" ? kwDept->currentText().trimmed() : QString();
+    // 상태 (UI: 재직/휴가/퇴사 → 스키마: 1/0 등으로 매핑, -1 = 조건 없음)
+    const int status = kwStatus->currentText() == u8"전체 상태" ? -1
+                     : (kwStatus->currentText() == u8"재직" ? 1 : 0);
+    if (!empModel_->setFilter(name, dept, status) && !force) return;
+    empModel_->reload();
+
+    // [성능 팁] 로컬 캐시는 이름을 n-gram 색인(employee_ngram)으로 찾습니다.
+    //           캐시를 끈 경우 employee(department), employee(status) 인덱스를 상황에 맞게 추가하세요.
+}
 
-    // 기본 SELECT: NULL 대비 COALESCE로 표시 일관성 유지
-    QString sql =
-        "SELECT emp_id, name, COALESCE(department,''), COALESCE(position,''), "
-        "       status, COALESCE(phone,''), '' AS etc "
-        "FROM employee WHERE 1=1 ";
-
-    // 조건절 구성 — 입력값이 있을 때만 조건 추가(불필요한 인덱스 스캔 방지)
-    // 이름 LIKE (부분 일치)
-    if (!kwName->text().trimmed().isEmpty())
-        sql += " AND name LIKE :name ";
-
-    // 부서 완전 일치
-    if (kwDept->currentText() != u8"전체 부서")
-        sql += " AND department = :dept ";
-
-    // 상태 완전 일치 (UI: 재직/휴가/퇴사 → 스키마: 1/0 등으로 매핑)
-    if (kwStatus->currentText() != u8"전체 상태")
-        sql += " AND status = :status ";
-
-    // 정렬: 사번 오름차순(안정적인 정렬 기준)
-    sql += " ORDER BY emp_id ASC";
-
-    QSqlQuery q(db_);
-    q.prepare(sql);
-    // 이름 바인딩 — 앞/뒤 와일드카드로 부분 검색
-    if (!kwName->text().trimmed().isEmpty())
-        q.bindValue(":name", "%" + kwName->text().trimmed() + "%");
-    // 부서 바인딩
-    if (kwDept->currentText() != u8"전체 부서")
-        q.bindValue(":dept", kwDept->currentText().trimmed());
-    // 상태 바인딩 — UI 라벨을 코드로 변환(예: 재직→1, 그 외→0)
-    if (kwStatus->currentText() != u8"전체 상태")
-        q.bindValue(":status", kwStatus->currentText()==u8"재직" ? 1 : 0);
-
-    // 쿼리 실행 및 에러 처리
-    if (!q.exec()) {
-        qWarning() << "loadEmployees err:" << q.lastError().text();
+// ===== 출석 기록 로딩 (daily_attendance) =====
+// - 기간/직원 필터를 모델에 넘기고 첫 페이지부터 다시 로딩(요약 조회 SQL은 AttendanceModel 참고)
+// - 첫 화면은 pageSize 행만 가져오며, 스크롤 시 keyset(day DESC, emp_id ASC)으로 이어서 요청
+void AttendancePage::loadAttendance() {
+    // 날짜 범위 파싱(YYYY-MM-DD) — 유효성 실패 시 사용자 안내 후 종료
+    const QDate from = QDate::fromString(atFrom->text().trimmed(),  "yyyy-MM-dd");
+    const QDate to   = QDate::fromString(atTo->text().trimmed(),    "yyyy-MM-dd");
+    if (!from.isValid() || !to.isValid()) {
+        QMessageBox::information(this, u8"입력 확인", u8"기간을 YYYY-MM-DD 형식으로 입력하세요.");
         return;
     }
 
-    // 결과 → 테이블 행으로 매핑
-    int r = 0;
-    while (q.next()) {
-        // 각 셀 생성(중앙 정렬로 표 형태 가독성 고정)
-        auto *c0 = new QTableWidgetItem(q.value(0).toString());               // 사번
-        auto *c1 = new QTableWidgetItem(q.value(1).toString());               // 이름
-        auto *c2 = new QTableWidgetItem(q.value(2).toString());               // 부서
-        auto *c3 = new QTableWidgetItem(q.value(3).toString());               // 직무
-        auto *c4 = new QTableWidgetItem(statusToKorean(q.value(4).toInt()));  // 상태(한글 변환)
-        auto *c5 = new QTableWidgetItem(q.value(5).toString());               // 연락처
-        auto *c6 = new QTableWidgetItem(q.value(6).toString());               // 비고
-
-        for (auto *it : {c0,c1,c2,c3,c4,c5,c6})
-            it->setTextAlignment(Qt::AlignCenter); // 표 텍스트 가운데 정렬
-
-        // 테이블에 행 삽입
-        tblWorkers->insertRow(r);
-        tblWorkers->setItem(r, 0, c0);
-        tblWorkers->setItem(r, 1, c1);
-        tblWorkers->setItem(r, 2, c2);
-        tblWorkers->setItem(r, 3, c3);
-        tblWorkers->setItem(r, 4, c4);
-        tblWorkers->setItem(r, 5, c5);
-        tblWorkers->setItem(r, 6, c6);
-        ++r;
-    }
+    // 특정 직원 필터: 콤보 data(emp_id)가 유효할 때만 조건 추가
+    attModel_->setFilter(from, to, atWorker->currentData());
+    attModel_->reload();
+    analytics_->invalidate();     // 새로 고침 = 새 데이터(캐시를 끈 경우 onCacheSynced가 없으므로 여기서도)
+    if (cache_) cache_->sync();   // 캐시 표시는 즉시, 원격 변경분은 동기화 후 onCacheSynced에서 반영
 
-    // [성능 팁] employee(name), employee(department), employee(status) 인덱스를 상황에 맞게 추가하면
-    //           LIKE/동등 조건 성능이 크게 개선됩니다(특히 데이터가 수만 건 이상일 때).
+    // [성능 팁]
+    // - 요약 테이블은 (day, emp_id)당 1행 — 원본이 1년치여도 조회 비용은 일수 × 인원에 비례합니다.
+    // [정확도 팁]
+    // - 장치/서버/클라이언트의 타임존이 상이하면 DATE() 경계가 달라질 수 있으니
+    //   가능하면 서버/DB/앱 타임존을 통일하거나 UTC 저장/로컬 표시를 권장합니다.
 }
 
-// ===== 출석 기록 로딩 (gate_check) =====
-// - 기간/직원 필터에 따라 출퇴근 데이터를 집계하여 표(tblAttendance)에 표시
-// - 스키마에 '입/퇴근 구분'이 없으므로 같은 날짜에서 MIN=출근, MAX=퇴근으로 간주
-// - 시간 계산은 DB에서 TIMEDIFF로 처리(클라이언트 계산 부담 감소)
-void AttendancePage::loadAttendance() {
-    // 기존 행 초기화
-    tblAttendance->setRowCount(0);
-
-    // 날짜 범위 파싱(YYYY-MM-DD) — 유효성 실패 시 사용자 안내 후 종료
-    const QDate from = QDate::fromString(atFrom->text().trimmed(),  "yyyy-MM-dd");
-    const QDate to   = QDate::fromString(atTo->text().trimmed(),    "yyyy-MM-dd");
+// ===== 근태 CSV 내보내기 =====
+// - 대상 선택 메뉴 → 저장 경로 → CsvExportJob(워커 스레드)으로 위임
+// - GUI 스레드는 스냅샷(현재 표) 또는 조건 바인딩(원본)만 준비하고 즉시 반환
+void AttendancePage::exportAttendanceCsv() {
+    QMenu menu(this);
+    QAction* actTable = menu.addAction(u8"일자별 집계(조회 조건 전체)");
+    QAction* actRaw   = menu.addAction(u8"원본 출입 기록(gate_check)");
+    QAction* chosen   = menu.exec(btnExport->mapToGlobal(QPoint(0, btnExport->height())));
+    if (!chosen) return;
+
+    // 집계/원본 모두 마지막 조회(집계) 또는 현재 입력(원본)의 기간/근로자 조건을 사용
+    const QDate from = QDate::fromString(atFrom->text().trimmed(), "yyyy-MM-dd");
+    const QDate to   = QDate::fromString(atTo->text().trimmed(),   "yyyy-MM-dd");
     if (!from.isValid() || !to.isValid()) {
         QMessageBox::information(this, u8"입력 확인", u8"기간을 YYYY-MM-DD 형식으로 입력하세요.");
         return;
     }
 
-    // 특정 직원 필터 여부 판단: 콤보 data(emp_id)가 유효할 때만 조건 추가
-    QVariant empIdData = atWorker->currentData();
-    const bool filterByEmp = empIdData.isValid();
-
-    /*
-     * gate_check 스키마에는 '입/퇴근 구분'이 없으므로
-     * 같은 날짜의 MIN=출근, MAX=퇴근으로 간주.
-     * - FROM..TO+1day 구간으로 날짜 폐구간 처리
-     * - DB에서 DATE(), MIN/MAX, TIMEDIFF로 일자별 집계 수행
-     * - 시간 포맷은 HH:mm으로 간략화(표시 UX 기준)
-     */
+    const QString base = (chosen == actRaw) ? "gate_check_" : "attendance_";
+    const QString def  = QDir::homePath() + "/" + base
+                       + QDate::currentDate().toString("yyyyMMdd") + ".csv";
+    const QString path = QFileDialog::getSaveFileName(this, u8"CSV로 내보내기", def, "CSV (*.csv)");
+    if (path.isEmpty()) return;
+
+    if (chosen == actTable) {
+        // 표에는 스크롤한 페이지까지만 있으므로, 같은 조건의 집계 SQL을 페이지 없이 스트리밍
+        QVariantMap binds;
+        const QString sql = attModel_->fullSql(binds);
+        QStringList header;
+        for (int c = 0; c < attModel_->columnCount(); ++c)
+            header << attModel_->headerData(c, Qt::Horizontal).toString();
+        CsvExportJob::startWithProgress(
+            CsvExportJob::fromSql(attModel_->service()->templateConnection(), sql, binds, header, path, this), this);
+        return;
+    }
+
     QString sql =
-        "SELECT DATE(g.check_time) AS day, e.emp_id, e.name, e.department, "
-        "       DATE_FORMAT(MIN(g.check_time), '%H:%i') AS in_time, "
-        "       DATE_FORMAT(MAX(g.check_time), '%H:%i') AS out_time, "
-        "       TIMEDIFF(MAX(g.check_time), MIN(g.check_time)) AS hours "
-        "FROM gate_check g "
-        "JOIN employee e ON e.emp_id = g.emp_id "
-        "WHERE g.check_time >= :from AND g.check_time < DATE_ADD(:to, INTERVAL 1 DAY) ";
-
-    // 특정 직원 조건(선택된 경우에만 추가)
-    if (filterByEmp)
-        sql += " AND e.emp_id = :emp ";
-
-    // 그룹화: 일자/사번 단위 집계, 정렬: 최신 일자 DESC → 사번 ASC
-    sql += " GROUP BY day, e.emp_id "
-           " ORDER BY day DESC, e.emp_id ASC";
-
-    QSqlQuery q(db_);
-    q.prepare(sql);
-    // 날짜 바인딩 — 문자열로 전달(서버 타임존 영향이 우려되면 UTC 고정 또는 tz 변환 고려)
-    q.bindValue(":from", from.toString("yyyy-MM-dd"));
-    q.bindValue(":to",   to.toString("yyyy-MM-dd"));
-    if (filterByEmp)
-        q.bindValue(":emp", empIdData.toInt());
-
-    // 쿼리 실행 및 에러 처리
-    if (!q.exec()) {
-        qWarning() << "loadAttendance err:" << q.lastError().text();
+        "SELECT DATE_FORMAT(check_time, '%Y-%m-%d %H:%i:%s'), emp_id, "
+        "       COALESCE(name,''), COALESCE(department,'') "
+        "FROM gate_check "
+        "WHERE check_time >= :from AND check_time < DATE_ADD(:to, INTERVAL 1 DAY) ";
+    QVariantMap binds{{":from", from.toString("yyyy-MM-dd")},
+                      {":to",   to.toString("yyyy-MM-dd")}};
+    const QVariant empIdData = atWorker->currentData();
+    if (empIdData.isValid()) {
+        sql += " AND emp_id = :emp ";
+        binds.insert(":emp", empIdData.toInt());
+    }
+    sql += " ORDER BY check_time ASC";   // (check_time) 인덱스 순서 그대로 스트리밍
+
+    const QStringList header{u8"시각", u8"사번", u8"이름", u8"부서"};
+    CsvExportJob::startWithProgress(
+        CsvExportJob::fromSql(DbService::instance()->templateConnection(), sql, binds, header, path, this), this);
+}
+
+// ===== 통계 계산 =====
+// - 조회/집계는 AttendanceAnalytics가 비동기로 처리(날짜 구간 병렬), 결과는 ready 시그널로 도착
+// - 같은 기간/기준의 재계산은 캐시에서 즉시
+void AttendancePage::runAnalytics() {
+    const QDate from = QDate::fromString(anFrom->text().trimmed(), "yyyy-MM-dd");
+    const QDate to   = QDate::fromString(anTo->text().trimmed(),   "yyyy-MM-dd");
+    if (!from.isValid() || !to.isValid() || from > to) {
+        QMessageBox::information(this, u8"입력 확인", u8"기간을 YYYY-MM-DD 형식으로(시작 ≤ 종료) 입력하세요.");
         return;
     }
+    anStatus->setText(u8"계산 중…");
+    analytics_->compute(from, to);
+}
 
-    // 결과 → 테이블에 매핑(7열: 일자/사번/이름/부서/출근/퇴근/근무시간)
-    int r = 0;
-    while (q.next()) {
-        auto *c0 = new QTableWidgetItem(q.value("day").toString());        // 일자(YYYY-MM-DD)
-        auto *c1 = new QTableWidgetItem(q.value("emp_id").toString());     // 사번
-        auto *c2 = new QTableWidgetItem(q.value("name").toString());       // 이름
-        auto *c3 = new QTableWidgetItem(q.value("department").toString()); // 부서
-        auto *c4 = new QTableWidgetItem(q.value("in_time").toString());    // 출근(HH:mm)
-        auto *c5 = new QTableWidgetItem(q.value("out_time").toString());   // 퇴근(HH:mm)
-        auto *c6 = new QTableWidgetItem(q.value("hours").toString());      // 근무시간(HH:mm:ss)
-
-        for (auto *it : {c0,c1,c2,c3,c4,c5,c6})
-            it->setTextAlignment(Qt::AlignCenter); // 표 텍스트 가운데 정렬
-
-        // 행 삽입
-        tblAttendance->insertRow(r);
-        tblAttendance->setItem(r, 0, c0);
-        tblAttendance->setItem(r, 1, c1);
-        tblAttendance->setItem(r, 2, c2);
-        tblAttendance->setItem(r, 3, c3);
-        tblAttendance->setItem(r, 4, c4);
-        tblAttendance->setItem(r, 5, c5);
-        tblAttendance->setItem(r, 6, c6);
-        ++r;
+void AttendancePage::showReport(const AttendanceReport& rep, bool cached) {
+    // 숫자 열은 DisplayRole에 숫자를 넣어 헤더 정렬이 문자열이 아닌 값 기준이 되도록
+    auto num = [](qint64 v) {
+        auto *it = new QTableWidgetItem;
+        it->setData(Qt::DisplayRole, v);
+        it->setTextAlignment(Qt::AlignCenter);
+        return it;
+    };
+    auto hours = [](double sec) {
+        auto *it = new QTableWidgetItem;
+        it->setData(Qt::DisplayRole, qRound(sec / 360.0) / 10.0);   // 소수 첫째 자리
+        it->setTextAlignment(Qt::AlignCenter);
+        return it;
+    };
+    auto text = [](const QString& s) {
+        auto *it = new QTableWidgetItem(s);
+        it->setTextAlignment(Qt::AlignCenter);
+        return it;
+    };
+
+    tblWorkerStats->setSortingEnabled(false);   // 채우는 동안 행이 재정렬되지 않도록
+    tblWorkerStats->setRowCount(rep.workers.size());
+    for (int r = 0; r < rep.workers.size(); ++r) {
+        const WorkerStats& w = rep.workers[r];
+        int c = 0;
+        tblWorkerStats->setItem(r, c++, num(w.empId));
+        tblWorkerStats->setItem(r, c++, text(w.name));
+        tblWorkerStats->setItem(r, c++, text(w.dept));
+        tblWorkerStats->setItem(r, c++, num(w.days));
+        tblWorkerStats->setItem(r, c++, num(w.late));
+        tblWorkerStats->setItem(r, c++, num(w.longestLateRun));
+        tblWorkerStats->setItem(r, c++, hours(w.overtimeSec));
+        tblWorkerStats->setItem(r, c++, num(w.missingOut));
+        tblWorkerStats->setItem(r, c++, num(w.absent));
+        tblWorkerStats->setItem(r, c++, num(w.longestAbsentRun));
+        tblWorkerStats->setItem(r, c++, hours(w.workedSec));
     }
+    tblWorkerStats->setSortingEnabled(true);
+
+    tblDeptStats->setSortingEnabled(false);
+    tblDeptStats->setRowCount(rep.depts.size());
+    for (int r = 0; r < rep.depts.size(); ++r) {
+        const DeptStats& d = rep.depts[r];
+        int c = 0;
+        tblDeptStats->setItem(r, c++, text(d.dept.isEmpty() ? u8"(미지정)" : d.dept));
+        tblDeptStats->setItem(r, c++, num(d.workers));
+        tblDeptStats->setItem(r, c++, num(d.days));
+        tblDeptStats->setItem(r, c++, num(d.late));
+        tblDeptStats->setItem(r, c++, hours(d.overtimeSec));
+        tblDeptStats->setItem(r, c++, num(d.missingOut));
+        tblDeptStats->setItem(r, c++, num(d.absent));
+        tblDeptStats->setItem(r, c++, hours(d.days ? double(d.workedSec) / d.days : 0.0));
+    }
+    tblDeptStats->setSortingEnabled(true);
 
-    // [성능 팁]
-    // - gate_check(check_time), gate_check(emp_id, check_time) 복합 인덱스가 있으면
-    //   기간/직원 조건에서 대용량 데이터도 빠르게 조회됩니다.
-    // [정확도 팁]
-    // - 장치/서버/클라이언트의 타임존이 상이하면 DATE() 경계가 달라질 수 있으니
-    //   가능하면 서버/DB/앱 타임존을 통일하거나 UTC 저장/로컬 표시를 권장합니다.
+    anStatus->setText(cached
+        ? QString(u8"%1~%2 · 캐시").arg(rep.from.toString("MM-dd"), rep.to.toString("MM-dd"))
+        : QString(u8"%1~%2 · %3ms (%4구간)").arg(rep.from.toString("MM-dd"), rep.to.toString("MM-dd"))
+                                            .arg(rep.elapsedMs).arg(rep.partitions));
+}
+
+// ===== 통계 CSV 내보내기 =====
+// - 화면 표(사원별/부서별)를 스냅샷해 워커 스레드에서 기록(행 수가 작아 스냅샷 비용 무시 가능)
+void AttendancePage::exportAnalyticsCsv() {
+    QMenu menu(this);
+    QAction* actWorkers = menu.addAction(u8"사원별 통계");
+    QAction* actDepts   = menu.addAction(u8"부서별 합계");
+    QAction* chosen     = menu.exec(btnAnaExport->mapToGlobal(QPoint(0, btnAnaExport->height())));
+    if (!chosen) return;
+
+    QTableWidget* t = (chosen == actWorkers) ? tblWorkerStats : tblDeptStats;
+    const QString base = (chosen == actDepts) ? "attendance_dept_" : "attendance_stats_";
+    const QString def  = QDir::homePath() + "/" + base
+                       + anFrom->text().remove('-') + "_" + anTo->text().remove('-') + ".csv";
+    const QString path = QFileDialog::getSaveFileName(this, u8"CSV로 내보내기", def, "CSV (*.csv)");
+    if (path.isEmpty()) return;
+    CsvExportJob::startWithProgress(CsvExportJob::fromModel(t->model(), path, this), this);
+}
+
+// ===== 사원 CSV 가져오기 =====
+// - 파일 선택 → 워커에서 파싱/검증 → 요약 확인 → 원격 MySQL에 한 트랜잭션으로 반영
+// - 검증 실패 행과 DB가 거부한 행은 줄 번호와 함께 상세 보기로 보여 줌(나머지 행은 반영)
+void AttendancePage::importEmployeesCsv() {
+    const QString path = QFileDialog::getOpenFileName(this, u8"사원 CSV 가져오기", QDir::homePath(), "CSV (*.csv)");
+    if (path.isEmpty()) return;
+
+    btnImport->setEnabled(false);
+    EmployeeIo::parseCsvAsync(path).then(this, [this](const EmployeeIo::Parsed& p) {
+        auto issuesText = [](const QVector<EmployeeIo::Issue>& issues) {
+            QStringList lines;
+            for (const auto& i : issues) lines << QString(u8"%1행: %2").arg(i.line).arg(i.message);
+            return lines.join('\n');
+        };
+
+        if (!p.error.isEmpty() || p.records.isEmpty()) {
+            btnImport->setEnabled(true);
+            QMessageBox box(QMessageBox::Warning, u8"가져오기",
+                            p.error.isEmpty() ? u8"가져올 수 있는 행이 없습니다." : p.error, QMessageBox::Ok, this);
+            if (!p.issues.isEmpty()) box.setDetailedText(issuesText(p.issues));
+            box.exec();
+            return;
+        }
+
+        // 반영 전 확인: 유효/오류 행 수(오류 상세는 펼쳐 보기)
+        QMessageBox ask(QMessageBox::Question, u8"가져오기",
+                        QString(u8"유효한 행 %1개를 반영합니다.%2\n(같은 사번은 갱신, 사번이 비어 있으면 새로 등록)")
+                            .arg(p.records.size())
+                            .arg(p.issues.isEmpty() ? QString() : QString(u8"\n검증 실패 %1행은 제외됩니다.").arg(p.issues.size())),
+                        QMessageBox::Ok | QMessageBox::Cancel, this);
+        if (!p.issues.isEmpty()) ask.setDetailedText(issuesText(p.issues));
+        if (ask.exec() != QMessageBox::Ok) { btnImport->setEnabled(true); return; }
+
+        auto *dlg = new QProgressDialog(u8"사원 정보를 반영하는 중…", u8"취소", 0, 0, this);
+        dlg->setWindowModality(Qt::WindowModal);
+        dlg->setMinimumDuration(300);
+        dlg->setAttribute(Qt::WA_DeleteOnClose);
+        connect(dlg, &QProgressDialog::canceled, this, []{
+            DbService::instance()->cancelChannel("emp.import");   // 트랜잭션 전체 롤백
+        });
+
+        const QVector<EmployeeIo::Issue> preIssues = p.issues;
+        EmployeeIo::submitImport(DbService::instance(), p.records)
+            .then(this, [this, dlg, preIssues, issuesText](const DbResult& r) {
+                dlg->close();
+                btnImport->setEnabled(true);
+                if (r.canceled) return;
+                if (!r.ok) { reportDbError("importEmployees", r.error); return; }
+
+                QVector<EmployeeIo::Issue> all = preIssues;
+                for (const auto& row : r.rows) all << EmployeeIo::Issue{row.value(0).toInt(), row.value(1).toString()};
+                QMessageBox box(all.isEmpty() ? QMessageBox::Information : QMessageBox::Warning, u8"가져오기",
+                                QString(u8"%1행을 반영했습니다.%2").arg(r.numRowsAffected)
+                                    .arg(all.isEmpty() ? QString() : QString(u8" 실패 %1행(상세 보기).").arg(all.size())),
+                                QMessageBox::Ok, this);
+                if (!all.isEmpty()) box.setDetailedText(issuesText(all));
+                box.exec();
+
+                // 원본이 바뀌었으므로 캐시를 당겨오고 화면 갱신(캐시가 없으면 바로 원격 재조회)
+                if (cache_) cache_->sync();
+                reloadWorkerCombo();
+                loadEmployees();
+            });
+    });
+}
+
+// ===== 사원 CSV 내보내기 =====
+// - 가져오기와 같은 열/상태 표기 → 내보낸 파일을 고쳐 다시 가져올 수 있음
+void AttendancePage::exportEmployeesCsv() {
+    const QString def  = QDir::homePath() + "/employees_" + QDate::currentDate().toString("yyyyMMdd") + ".csv";
+    const QString path = QFileDialog::getSaveFileName(this, u8"사원 CSV 내보내기", def, "CSV (*.csv)");
+    if (path.isEmpty()) return;
+    CsvExportJob::startWithProgress(
+        CsvExportJob::fromSql(readDb()->templateConnection(), EmployeeIo::exportSql(), {},
+                              EmployeeIo::header(), path, this), this);
 }
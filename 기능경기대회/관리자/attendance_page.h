@@ -1,24 +1,35 @@
 #pragma once
 #include <QWidget>       // QWidget 기반 페이지(탭/버튼/테이블 등 UI 컨테이너)
-#include <QSqlDatabase>  // MySQL 등 RDB 연결 핸들(근태/사원 조회에 사용)
 
 class QTabWidget;
 class QLineEdit;
 class QComboBox;
 class QPushButton;
-class QTableWidget;
+class QTableView;
 class QLabel;
+class QTimer;
+class QTableWidget;
+class EmployeeModel;
+class AttendanceModel;
+class AttendanceCache;
+class DbService;
+class AttendanceAnalytics;
+struct AttendanceReport;
 
 /**
  * @brief 사원 관리/근태 조회 화면의 메인 페이지 위젯.
  *
  * 기능 개요
  * - "사원" 탭: employee 테이블을 조건(이름/부서/상태)으로 조회해 목록을 표시.
- * - "근태" 탭: gate_check 테이블을 기간/사원으로 필터링하여 일자별 출근/퇴근/근무시간을 집계 표시.
- * - DB 연결은 페이지 생성 시 1회 시도하고, 콤보/테이블 로딩을 트리거하는 버튼 액션 제공.
+ * - "근태" 탭: daily_attendance 요약(gate_check 삽입 트리거가 유지)을 기간/사원으로 조회해 일자별 출근/퇴근/근무시간 표시.
+ * - "통계" 탭: 기간별 사원/부서 지각·초과근무·퇴근 누락·결근·연속 기록(AttendanceAnalytics, 병렬 집계 + 기간별 캐시).
+ * - 모든 질의는 DbService(워커 스레드 커넥션 풀)로 비동기 실행 — 페이지 생성/조회가 GUI를 막지 않음.
+ * - 사원/근태 조회는 로컬 캐시(AttendanceCache, SQLite)에서 실행하고, 캐시는 주기적으로 MySQL과 증분 동기화.
+ *   DB 링크가 끊겨도 마지막 동기화 시점까지의 데이터로 조회된다(상태 라벨에 오프라인 표시).
+ * - 같은 목록을 다시 조회하면 이전 질의는 취소되고 최신 결과만 반영된다.
  *
  * UI 구성
- * - 상단 탭(QTabWidget): [사원], [근태]
+ * - 상단 탭(QTabWidget): [사원], [근태], [통계]
  *   - 사원 탭: 검색바(이름/부서/상태 + 검색/추가/수정/삭제), 결과 테이블(tblWorkers)
  *   - 근태 탭: 조건바(기간 From~To + 근로자 콤보 + 조회), 결과 테이블(tblAttendance)
  *
@@ -31,8 +42,9 @@ class QLabel;
  * - applyStyle(): 배경/폰트/버튼/테이블 룩앤필을 통일(다크/라이트 OS 테마 무시).
  *
  * 주의사항
- * - DB 접속 정보는 샘플 값이며, 실제 배포에서는 설정 파일/환경변수로 분리 권장.
- * - 대용량 환경에서는 employee(name/department/status), gate_check(emp_id, check_time) 인덱스 필요.
+ * - DB 접속 정보는 admin_client.ini [db] 섹션(없으면 샘플 기본값), 로컬 캐시는 [cache] 섹션(attendance_cache.h).
+ * - 대용량 환경에서는 employee(name/department/status) 인덱스 필요.
+ * - daily_attendance 테이블/트리거는 daily_attendance.sql, 기존 기록 백필은 출입/attendance_tools.py backfill.
  */
 class AttendancePage : public QWidget {
     Q_OBJECT
@@ -41,7 +53,7 @@ public:
      * @brief 페이지 위젯 생성자.
      * - buildUi()로 탭/검색바/테이블 등 UI 생성
      * - applyStyle()로 공통 테마 적용
-     * - openDb() 성공 시 콤보/테이블 초기 로딩
+     * - 콤보/테이블 초기 로딩을 비동기로 예약(DB 응답을 기다리지 않고 즉시 반환)
      */
     explicit AttendancePage(QWidget *parent = nullptr);
 
@@ -63,21 +75,24 @@ private:
     // ⬇ DB/로딩 헬퍼 — 각각의 “무엇을 하는지” 중심 설명
 
     /**
-     * @brief RDB 연결을 초기화하고 오픈.
-     * - QMYSQL 드라이버 사용(미설치 시 open 실패)
-     * - 단일 커넥션 이름을 사용해 재호출 시 재사용
-     * - 연결/읽기/쓰기 타임아웃을 짧게 설정해 지연 최소화
-     * @return true: 연결 성공, false: 실패(상위에서 사용자 알림)
+     * @brief 질의 실패 처리: 로그를 남기고, 첫 실패 때만 사용자에게 연결 실패를 안내.
      */
-    bool openDb();
+    void reportDbError(const QString& where, const QString& error);
 
     /**
      * @brief employee 테이블을 조건(이름/부서/상태)으로 조회하여
      *        “사원” 탭의 테이블(tblWorkers)을 채움.
-     * - LIKE/동등 조건을 바인딩으로 적용(SQL 인젝션 완화, 캐시 힌트)
-     * - COALESCE로 NULL 필드 표시 일관성 유지
+     * - 조건을 EmployeeModel에 넘기고 첫 페이지부터 다시 로딩(이후 페이지는 스크롤 시)
+     * - 검색 버튼/Enter: 항상 다시 조회
+     */
+    void loadEmployees() { searchEmployees(true); }
+
+    /**
+     * @brief 입력 중 검색(type-ahead). 조건이 실제로 바뀌었을 때만 다시 조회.
+     * - 이름 입력/부서·상태 변경은 searchDebounce_로 묶어서 마지막 입력 후 한 번만 호출
+     * - 앞선 질의가 아직 실행 중이면 모델 채널 교체로 취소(늦게 온 결과가 최신 결과를 덮지 않음)
      */
-    void loadEmployees();
+    void searchEmployees(bool force);
 
     /**
      * @brief “근태” 탭의 근로자 콤보(atWorker)를 DB에서 재구성.
@@ -87,18 +102,54 @@ private:
     void reloadWorkerCombo();
 
     /**
-     * @brief gate_check 테이블에서 기간/직원으로 필터링하여
-     *        일자별 출근/퇴근 시간과 총 근무시간을 집계하고 표(tblAttendance)에 표시.
-     * - 스키마에 ‘입/퇴근 구분’이 없는 가정: 같은 날짜의 MIN=출근, MAX=퇴근
-     * - DB에서 DATE/MIN/MAX/TIMEDIFF로 집계(클라이언트 연산 부담 감소)
+     * @brief daily_attendance 요약에서 기간/직원으로 필터링하여
+     *        일자별 출근/퇴근 시간과 총 근무시간을 표(tblAttendance)에 표시.
+     * - 스키마에 ‘입/퇴근 구분’이 없는 가정: 같은 날짜의 MIN=출근, MAX=퇴근(트리거가 증분 유지)
+     * - 원본 gate_check GROUP BY 없이 (day, emp_id) 요약 행만 읽음
+     * - AttendanceModel이 keyset 페이지 단위로 지연 로딩
      */
     void loadAttendance();
 
     /**
-     * @brief 직원 상태 코드를 한글 라벨로 변환(표시용 헬퍼).
-     * - 예) 1 → “재직”, 그 외 → “퇴사”(스키마 확장 시 이 매핑도 확장)
+     * @brief 근태 데이터를 CSV로 내보냄(파일 기록은 워커 스레드, 진행/취소 대화상자).
+     * - "일자별 집계": 마지막 조회 조건의 집계 전체를 페이지 없이 스트리밍(표에 로딩된 범위와 무관)
+     * - "원본 출입 기록": 같은 기간/근로자 조건의 gate_check 원본 행을 DB에서 한 행씩 스트리밍
+     *   (워커 전용 커넥션 + forward-only 커서 → 수십만 행도 메모리에 모으지 않음)
      */
-    QString statusToKorean(int s) const;
+    void exportAttendanceCsv();
+
+    /**
+     * @brief 사원 CSV 가져오기.
+     * - 파싱/검증은 워커 스레드(EmployeeIo::parseCsvAsync) → 결과 요약 확인 후 반영
+     * - 반영은 원격 MySQL 한 트랜잭션(200행 단위 다중 행 INSERT), 실패 행은 줄 번호와 사유로 보고
+     * - 끝나면 캐시 동기화 + 사원 목록/근로자 콤보 갱신
+     */
+    void importEmployeesCsv();
+
+    /// 사원 목록 전체를 가져오기와 같은 형식의 CSV로 스트리밍 내보내기
+    void exportEmployeesCsv();
+
+    /// 조회용 서비스: 로컬 캐시가 있으면 캐시, 없으면 원격 MySQL
+    DbService* readDb() const;
+
+    /**
+     * @brief 캐시 동기화 결과 반영.
+     * - 상태 라벨 갱신(마지막 동기화 시각/오프라인)
+     * - 바뀐 데이터가 있으면 표를 다시 읽음(사용자가 스크롤해 내려가 있으면 위치를 지키기 위해 건너뜀)
+     */
+    void onCacheSynced(bool ok, bool employeesChanged, int attendanceRows, const QString& error);
+
+    /**
+     * @brief “통계” 탭 계산 요청(기간 검증 후 AttendanceAnalytics::compute).
+     * - 같은 기간/기준을 다시 요청하면 캐시된 결과를 즉시 표시
+     */
+    void runAnalytics();
+
+    /// 통계 결과를 사원별/부서별 표에 채움(숫자 열은 숫자로 정렬되도록 값 자체를 넣음)
+    void showReport(const AttendanceReport& rep, bool cached);
+
+    /// 통계 표(사원별/부서별 선택)를 CSV로 내보냄(화면 스냅샷 → 워커 스레드 기록)
+    void exportAnalyticsCsv();
 
     // ===== 공통 UI 루트 =====
     QTabWidget *tabs{};  ///< 상단 탭 컨테이너([사원], [근태])
@@ -111,15 +162,33 @@ private:
     QPushButton *btnAdd{};      ///< 추가(신규 사원 등록; 실제 동작은 별도 구현)
     QPushButton *btnEdit{};     ///< 수정(선택 행 편집; 실제 동작은 별도 구현)
     QPushButton *btnRemove{};   ///< 삭제(선택 행 삭제; 실제 동작은 별도 구현)
-    QTableWidget *tblWorkers{}; ///< 결과 테이블(사번/이름/부서/직무/상태/연락처/비고)
+    QPushButton *btnImport{};   ///< CSV 가져오기(일괄 등록/갱신)
+    QPushButton *btnEmpExport{};///< CSV 내보내기(가져오기와 같은 형식)
+    QTableView  *tblWorkers{};  ///< 결과 테이블(사번/이름/부서/직무/상태/연락처/비고)
+    EmployeeModel *empModel_{}; ///< 사원 목록 모델(keyset: emp_id, 스크롤 시 추가 로딩)
+    QTimer      *searchDebounce_{}; ///< 입력 중 검색 지연(키 입력마다 질의하지 않도록)
 
     // ===== 탭2: 출석 기록(조건 바 + 결과 테이블) =====
     QLineEdit   *atFrom{};        ///< 조회 시작일(YYYY-MM-DD)
     QLineEdit   *atTo{};          ///< 조회 종료일(YYYY-MM-DD)
     QComboBox   *atWorker{};      ///< 특정 근로자 필터(미선택 시 전체)
     QPushButton *btnRefresh{};    ///< 조회(근태 데이터 로딩 트리거)
-    QTableWidget *tblAttendance{};///< 결과 테이블(일자/사번/이름/부서/출근/퇴근/근무시간)
+    QPushButton *btnExport{};     ///< CSV 내보내기(현재 표 / 원본 출입 기록 선택 메뉴)
+    QLabel      *cacheStatus{};   ///< 로컬 캐시 동기화 상태(마지막 동기화 시각/오프라인)
+    QTableView  *tblAttendance{}; ///< 결과 테이블(일자/사번/이름/부서/출근/퇴근/근무시간)
+    AttendanceModel *attModel_{}; ///< 근태 집계 모델(keyset: day DESC, emp_id ASC)
+
+    // ===== 탭3: 통계(기간 + 계산 + 사원별/부서별 표) =====
+    QLineEdit    *anFrom{};          ///< 통계 시작일(YYYY-MM-DD)
+    QLineEdit    *anTo{};            ///< 통계 종료일(YYYY-MM-DD)
+    QPushButton  *btnAnalyze{};      ///< 계산
+    QPushButton  *btnAnaExport{};    ///< CSV 내보내기(사원별/부서별)
+    QLabel       *anStatus{};        ///< 계산 상태(소요 시간/캐시 여부)
+    QTableWidget *tblWorkerStats{};  ///< 사원별 통계
+    QTableWidget *tblDeptStats{};    ///< 부서별 합계
+    AttendanceAnalytics *analytics_{}; ///< 병렬 집계 엔진(기간별 결과 캐시)
 
-    // ===== 데이터베이스 핸들 =====
-    QSqlDatabase db_; ///< RDB 연결 핸들(단일 커넥션 이름 재사용; 연결 실패 시 비유효)
+    // ===== DB 상태 =====
+    bool dbErrorShown_ = false; ///< 연결 실패 안내를 이미 띄웠는지(반복 대화상자 방지)
+    AttendanceCache *cache_{};  ///< 로컬 읽기 캐시(설정에서 끄면 nullptr → 원격 직접 조회)
 };
@@ -0,0 +1,52 @@
+#include "camera_list.h"
+#include <QSettings>
+
+namespace CameraList {
+
+QUrl streamUrl(const QString &key, const QString &base){
+    if(base.trimmed().isEmpty()) return QUrl();
+    QUrl u(base.trimmed());
+    if(u.path().isEmpty() || u.path() == "/")
+        u.setPath(key == "fire_url" ? "/video_feed" : "/mjpeg");
+    return u;
+}
+
+QStringList allKeys(const QString &iniPath){
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup("camera");
+    QStringList keys;
+    for(const QString &k : ini.childKeys())
+        if(k.endsWith("_url")) keys << k;
+    ini.endGroup();
+
+    keys.sort();
+    // 기존 두 카메라는 항상 앞자리(운영자에게 익숙한 배치 유지)
+    for(const char *fixed : {"fire_url", "entrance_url"}){
+        if(keys.removeAll(QString::fromLatin1(fixed)) > 0) keys.prepend(QString::fromLatin1(fixed));
+    }
+    return keys;
+}
+
+QList<CameraEntry> load(const QString &iniPath, const QStringList &keys){
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup("camera");
+    QList<CameraEntry> out;
+    for(QString key : keys){
+        key = key.trimmed();
+        if(key.isEmpty()) continue;
+        CameraEntry c;
+        c.key = key;
+        c.url = streamUrl(key, ini.value(key).toString());
+        c.title = ini.value(c.stem() + "_name").toString().trimmed();
+        if(c.title.isEmpty()){
+            if(key == "entrance_url")  c.title = QString::fromUtf8("출입 카메라");
+            else if(key == "fire_url") c.title = QString::fromUtf8("화재 감지 카메라");
+            else                       c.title = c.stem();
+        }
+        out << c;
+    }
+    ini.endGroup();
+    return out;
+}
+
+} // namespace CameraList
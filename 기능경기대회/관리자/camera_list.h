@@ -0,0 +1,44 @@
+#pragma once
+/**
+ * @file camera_list.h
+ * @brief admin_client.ini [camera] 목록 → 표시 이름/스트림 URL.
+ *
+ * 배경
+ *  - 카메라 URL 보정(/mjpeg, 화재 카메라는 /video_feed)이 모니터링 타일과 녹화기에 각각 있었고,
+ *    카메라를 하나 늘리려면 모니터링 페이지에 타일을 손으로 추가해야 했다.
+ *
+ * 설정(admin_client.ini [camera])
+ *  - <이름>_url  : 카메라 베이스 URL(예: zone1_url=http://192.168.0.21:8000)
+ *                  경로가 없으면 fire_url은 /video_feed, 나머지는 /mjpeg를 붙임
+ *  - <이름>_name : 표시 이름(선택, 없으면 entrance/fire는 기본 한글 이름, 그 외는 <이름>)
+ *
+ * 같은 URL은 StreamHub가 연결 하나로 공유하므로, 여기서 만든 URL을 그대로 쓰는 곳끼리는
+ * (모니터링 타일, 확대 보기, 녹화) 카메라당 연결이 하나다.
+ */
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+struct CameraEntry {
+    QString key;          ///< [camera] 키(예: fire_url)
+    QString title;        ///< 표시 이름
+    QUrl url;             ///< 스트림 URL(경로 보정 후, 설정이 비어 있으면 invalid)
+
+    /// 파일 이름 등에 쓸 짧은 이름(fire_url → fire)
+    QString stem() const { return key.endsWith("_url") ? key.chopped(4) : key; }
+};
+
+namespace CameraList {
+
+/// [camera] 키 + 베이스 URL → 스트림 URL(경로가 있으면 그대로)
+QUrl streamUrl(const QString &key, const QString &base);
+
+/// [camera]의 모든 *_url 키(entrance_url, fire_url 먼저, 나머지는 이름순)
+QStringList allKeys(const QString &iniPath);
+
+/// keys 순서대로 항목 생성(URL이 비어 있는 키도 포함 — 호출자가 판단)
+QList<CameraEntry> load(const QString &iniPath, const QStringList &keys);
+
+} // namespace CameraList
@@ -52,12 +52,23 @@ void CameraViewerPage::buildUi() {
     statusLabel = new QLabel(u8"스트림 준비됨");
     statusLabel->setObjectName("status");
 
-    // 상단 바 배치: [뒤로] [타이틀] ———— [상태]
+    // [통계] : 영상 위 상세 통계 오버레이 토글
+    btnStats = new QPushButton(u8"통계");
+    btnStats->setObjectName("backBtn");   // 뒤로 버튼과 같은 보조 버튼 스타일
+    btnStats->setCheckable(true);
+    btnStats->setFixedHeight(36);
+    connect(btnStats, &QPushButton::toggled, this, [this](bool on){
+        if (viewer_) viewer_->setStatsOverlay(on);
+    });
+
+    // 상단 바 배치: [뒤로] [타이틀] ———— [상태] [통계]
     top->addWidget(btnBack, 0, Qt::AlignLeft);
     top->addSpacing(8);
     top->addWidget(titleLabel, 0, Qt::AlignLeft);
     top->addStretch();
     top->addWidget(statusLabel, 0, Qt::AlignRight);
+    top->addSpacing(8);
+    top->addWidget(btnStats, 0, Qt::AlignRight);
     root->addLayout(top);
 
     // ── 비디오 카드: 실제 영상이 들어가는 컨테이너 ──────────────────
@@ -102,6 +113,7 @@ void CameraViewerPage::applyStyle() {
             color:#111827; font-weight:700;                               /* 네비게이션 액션 */
         }
         #backBtn:hover { background:#eef3ff; }
+        #backBtn:checked { background:#dbe3ff; }
         #videoCard {
             background:#ffffff;                                           /* 흰색 카드 */
             border:1px solid #dbe3ff;
@@ -125,6 +137,7 @@ void CameraViewerPage::loadCamera(const QString& name, const QString& url)
     // 타이틀에 카메라 이름 반영, 즉시 상태는 "연결 중…"으로 갱신
     titleLabel->setText(u8"카메라 보기 — " + name);
     statusLabel->setText(u8"연결 중…");
+    statusLabel->setToolTip(QString());
     currentUrl_ = url;   // 예: http://172.30.1.33:8000 또는 http://.../mjpeg
 
     // URL 미지정: 사용자에게 즉시 피드백 후 중단
@@ -166,6 +179,23 @@ void CameraViewerPage::loadCamera(const QString& name, const QString& url)
     // MjpegView는 QUrl을 기반으로 프레임을 받아 videoBox 위에 그린다.
     viewer_ = new MjpegView(videoBox);
     viewer_->setUrl(mjpeg);  // 보정된 /mjpeg 엔드포인트
+    viewer_->setStatsOverlay(btnStats->isChecked());
+    // 1초마다: 상태 텍스트는 요약(fps/비트레이트/지연 p95), 툴팁은 전체 지표
+    connect(viewer_, &MjpegView::statsUpdated, this, [this](const StreamStats& st) {
+        if (!st.live) return;   // 숨김(다른 페이지) 동안은 마지막 문구 유지
+        if (st.health != ReconnectPolicy::Health::Live) {
+            statusLabel->setText(ReconnectPolicy::healthText(st.health) + u8" · 재연결 " + QString::number(st.reconnects));
+            statusLabel->setToolTip(st.summary());
+            return;
+        }
+        const LatencyStats lat = viewer_->latency();
+        QString text = QString::fromUtf8("스트림 재생 중 · %1 fps · %2")
+                           .arg(st.decodeFps, 0, 'f', 1).arg(st.bitrateText());
+        if (lat.samples > 0)
+            text += QString::fromUtf8(" · 지연 p95 %1 ms").arg(lat.p95, 0, 'f', 0);
+        statusLabel->setText(text);
+        statusLabel->setToolTip(st.summary() + "\n" + lat.summary());
+    });
     viewer_->start();        // 네트워크 연결 및 수신 시작
     videoBox->layout()->addWidget(viewer_); // 렌더 타겟 트리에 부착
 
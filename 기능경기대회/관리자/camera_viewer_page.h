@@ -12,7 +12,9 @@ class MjpegView;
  *
  * 역할/기능
  * - 모니터링 화면에서 특정 카메라를 선택했을 때, 단독으로 크게 재생하는 뷰.
- * - 상단 바: [← 뒤로] + "카메라 보기 — {이름}" + 재생 상태 텍스트.
+ * - 상단 바: [← 뒤로] + "카메라 보기 — {이름}" + 재생 상태 텍스트 + [통계] 토글.
+ *   · 재생 중 상태 텍스트는 1초마다 스트림 통계(fps/비트레이트)로 갱신, 툴팁에 전체 지표.
+ *   · [통계]를 켜면 영상 좌상단에 상세 통계 오버레이.
  * - 본문: 검정 배경의 videoBox 안에 MJPEG 전용 뷰어(MjpegView) 삽입/교체.
  *
  * 데이터 흐름
@@ -83,6 +85,7 @@ private:
     QLabel*      titleLabel{};   ///< "카메라 보기 — {name}" 형태로 동적 갱신되는 제목
     QLabel*      statusLabel{};  ///< "연결 중…/재생 중/URL 없음" 등 스트림 상태 표시
     QPushButton* btnBack{};      ///< 뒤로가기 버튼(클릭 시 backRequested() 방출)
+    QPushButton* btnStats{};     ///< 통계 오버레이 토글(체크 상태는 카메라를 바꿔도 유지)
 
     // ── 비디오 영역 ───────────────────────────────────────────────
     QWidget*     videoBox{};     ///< 실제 스트림 위젯(MjpegView) 삽입 대상 컨테이너(검정 배경)
@@ -0,0 +1,314 @@
+#include "clip_recorder.h"
+#include "stream_hub.h"
+#include "camera_list.h"
+#include <QCoreApplication>
+#include <QSettings>        // [record]/[camera] 섹션 읽기
+#include <QDir>
+#include <QDateTime>
+#include <QtEndian>         // AVI(RIFF)는 리틀 엔디언
+#include <QtConcurrent>     // I/O 스레드에서 파일 쓰기
+#include <QThreadPool>
+#include <QImageReader>     // JPEG 헤더만 읽어 프레임 크기 확인
+#include <QBuffer>
+#include <QRegularExpression>
+
+namespace {
+
+constexpr quint32 kAvifHasIndex   = 0x10;   // avih.dwFlags: idx1 있음
+constexpr quint32 kAviifKeyframe  = 0x10;   // idx1 항목: 키프레임(MJPEG은 모든 프레임)
+constexpr quint32 kDefaultUsPerFrame = 66666; // 실측 불가(프레임 1장)일 때 15fps로 기록
+
+// 파일 쓰기 전용 스레드 1개: 작업이 들어온 순서대로 실행되므로 open → write … → close 순서가 보장됨
+QThreadPool *ioPool(){
+    static QThreadPool *pool = []{
+        auto *p = new QThreadPool;
+        p->setMaxThreadCount(1);
+        p->setExpiryTimeout(-1);
+        return p;
+    }();
+    return pool;
+}
+
+void put32(QByteArray &b, quint32 v){
+    char d[4];
+    qToLittleEndian(v, d);
+    b.append(d, 4);
+}
+void put16(QByteArray &b, quint16 v){
+    char d[2];
+    qToLittleEndian(v, d);
+    b.append(d, 2);
+}
+void putFcc(QByteArray &b, const char *fcc){ b.append(fcc, 4); }
+
+QSize jpegSize(const FrameSlice &jpg){
+    QBuffer dev;
+    dev.setData(jpg.bytes());
+    dev.open(QIODevice::ReadOnly);
+    return QImageReader(&dev, "jpeg").size();   // 헤더(SOF)만 읽음
+}
+
+} // namespace
+
+// ===================== MjpegAviWriter =====================
+
+/*
+ * 파일 구조(AVI 1.0):
+ *   RIFF 'AVI ' { LIST 'hdrl' { avih, LIST 'strl' { strh, strf } }, LIST 'movi' { '00dc'… }, idx1 }
+ * 헤더는 고정 길이라 open()에서 자리만 쓰고 close()에서 같은 길이로 덮어쓴다.
+ */
+QByteArray MjpegAviWriter::header(quint32 riffSize, quint32 moviSize, quint32 usPerFrame) const{
+    const quint32 w = quint32(m_size.width()), h = quint32(m_size.height());
+    const quint32 frames = quint32(m_index.size());
+    const quint32 rate = usPerFrame ? (1000000u + usPerFrame / 2) / usPerFrame : 15;
+
+    QByteArray b;
+    putFcc(b, "RIFF"); put32(b, riffSize); putFcc(b, "AVI ");
+    putFcc(b, "LIST"); put32(b, 4 + (8 + 56) + (8 + 4 + (8 + 56) + (8 + 40))); putFcc(b, "hdrl");
+
+    putFcc(b, "avih"); put32(b, 56);
+    put32(b, usPerFrame);
+    put32(b, m_maxChunk * rate);               // dwMaxBytesPerSec(추정)
+    put32(b, 0);                               // dwPaddingGranularity
+    put32(b, kAvifHasIndex);
+    put32(b, frames);
+    put32(b, 0);                               // dwInitialFrames
+    put32(b, 1);                               // dwStreams
+    put32(b, m_maxChunk);                      // dwSuggestedBufferSize
+    put32(b, w); put32(b, h);
+    for(int i = 0; i < 4; ++i) put32(b, 0);    // dwReserved
+
+    putFcc(b, "LIST"); put32(b, 4 + (8 + 56) + (8 + 40)); putFcc(b, "strl");
+    putFcc(b, "strh"); put32(b, 56);
+    putFcc(b, "vids"); putFcc(b, "MJPG");
+    put32(b, 0);                               // dwFlags
+    put16(b, 0); put16(b, 0);                  // wPriority, wLanguage
+    put32(b, 0);                               // dwInitialFrames
+    put32(b, 1); put32(b, rate);               // dwScale, dwRate → rate fps
+    put32(b, 0);                               // dwStart
+    put32(b, frames);                          // dwLength
+    put32(b, m_maxChunk);
+    put32(b, 0xFFFFFFFFu);                     // dwQuality(기본)
+    put32(b, 0);                               // dwSampleSize(가변)
+    put16(b, 0); put16(b, 0); put16(b, quint16(w)); put16(b, quint16(h));   // rcFrame
+
+    putFcc(b, "strf"); put32(b, 40);           // BITMAPINFOHEADER
+    put32(b, 40); put32(b, w); put32(b, h);
+    put16(b, 1); put16(b, 24);
+    putFcc(b, "MJPG");
+    put32(b, w * h * 3);
+    for(int i = 0; i < 4; ++i) put32(b, 0);
+
+    putFcc(b, "LIST"); put32(b, moviSize); putFcc(b, "movi");
+    return b;
+}
+
+bool MjpegAviWriter::open(const QString &path, const QSize &frameSize){
+    m_size = frameSize;
+    m_failed = false;
+    m_index.clear();
+    m_maxChunk = 0;
+    m_firstMs = m_lastMs = 0;
+    m_file.setFileName(path);
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    const QByteArray h = header(0, 4, kDefaultUsPerFrame);
+    m_moviPos = h.size() - 4;
+    m_failed = m_file.write(h) != h.size();
+    m_end = m_file.pos();
+    return !m_failed;
+}
+
+bool MjpegAviWriter::write(const FrameSlice &jpeg, qint64 ms){
+    if(!m_file.isOpen() || m_failed) return false;
+    if(jpeg.isEmpty()) return true;            // 빈 파트: 건너뜀(실패 아님)
+    const qint64 pos = m_file.pos();
+    QByteArray chunkHead;
+    putFcc(chunkHead, "00dc");
+    put32(chunkHead, quint32(jpeg.size()));
+    if(m_file.write(chunkHead) != 8 || m_file.write(jpeg.data(), jpeg.size()) != jpeg.size()
+       || ((jpeg.size() & 1) && !m_file.putChar('\0'))) {   // RIFF 청크는 짝수 길이로 정렬
+        // 잘린 청크는 색인에 넣지 않음 → 닫을 때 앞의 완전한 프레임까지만 재생됨
+        m_failed = true;
+        return false;
+    }
+
+    m_index.append(IndexEntry{quint32(pos - m_moviPos), quint32(jpeg.size())});
+    m_maxChunk = qMax(m_maxChunk, quint32(jpeg.size()));
+    m_end = m_file.pos();
+    if(m_index.size() == 1) m_firstMs = ms;
+    m_lastMs = ms;
+    return true;
+}
+
+void MjpegAviWriter::close(){
+    if(!m_file.isOpen()) return;
+    const qint64 moviEnd = m_end;              // 실패했으면 마지막 완전한 청크 끝(잘린 청크는 버림)
+    m_file.seek(moviEnd);
+
+    QByteArray idx;
+    putFcc(idx, "idx1");
+    put32(idx, quint32(m_index.size() * 16));
+    for(const IndexEntry &e : std::as_const(m_index)){
+        putFcc(idx, "00dc");
+        put32(idx, kAviifKeyframe);
+        put32(idx, e.offset);
+        put32(idx, e.size);
+    }
+    m_file.write(idx);
+    if(m_failed) m_file.resize(m_file.pos());  // 잘린 청크의 남은 바이트 제거(가능한 만큼)
+
+    // 재생 속도 = 실측 평균 간격(수신 fps가 서버 설정과 달라도 실제 시간과 맞게 재생)
+    const int n = m_index.size();
+    const quint32 usPerFrame = (n > 1 && m_lastMs > m_firstMs)
+        ? quint32((m_lastMs - m_firstMs) * 1000 / (n - 1)) : kDefaultUsPerFrame;
+    const qint64 end = m_file.pos();
+    m_file.seek(0);
+    m_file.write(header(quint32(end - 8), quint32(moviEnd - m_moviPos), usPerFrame));
+    m_file.close();
+}
+
+// ===================== ClipRecorder =====================
+
+ClipRecorder::ClipRecorder(QObject *parent)
+    : QObject(parent)
+{
+    m_postTimer.setSingleShot(true);
+    connect(&m_postTimer, &QTimer::timeout, this, &ClipRecorder::stopAll);
+
+    QSettings ini(QCoreApplication::applicationDirPath() + "/admin_client.ini", QSettings::IniFormat);
+    ini.beginGroup("record");
+    m_enabled   = ini.value("enabled", true).toBool();
+    m_preMs     = qMax(0, int(ini.value("pre_sec", 10).toDouble() * 1000));
+    m_postMs    = qMax(1000, int(ini.value("post_sec", 30).toDouble() * 1000));
+    m_segmentMs = qMax(5000, int(ini.value("segment_sec", 60).toDouble() * 1000));
+    const QStringList keys = ini.value("cameras", "fire_url").toString().split(',', Qt::SkipEmptyParts);
+    m_dir = ini.value("dir", "clips").toString();
+    ini.endGroup();
+    if(QDir::isRelativePath(m_dir))
+        m_dir = QCoreApplication::applicationDirPath() + "/" + m_dir;
+    if(!m_enabled) return;
+
+    // 녹화 탭 구독: 디코드 없이 스트림 유지 + 링 버퍼(같은 URL을 보는 타일과 연결 공유)
+    QStringList seen;
+    for(const CameraEntry &cam : CameraList::load(ini.fileName(), keys)){
+        if(!cam.url.isValid()) continue;
+        if(seen.contains(StreamHub::keyOf(cam.url))) continue;
+        seen << StreamHub::keyOf(cam.url);
+
+        auto c = std::make_unique<Camera>();
+        c->name = cam.stem();
+        c->url = cam.url;
+        c->src = StreamHub::instance()->acquire(cam.url, this, QSize(), true, /*decode=*/false);
+        c->src->setPreRoll(m_preMs);
+        m_cams.push_back(std::move(c));
+    }
+}
+
+ClipRecorder::~ClipRecorder(){
+    stopAll();
+    ioPool()->waitForDone(3000);               // 종료 직전 녹화도 색인까지 써서 재생 가능하게
+    for(auto &c : m_cams){
+        if(!c->src) continue;
+        c->src->setPreRoll(0);
+        StreamHub::instance()->release(c->src, this);
+    }
+}
+
+void ClipRecorder::trigger(const QString &incident){
+    if(!m_enabled || m_cams.empty()) return;
+    const bool wasRecording = isRecording();
+    m_postTimer.start(m_postMs);               // 녹화 중이면 종료 시각 연장
+    if(wasRecording) return;
+
+    static const QRegularExpression reUnsafe(QStringLiteral("[^A-Za-z0-9_-]"));
+    m_incident = QString(incident).replace(reUnsafe, QStringLiteral("_")).left(40);
+    m_stamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+    QDir().mkpath(m_dir);
+    for(auto &c : m_cams) startCamera(*c);
+}
+
+/*
+ * 링 버퍼(사건 이전 구간)를 먼저 쓰고, 이후 도착 파트를 이어서 쓴다.
+ * 둘 다 UI 스레드에서 순서대로 I/O 풀에 넣으므로 파일 안의 프레임 순서는 수신 순서와 같다.
+ */
+void ClipRecorder::startCamera(Camera &c){
+    if(!c.src) return;
+    c.segment = 0;
+    c.failed = false;
+    c.sizeConn = ~quint64(0);
+    for(const StreamPart &p : c.src->preRoll()) onPart(c, p.jpeg, p.ms);
+    c.conn = connect(c.src, &StreamSource::partReceived, this, [this, cam = &c](const FrameSlice &jpg, qint64 ms){
+        onPart(*cam, jpg, ms);
+    });
+}
+
+/*
+ * 헤더 파싱(QImageReader)은 UI 스레드 비용이 있으므로 크기를 모를 때/소스가 다시 연결했을 때만.
+ * 한 연결 안에서는 서버가 같은 크기로 보내고, 녹화 탭은 원본 크기를 요청하므로(stream_hub.h) 충분하다.
+ * 재협상으로 폭이 바뀌면 소스가 링을 비우므로 사전 구간(preRoll)도 현재 연결과 같은 크기다.
+ */
+void ClipRecorder::onPart(Camera &c, const FrameSlice &jpg, qint64 ms){
+    if(c.failed) return;
+    QSize size = c.size;
+    const quint64 conn = c.src ? c.src->connection() : 0;
+    if(!c.writer || conn != c.sizeConn){
+        size = jpegSize(jpg);
+        if(!size.isValid()) return;            // 손상 파트: 건너뜀(다음 파트에서 다시 확인)
+        c.sizeConn = conn;
+    }
+    // 분할 주기 도달 또는 해상도 변경(AVI는 스트림당 크기가 하나) → 새 파일
+    if(!c.writer || size != c.size || ms - c.segStartMs >= m_segmentMs){
+        closeSegment(c);
+        openSegment(c, size, ms);
+    }
+    std::shared_ptr<MjpegAviWriter> w = c.writer;
+    watchIo(c, w, QtConcurrent::run(ioPool(), [w, jpg, ms]{ return w->write(jpg, ms); }));
+}
+
+void ClipRecorder::watchIo(Camera &c, const std::shared_ptr<MjpegAviWriter> &w, QFuture<bool> f){
+    f.then(this, [this, cam = &c, w](bool ok){
+        if(ok || cam->failed) return;          // 같은 녹화에서 이미 멈춤(뒤따르는 실패는 한 번만 알림)
+        const QString error = w->errorString();
+        qWarning("ClipRecorder: write failed %s: %s", qPrintable(w->path()), qPrintable(error));
+        cam->failed = true;
+        stopCamera(*cam);                      // 쓴 데까지 색인/헤더를 채워 닫음
+        emit clipFailed(w->path(), error);
+    });
+}
+
+void ClipRecorder::openSegment(Camera &c, const QSize &size, qint64 ms){
+    QString name = QString("fire_%1_%2").arg(m_stamp, c.name);
+    if(!m_incident.isEmpty()) name += "_" + m_incident;
+    name += QString("_%1.avi").arg(++c.segment, 2, 10, QChar('0'));
+
+    c.writer = std::make_shared<MjpegAviWriter>();
+    c.size = size;
+    c.segStartMs = ms;
+    std::shared_ptr<MjpegAviWriter> w = c.writer;
+    watchIo(c, w, QtConcurrent::run(ioPool(), [w, path = m_dir + "/" + name, size]{
+        return w->open(path, size);
+    }));
+}
+
+void ClipRecorder::closeSegment(Camera &c){
+    if(!c.writer) return;
+    std::shared_ptr<MjpegAviWriter> w = std::move(c.writer);
+    QtConcurrent::run(ioPool(), [w]{
+        const bool opened = w->isOpen();
+        w->close();
+        return opened ? w->frames() : -1;
+    }).then(this, [this, w](int frames){
+        if(frames > 0) emit clipSaved(w->path(), frames);
+    });
+}
+
+void ClipRecorder::stopCamera(Camera &c){
+    disconnect(c.conn);
+    c.conn = {};
+    closeSegment(c);
+}
+
+void ClipRecorder::stopAll(){
+    m_postTimer.stop();
+    for(auto &c : m_cams) stopCamera(*c);
+}
@@ -0,0 +1,134 @@
+#pragma once
+/**
+ * @file clip_recorder.h
+ * @brief 화재 사건 증거 영상 녹화(사건 이전 구간 포함, 재인코딩 없음).
+ *
+ * 배경
+ *  - 증거 영상은 로봇 클라이언트(XVID VideoWriter)만 남겼고, 로봇이 출동하기 전의
+ *    결정적인 몇 초는 어디에도 남지 않았다.
+ *
+ * 구성
+ *  - MjpegAviWriter: 받은 JPEG을 그대로 '00dc' 청크로 쌓는 MJPEG AVI(RIFF) 작성기.
+ *    디코드/재인코딩이 없으므로 CPU는 거의 쓰지 않는다. 닫을 때 idx1 색인과 헤더(프레임 수,
+ *    실측 fps)를 채운다.
+ *  - ClipRecorder: 설정된 카메라마다 StreamHub 소스를 "녹화 탭"(디코드 없음)으로 구독해
+ *    스트림을 유지하고 최근 pre_sec 구간을 링 버퍼에 둔다.
+ *    · trigger(): 링 버퍼(사건 이전) + 이후 수신 파트를 파일로, 마지막 trigger 뒤 post_sec까지
+ *    · segment_sec마다 파일을 나눔(_01, _02 …), 해상도가 바뀌어도 새 파일
+ *    · 파일 쓰기는 전용 I/O 스레드 1개에서 순서대로(UI 스레드는 디스크를 기다리지 않음)
+ *    · 프레임 크기는 분할 첫 파트와 재연결 직후 파트에서만 JPEG 헤더로 확인(연결 중에는 바뀌지 않음)
+ *    · 쓰기 실패(디스크 가득 참 등)면 그 카메라의 녹화를 멈추고 쓴 데까지 닫은 뒤 clipFailed
+ *
+ * 설정(admin_client.ini [record])
+ *  - enabled     : true/false(기본 true)
+ *  - cameras     : 녹화할 [camera] 키 목록(쉼표 구분, 기본 fire_url)
+ *  - pre_sec     : 사건 이전 보관 구간(기본 10)
+ *  - post_sec    : 마지막 사건 이후 녹화 구간(기본 30)
+ *  - segment_sec : 파일 분할 길이(기본 60)
+ *  - dir         : 저장 폴더(상대 경로면 실행 파일 기준, 기본 clips)
+ */
+
+#include <QObject>
+#include <QFile>
+#include <QFuture>
+#include <QPointer>
+#include <QSize>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+class StreamSource;
+class FrameSlice;
+
+class MjpegAviWriter {
+public:
+    /// 파일 생성 + 헤더 자리 확보(크기/프레임 수는 close()에서 채움)
+    bool open(const QString &path, const QSize &frameSize);
+    /// JPEG 한 장을 그대로 추가(ms = 수신 시각, fps 실측용)
+    bool write(const FrameSlice &jpeg, qint64 ms);
+    /// 색인(idx1) 기록 + 헤더 갱신 후 닫기
+    void close();
+    /// 마지막 실패 사유(open/write가 false일 때)
+    QString errorString() const { return m_file.errorString(); }
+
+    bool isOpen() const { return m_file.isOpen(); }
+    QString path() const { return m_file.fileName(); }
+    QSize frameSize() const { return m_size; }
+    int frames() const { return m_index.size(); }
+
+private:
+    struct IndexEntry {
+        quint32 offset;           ///< 'movi' FourCC 기준 청크 위치
+        quint32 size;
+    };
+    QByteArray header(quint32 riffSize, quint32 moviSize, quint32 usPerFrame) const;
+
+    QFile m_file;
+    QSize m_size;
+    QVector<IndexEntry> m_index;
+    qint64 m_moviPos = 0;         ///< 'movi' FourCC 파일 위치
+    quint32 m_maxChunk = 0;
+    qint64 m_firstMs = 0, m_lastMs = 0;
+    qint64 m_end = 0;             ///< 마지막 완전한 청크 끝(파일 위치)
+    bool m_failed = false;        ///< 쓰기 실패 이후(남은 write는 바로 false — 잘린 청크 뒤에 이어 쓰지 않음)
+};
+
+class ClipRecorder : public QObject {
+    Q_OBJECT
+public:
+    /// admin_client.ini [record]/[camera]를 읽어 녹화 탭 구독 시작(enabled=false면 아무것도 안 함)
+    explicit ClipRecorder(QObject *parent = nullptr);
+    ~ClipRecorder() override;
+
+    bool isEnabled() const { return m_enabled; }
+    bool isRecording() const { return m_postTimer.isActive(); }
+
+    /**
+     * @brief 사건 발생: 녹화 시작 또는 연장
+     *  - 녹화 중이 아니면 카메라마다 링 버퍼(사건 이전 구간)부터 새 파일에 기록
+     *  - 녹화 중이면 종료 시각만 post_sec 뒤로 연장
+     * @param incident 사건 ID(파일 이름에 포함, 비어 있으면 생략)
+     */
+    void trigger(const QString &incident);
+
+signals:
+    /// 파일 하나를 닫았음(분할마다 1회)
+    void clipSaved(const QString &path, int frames);
+    /// 파일을 열거나 쓰지 못해 그 카메라의 녹화를 멈춤(쓴 데까지는 닫아 clipSaved로도 알림)
+    void clipFailed(const QString &path, const QString &error);
+
+private:
+    struct Camera {
+        QString name;                     ///< 파일 이름용(예: fire_url → fire)
+        QUrl url;
+        QPointer<StreamSource> src;
+        std::shared_ptr<MjpegAviWriter> writer;   ///< I/O 스레드와 공유(작업 순서는 풀이 보장)
+        QSize size;                       ///< 현재 파일의 프레임 크기
+        quint64 sizeConn = ~quint64(0);   ///< size를 확인한 소스 연결 세대(StreamSource::connection)
+        bool failed = false;              ///< 이번 녹화에서 쓰기 실패 → 다음 trigger까지 멈춤
+        qint64 segStartMs = 0;
+        int segment = 0;
+        QMetaObject::Connection conn;
+    };
+
+    void startCamera(Camera &c);
+    void onPart(Camera &c, const FrameSlice &jpg, qint64 ms);
+    void openSegment(Camera &c, const QSize &size, qint64 ms);
+    void closeSegment(Camera &c);
+    void stopCamera(Camera &c);
+    /// I/O 스레드 작업 결과가 실패면 그 카메라 녹화를 멈추고 clipFailed(같은 파일이면 1회만)
+    void watchIo(Camera &c, const std::shared_ptr<MjpegAviWriter> &w, QFuture<bool> f);
+    void stopAll();
+
+    bool m_enabled = true;
+    int m_preMs = 10000;
+    int m_postMs = 30000;
+    int m_segmentMs = 60000;
+    QString m_dir;
+    QString m_incident;                   ///< 현재 녹화의 사건 ID(파일 이름용)
+    QString m_stamp;                      ///< 현재 녹화 시작 시각(yyyyMMdd_HHmmss)
+    QTimer m_postTimer;                   ///< 마지막 trigger 뒤 post_sec에 녹화 종료
+    std::vector<std::unique_ptr<Camera>> m_cams;
+};
@@ -0,0 +1,217 @@
+#include "csv_export.h"
+#include <QAbstractItemModel>   // 스냅샷 대상 모델
+#include <QSaveFile>            // 원자적 저장(성공 시에만 교체)
+#include <QTextStream>          // UTF-8 텍스트 기록
+#include <QElapsedTimer>        // 진행률 방출 간격 제한
+#include <QtConcurrent>         // 워커 스레드 실행(QtConcurrent::run)
+#include <QSqlDatabase>         // DB 스트리밍용 워커 전용 커넥션
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QThread>
+#include <QProgressDialog>      // 진행 대화상자(취소 버튼)
+#include <QMessageBox>
+#include <QPointer>
+#include <QUuid>
+#include <limits>
+
+namespace {
+constexpr int kProgressEveryMs = 100;  // 진행률 신호 최소 간격(신호 폭주 방지)
+}
+
+CsvExportJob::CsvExportJob(const QStringList& header, RowSource source, qint64 expected,
+                           const QString& path, QObject* parent)
+    : QObject(parent), header_(header), source_(std::move(source)), expected_(expected), path_(path)
+{
+}
+
+CsvExportJob::~CsvExportJob()
+{
+    cancel_.store(true);
+    future_.waitForFinished();
+}
+
+QString CsvExportJob::escape(const QString& s)
+{
+    QString t = s;
+    t.replace('"', "\"\"");
+    return QString("\"%1\"").arg(t);
+}
+
+CsvExportJob* CsvExportJob::fromModel(const QAbstractItemModel* model, const QString& path, QObject* parent)
+{
+    // GUI 스레드에서 값만 복사(QString은 암시적 공유 → 실제 문자열 복사 없음)
+    QStringList header;
+    auto rows = std::make_shared<QVector<QStringList>>();
+    if (model) {
+        const int cols = model->columnCount();
+        const int n    = model->rowCount();
+        for (int c = 0; c < cols; ++c)
+            header << model->headerData(c, Qt::Horizontal, Qt::DisplayRole).toString();
+        rows->reserve(n);
+        for (int r = 0; r < n; ++r) {
+            QStringList row;
+            row.reserve(cols);
+            for (int c = 0; c < cols; ++c)
+                row << model->data(model->index(r, c), Qt::DisplayRole).toString();
+            rows->append(row);
+        }
+    }
+
+    RowSource src = [rows](const RowSink& sink, QString*) {
+        for (const QStringList& row : *rows)
+            if (!sink(row)) return true;   // 취소: 오류 아님
+        return true;
+    };
+    return new CsvExportJob(header, src, rows->size(), path, parent);
+}
+
+CsvExportJob* CsvExportJob::fromSql(const QString& connectionName, const QString& sql,
+                                    const QVariantMap& binds, const QStringList& header,
+                                    const QString& path, QObject* parent)
+{
+    RowSource src = [connectionName, sql, binds](const RowSink& sink, QString* err) {
+        // 커넥션은 만든 스레드에서만 사용 가능 → 워커 전용 이름으로 복제해 연다
+        const QString name = QStringLiteral("csv_export_%1")
+                                 .arg(QUuid::createUuid().toString(QUuid::Id128));
+        bool ok = true;
+        {
+            QSqlDatabase db = QSqlDatabase::cloneDatabase(connectionName, name);
+            if (!db.open()) {
+                if (err) *err = db.lastError().text();
+                ok = false;
+            } else {
+                QSqlQuery q(db);
+                q.setForwardOnly(true);    // 결과를 클라이언트에 통째로 올리지 않고 한 행씩 소비
+                q.prepare(sql);
+                for (auto it = binds.cbegin(); it != binds.cend(); ++it)
+                    q.bindValue(it.key(), it.value());
+                if (!q.exec()) {
+                    if (err) *err = q.lastError().text();
+                    ok = false;
+                } else {
+                    const int cols = q.record().count();
+                    QStringList row;
+                    while (q.next()) {
+                        row.clear();
+                        for (int c = 0; c < cols; ++c) row << q.value(c).toString();
+                        if (!sink(row)) break;   // 취소
+                    }
+                }
+            }
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(name);
+        return ok;
+    };
+    return new CsvExportJob(header, src, -1, path, parent);
+}
+
+CsvExportJob* CsvExportJob::fromSource(const QStringList& header, RowSource source, qint64 expectedRows,
+                                       const QString& path, QObject* parent)
+{
+    return new CsvExportJob(header, std::move(source), expectedRows, path, parent);
+}
+
+void CsvExportJob::start()
+{
+    if (future_.isRunning()) return;
+    cancel_.store(false);
+    future_ = QtConcurrent::run([this]{ run(); });
+}
+
+void CsvExportJob::run()
+{
+    QSaveFile f(path_);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit finished(false, f.errorString());
+        return;
+    }
+
+    // UTF-8 BOM (엑셀 호환)
+    static const unsigned char bom[3] = {0xEF,0xBB,0xBF};
+    f.write(reinterpret_cast<const char*>(bom), 3);
+
+    QTextStream out(&f);
+    auto writeRow = [&out](const QStringList& row) {
+        for (int i = 0; i < row.size(); ++i) {
+            if (i) out << ',';
+            out << escape(row.at(i));
+        }
+        out << '\n';
+    };
+
+    if (!header_.isEmpty()) writeRow(header_);
+
+    qint64 done = 0;
+    QElapsedTimer tick; tick.start();
+    emit progress(0, expected_);
+
+    const RowSink sink = [&](const QStringList& row) {
+        if (cancel_.load()) return false;
+        writeRow(row);
+        ++done;
+        if (tick.elapsed() >= kProgressEveryMs) {
+            tick.restart();
+            emit progress(done, expected_);
+        }
+        return true;
+    };
+
+    QString err;
+    const bool ok = source_ ? source_(sink, &err) : true;
+    out.flush();
+
+    if (cancel_.load()) {
+        f.cancelWriting();
+        emit finished(false, QStringLiteral("canceled"));
+        return;
+    }
+    if (!ok) {
+        f.cancelWriting();
+        emit finished(false, err);
+        return;
+    }
+    if (!f.commit()) {
+        emit finished(false, f.errorString());
+        return;
+    }
+    emit progress(done, done);
+    emit finished(true, QString::number(done));
+}
+
+void CsvExportJob::startWithProgress(CsvExportJob* job, QWidget* owner)
+{
+    if (!job) return;
+
+    auto* dlg = new QProgressDialog(u8"CSV로 내보내는 중…", u8"취소", 0, 0, owner);
+    dlg->setWindowModality(Qt::WindowModal);
+    dlg->setMinimumDuration(300);          // 짧은 작업은 대화상자 없이 끝나도록
+    dlg->setAutoClose(false);
+    dlg->setAutoReset(false);
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+
+    QPointer<QWidget> guardOwner(owner);
+    QObject::connect(dlg, &QProgressDialog::canceled, job, &CsvExportJob::cancel);
+    QObject::connect(job, &CsvExportJob::progress, dlg, [dlg](qint64 done, qint64 total){
+        if (total > 0 && total <= std::numeric_limits<int>::max()) {
+            dlg->setMaximum(int(total));
+            dlg->setValue(int(qMin(done, total)));
+        } else {
+            dlg->setMaximum(0);            // 총량 미상: 바쁨 표시
+            dlg->setLabelText(QString(u8"CSV로 내보내는 중… %1행").arg(done));
+        }
+    }, Qt::QueuedConnection);
+    QObject::connect(job, &CsvExportJob::finished, dlg, [dlg, job, guardOwner](bool ok, const QString& msg){
+        dlg->close();
+        if (ok) {
+            if (guardOwner)
+                QMessageBox::information(guardOwner, u8"완료", QString(u8"%1행을 저장했습니다.").arg(msg));
+        } else if (msg != QLatin1String("canceled") && guardOwner) {
+            QMessageBox::warning(guardOwner, u8"오류", QString(u8"CSV 저장 실패: %1").arg(msg));
+        }
+        job->deleteLater();
+    }, Qt::QueuedConnection);
+
+    job->start();
+}
@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file csv_export.h
+ * @brief 표/DB 데이터를 워커 스레드에서 CSV로 쓰는 공용 내보내기 엔진.
+ *
+ * 기능 요약
+ *  - fromModel(): GUI 스레드에서 모델 값을 스냅샷(문자열 복사, 암시적 공유라 저비용)한 뒤 워커에서 기록.
+ *  - fromSql(): 워커 스레드가 자체 DB 커넥션을 열고 forward-only 커서로 한 행씩 읽어 바로 기록(스트리밍).
+ *  - fromSource(): 임의의 행 공급 함수(워커 스레드에서 호출)로 기록.
+ *  - 공통: UTF-8 BOM(엑셀 호환), 모든 셀 큰따옴표 이스케이프, 진행률(progress)/취소(cancel) 지원.
+ *  - QSaveFile 사용: 성공 시에만 원자적으로 교체, 취소/실패 시 기존 파일 보존.
+ *
+ * 사용 예:
+ *   auto* job = CsvExportJob::fromModel(table->model(), path, this);
+ *   CsvExportJob::startWithProgress(job, this);   // 진행 대화상자 + 취소 버튼
+ */
+
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <QVariantMap>
+#include <QFuture>
+#include <atomic>
+#include <functional>
+
+class QAbstractItemModel;
+class QWidget;
+
+class CsvExportJob : public QObject {
+    Q_OBJECT
+public:
+    /// 행 하나를 내보내는 콜백. false를 돌려주면 취소된 것이므로 공급을 멈춰야 한다.
+    using RowSink   = std::function<bool(const QStringList& row)>;
+    /// 워커 스레드에서 호출되는 행 공급자. 실패 시 err에 사유를 채우고 false 반환.
+    using RowSource = std::function<bool(const RowSink& sink, QString* err)>;
+
+    /// 모델 스냅샷(GUI 스레드에서 호출). 헤더는 모델 headerData를 사용.
+    static CsvExportJob* fromModel(const QAbstractItemModel* model, const QString& path,
+                                   QObject* parent = nullptr);
+
+    /**
+     * @brief DB 스트리밍 내보내기
+     * @param connectionName 복제할 기존 커넥션 이름(접속 정보만 복사, 워커 전용 커넥션을 새로 연다)
+     * @param sql/binds      SELECT 문과 바인딩 값(":name" → 값)
+     * @param header         CSV 첫 줄(열 이름)
+     */
+    static CsvExportJob* fromSql(const QString& connectionName, const QString& sql,
+                                 const QVariantMap& binds, const QStringList& header,
+                                 const QString& path, QObject* parent = nullptr);
+
+    /// 임의 공급자. expectedRows<0이면 진행률 총량을 모름(표시만 증가).
+    static CsvExportJob* fromSource(const QStringList& header, RowSource source, qint64 expectedRows,
+                                    const QString& path, QObject* parent = nullptr);
+
+    ~CsvExportJob() override;   ///< 진행 중이면 취소 후 워커 종료까지 대기
+
+    /// 워커 스레드에서 기록 시작(중복 호출 무시)
+    void start();
+    /// 취소 요청(다음 행 경계에서 중단, 파일은 만들지 않음)
+    void cancel() { cancel_.store(true); }
+    bool isRunning() const { return future_.isRunning(); }
+
+    /// 진행 대화상자를 띄우고 시작. 끝나면 결과를 메시지로 안내하고 job은 스스로 정리된다.
+    static void startWithProgress(CsvExportJob* job, QWidget* owner);
+
+    /// CSV 셀 이스케이프(큰따옴표 감싸기 + 내부 따옴표 2배)
+    static QString escape(const QString& s);
+
+signals:
+    /// 진행률(done/total). total<0이면 총량 미상. 워커 스레드에서 방출 → 수신측은 큐 연결.
+    void progress(qint64 done, qint64 total);
+    /// 종료(ok=false면 message에 사유, 취소 시 message="canceled")
+    void finished(bool ok, const QString& message);
+
+private:
+    CsvExportJob(const QStringList& header, RowSource source, qint64 expected,
+                 const QString& path, QObject* parent);
+    void run();   // 워커 스레드 본체
+
+    QStringList header_;
+    RowSource   source_;
+    qint64      expected_ = -1;
+    QString     path_;
+    std::atomic_bool cancel_{false};
+    QFuture<void> future_;
+};
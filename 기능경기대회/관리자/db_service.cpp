@@ -0,0 +1,256 @@
+#include "db_service.h"
+#include <QThread>              // 워커 스레드
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QSettings>            // [db] 섹션 읽기
+#include <QCoreApplication>     // qApp, 실행 파일 경로
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QPointer>
+#include <QDebug>
+#include <QHash>
+
+namespace {
+QAtomicInt g_serviceSeq;   // 서비스 인스턴스별 커넥션 이름 구분용
+
+/*
+ * 워커 커넥션별 준비된 문장 캐시(SQL 모양 → 준비된 QSqlQuery)
+ * - 조건 조합이 같은 SQL은 다시 prepare하지 않고 값만 바인딩해 실행
+ *   (QMYSQL: 서버측 prepared statement 재사용, QSQLITE: sqlite3_prepare 생략)
+ * - 워커 스레드가 소유하고 커넥션을 닫기 전에 비운다(문장이 커넥션보다 오래 살면 안 됨)
+ */
+struct StatementCache {
+    QString conn;                                          ///< 대상 커넥션 이름
+    QHash<QString, std::shared_ptr<QSqlQuery>> stmts;
+    static constexpr int kMax = 32;                        ///< 모양 수는 조건 조합 수로 제한적 — 넘치면 통째로 비움
+};
+thread_local StatementCache* t_stmts = nullptr;
+}
+
+DbConfig DbConfig::fromIni(const QString& iniPath, const QString& group)
+{
+    DbConfig c;
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup(group);
+    c.driver   = ini.value("driver",    c.driver).toString();
+    c.host     = ini.value("host",      c.host).toString();
+    c.port     = ini.value("port",      c.port).toInt();
+    c.database = ini.value("database",  c.database).toString();
+    c.user     = ini.value("user",      c.user).toString();
+    c.password = ini.value("password",  c.password).toString();
+    c.options  = ini.value("options",   c.options).toString();
+    c.poolSize = qBound(1, ini.value("pool_size", c.poolSize).toInt(), 8);
+    ini.endGroup();
+    return c;
+}
+
+DbService::DbService(const DbConfig& cfg, QObject* parent)
+    : QObject(parent), cfg_(cfg)
+{
+    // 템플릿 커넥션: GUI 스레드에서 접속 정보만 등록(열지 않음)
+    //  - 드라이버 초기화(mysql_library_init)를 워커보다 먼저 한 스레드에서 끝내는 효과도 있음
+    tplName_ = QStringLiteral("dbsvc%1_tpl").arg(g_serviceSeq.fetchAndAddOrdered(1));
+    {
+        QSqlDatabase tpl = QSqlDatabase::addDatabase(cfg_.driver, tplName_);
+        tpl.setHostName(cfg_.host);
+        tpl.setPort(cfg_.port);
+        tpl.setDatabaseName(cfg_.database);
+        tpl.setUserName(cfg_.user);
+        tpl.setPassword(cfg_.password);
+        tpl.setConnectOptions(cfg_.options);
+    }
+
+    for (int i = 0; i < cfg_.poolSize; ++i) {
+        QThread* t = QThread::create([this, i]{ workerLoop(i); });
+        t->setObjectName(QStringLiteral("DbWorker-%1").arg(i));
+        workers_ << t;
+        t->start();
+    }
+}
+
+DbService::~DbService()
+{
+    {
+        QMutexLocker lock(&mutex_);
+        stopping_ = true;
+        for (auto& c : channels_) c->store(true);   // 실행 중 작업도 행 경계에서 중단
+        wake_.wakeAll();
+    }
+    for (QThread* t : workers_) { t->wait(); delete t; }
+    workers_.clear();
+
+    // 남은 대기 작업은 취소로 마무리(기다리는 쪽이 영원히 대기하지 않도록)
+    for (const Task& t : queue_) {
+        DbResult r; r.canceled = true;
+        finish(t, r);
+    }
+    queue_.clear();
+    QSqlDatabase::removeDatabase(tplName_);
+}
+
+DbService* DbService::instance()
+{
+    static QPointer<DbService> s;   // qApp 소멸과 함께 삭제되면 자동으로 null
+    if (!s) {
+        const DbConfig cfg = DbConfig::fromIni(QCoreApplication::applicationDirPath() + "/admin_client.ini");
+        s = new DbService(cfg, qApp);
+    }
+    return s;
+}
+
+QFuture<DbResult> DbService::submit(const QString& sql, const QVariantMap& binds, const QString& channel)
+{
+    return submitJob([sql, binds](QSqlDatabase& db, const std::atomic_bool& cancel) {
+        DbResult r = exec(db, sql, binds, cancel);
+        // 다 읽은 뒤 취소됐으면 오래된 조회 결과로 보고 버림. 쓰기 문장은 이미 반영됐으므로 결과 유지
+        if (r.ok && cancel.load() && !r.columns.isEmpty()) { r = DbResult(); r.canceled = true; }
+        return r;
+    }, channel);
+}
+
+QFuture<DbResult> DbService::submitJob(Job job, const QString& channel)
+{
+    Task t;
+    t.job     = std::move(job);
+    t.promise = std::make_shared<QPromise<DbResult>>();
+    t.cancel  = std::make_shared<std::atomic_bool>(false);
+    t.channel = channel;
+    t.promise->start();
+    QFuture<DbResult> fut = t.promise->future();
+
+    QMutexLocker lock(&mutex_);
+    if (stopping_) {
+        lock.unlock();
+        DbResult r; r.canceled = true;
+        finish(t, r);
+        return fut;
+    }
+    if (!channel.isEmpty()) {
+        // 같은 채널의 이전 작업은 더 이상 필요 없음(사용자가 다시 조회함)
+        if (auto old = channels_.value(channel)) old->store(true);
+        channels_.insert(channel, t.cancel);
+    }
+    queue_.push_back(std::move(t));
+    wake_.wakeOne();
+    return fut;
+}
+
+void DbService::cancelChannel(const QString& channel)
+{
+    QMutexLocker lock(&mutex_);
+    if (auto c = channels_.take(channel)) c->store(true);
+}
+
+bool DbService::takeTask(Task& out)
+{
+    QMutexLocker lock(&mutex_);
+    while (queue_.empty() && !stopping_)
+        wake_.wait(&mutex_);
+    if (stopping_) return false;
+    out = std::move(queue_.front());
+    queue_.pop_front();
+    return true;
+}
+
+void DbService::finish(const Task& t, DbResult r)
+{
+    t.promise->addResult(std::move(r));
+    t.promise->finish();
+}
+
+void DbService::workerLoop(int index)
+{
+    const QString name = QStringLiteral("%1_w%2").arg(tplName_).arg(index);
+    {
+        // 커넥션은 이 스레드에서 만들고 이 스레드에서만 사용
+        QSqlDatabase db = QSqlDatabase::cloneDatabase(tplName_, name);
+        if (!db.open())   // 미리 접속(첫 조회 지연 감소). 실패해도 작업 때 다시 시도
+            qWarning() << "DbService: open failed:" << db.lastError().text();
+        StatementCache stmts;
+        stmts.conn = name;
+        t_stmts = &stmts;
+
+        Task t;
+        while (takeTask(t)) {
+            // 대기 중 취소(채널 교체) 또는 소비측 퓨처 취소 → 실행하지 않음
+            if (t.cancel->load() || t.promise->isCanceled()) {
+                DbResult r; r.canceled = true;
+                finish(t, r);
+                continue;
+            }
+            if (!db.isOpen() && !db.open()) {
+                DbResult r; r.error = db.lastError().text();
+                finish(t, r);
+                continue;
+            }
+            // 작업의 결과를 그대로 전달(커밋까지 마친 작업을 늦은 취소로 덮어쓰지 않음)
+            finish(t, t.job(db, *t.cancel));
+
+            // 끝난 작업이 채널의 최신 항목이면 정리(맵이 계속 커지지 않도록)
+            if (!t.channel.isEmpty()) {
+                QMutexLocker lock(&mutex_);
+                auto it = channels_.find(t.channel);
+                if (it != channels_.end() && it.value() == t.cancel) channels_.erase(it);
+            }
+        }
+        t_stmts = nullptr;
+        stmts.stmts.clear();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+}
+
+DbResult DbService::exec(QSqlDatabase& db, const QString& sql, const QVariantMap& binds,
+                         const std::atomic_bool& cancel)
+{
+    DbResult r;
+    // 워커 자신의 커넥션이면 준비된 문장 캐시 사용, 그 외(작업 함수가 연 별도 커넥션)는 매번 준비
+    StatementCache* cache = (t_stmts && t_stmts->conn == db.connectionName()) ? t_stmts : nullptr;
+    std::shared_ptr<QSqlQuery> stmt = cache ? cache->stmts.value(sql) : nullptr;
+    if (!stmt) {
+        stmt = std::make_shared<QSqlQuery>(db);
+        stmt->setForwardOnly(true);   // 결과를 한 행씩 소비(클라이언트 버퍼 최소화)
+        if (!stmt->prepare(sql)) {
+            r.error = stmt->lastError().text();
+            return r;
+        }
+        if (cache) {
+            if (cache->stmts.size() >= StatementCache::kMax) cache->stmts.clear();
+            cache->stmts.insert(sql, stmt);
+        }
+    }
+    QSqlQuery& q = *stmt;
+    for (auto it = binds.cbegin(); it != binds.cend(); ++it)
+        q.bindValue(it.key(), it.value());
+    if (!q.exec()) {
+        r.error = q.lastError().text();
+        const bool lost = q.lastError().type() == QSqlError::ConnectionError;
+        if (cache) {
+            // 실패한 문장은 버림. 연결이 끊겼으면 그 커넥션의 문장 전부 무효
+            if (lost) cache->stmts.clear();
+            else      cache->stmts.remove(sql);
+        }
+        // 연결이 끊긴 경우 다음 작업에서 재접속하도록 닫아 둔다
+        if (lost) db.close();
+        return r;
+    }
+
+    if (q.isSelect()) {
+        const QSqlRecord rec = q.record();
+        const int cols = rec.count();
+        for (int c = 0; c < cols; ++c) r.columns << rec.fieldName(c);
+        while (q.next()) {
+            if (cancel.load()) { q.finish(); r.canceled = true; return r; }
+            QVector<QVariant> row;
+            row.reserve(cols);
+            for (int c = 0; c < cols; ++c) row << q.value(c);
+            r.rows << std::move(row);
+        }
+        q.finish();   // 결과 세트 해제 — 캐시된 문장을 다음 호출에서 바로 재실행할 수 있도록
+    } else {
+        r.numRowsAffected = q.numRowsAffected();
+    }
+    r.ok = true;
+    return r;
+}
@@ -0,0 +1,140 @@
+#pragma once
+/**
+ * @file db_service.h
+ * @brief RDB 질의를 GUI 스레드 밖에서 실행하는 비동기 DB 서비스(커넥션 풀).
+ *
+ * 배경
+ *  - QSqlDatabase 커넥션은 만든 스레드에서만 쓸 수 있고, QMYSQL 질의는 끝날 때까지 호출 스레드를 막는다.
+ *  - DB 호스트가 느리면(연결 3초/읽기 5초 타임아웃) GUI 스레드에서 실행하는 순간 관리자 UI 전체가 멈춘다.
+ *
+ * 구조
+ *  - 워커 스레드 N개(기본 2) — 각 스레드가 자기 커넥션을 하나씩 열어 보유(끊기면 다음 작업 때 재접속).
+ *  - submit(): 작업을 공용 큐에 넣고 즉시 QFuture<DbResult> 반환. 결과는 QFuture::then(context, ...)로 받는다.
+ *  - 채널(channel): 같은 채널에 새 작업이 들어오면 이전 작업은 "오래된 것"으로 취소 표시.
+ *    대기 중이면 실행하지 않고, 실행 중이면 다음 행 경계에서 중단 → 결과는 canceled=true.
+ *  - submitJob(): 여러 문장/트랜잭션이 필요한 경우 워커 커넥션을 직접 받는 작업 함수 실행.
+ *
+ * 접속 정보
+ *  - 실행 파일 옆 admin_client.ini의 [db] 섹션(driver/host/port/database/user/password/options/pool_size).
+ *  - 값이 없으면 기존 기본값(192.168.0.15:3306 safetydb)을 사용.
+ *
+ * 사용 예:
+ *   DbService::instance()->submit(sql, {{":from", from}}, "att.attendance")
+ *       .then(this, [this](const DbResult& r){ if (!r.canceled) fill(r); });
+ */
+
+#include <QObject>
+#include <QFuture>
+#include <QPromise>
+#include <QVariant>
+#include <QVariantMap>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSqlDatabase>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+class QThread;
+
+/// 질의 결과(값 복사본 — 스레드 간 전달 가능)
+struct DbResult {
+    bool ok       = false;          ///< 실행 성공 여부
+    bool canceled = false;          ///< 채널 교체/퓨처 취소/종료로 중단됨(결과 무시)
+    QString error;                  ///< 실패 사유
+    QStringList columns;            ///< 열 이름(SELECT일 때)
+    QVector<QVector<QVariant>> rows;///< 결과 행
+    int numRowsAffected = -1;       ///< INSERT/UPDATE/DELETE 영향 행 수
+
+    /// 열 이름으로 값 조회(없으면 invalid)
+    QVariant value(int row, const QString& column) const {
+        const int c = columns.indexOf(column);
+        return (c < 0 || row < 0 || row >= rows.size()) ? QVariant() : rows[row].value(c);
+    }
+};
+
+/// 접속 설정
+struct DbConfig {
+    QString driver   = "QMYSQL";
+    QString host     = "192.168.0.15";
+    int     port     = 3306;
+    QString database = "safetydb";
+    QString user     = "user1";
+    QString password = "1234";
+    QString options  = "MYSQL_OPT_CONNECT_TIMEOUT=3;MYSQL_OPT_READ_TIMEOUT=5;MYSQL_OPT_WRITE_TIMEOUT=5";
+    int     poolSize = 2;
+
+    /// INI 섹션에서 읽기(없는 키는 기본값 유지)
+    static DbConfig fromIni(const QString& iniPath, const QString& group = "db");
+};
+
+class DbService : public QObject {
+    Q_OBJECT
+public:
+    /// 워커 커넥션에서 실행할 작업. cancel이 true가 되면 가능한 빨리 canceled 결과로 돌아와야 한다.
+    /// 반환값은 그대로 전달된다 — 이미 커밋한 작업은 늦게 취소돼도 ok 결과를 돌려줄 것.
+    using Job = std::function<DbResult(QSqlDatabase& db, const std::atomic_bool& cancel)>;
+
+    explicit DbService(const DbConfig& cfg, QObject* parent = nullptr);
+    ~DbService() override;   ///< 대기 작업은 취소 처리, 워커 종료까지 대기
+
+    /// 앱 공용 인스턴스(관리자 MySQL, admin_client.ini [db]). 첫 호출 시 생성, qApp 소멸 시 정리.
+    static DbService* instance();
+
+    /**
+     * @brief 단일 SQL 실행 예약
+     * @param binds   ":name" → 값
+     * @param channel 비어 있지 않으면 같은 채널의 이전 작업을 취소(재조회 시 오래된 결과 폐기)
+     */
+    QFuture<DbResult> submit(const QString& sql, const QVariantMap& binds = {},
+                             const QString& channel = QString());
+
+    /// 임의 작업 실행 예약(트랜잭션/여러 문장). 채널 의미는 submit()과 같다.
+    QFuture<DbResult> submitJob(Job job, const QString& channel = QString());
+
+    /// 채널의 대기/실행 중 작업 취소
+    void cancelChannel(const QString& channel);
+
+    /**
+     * @brief 워커 커넥션에서 SQL 한 문장 실행(작업 함수 안에서 사용하는 헬퍼)
+     * - forward-only 커서로 읽으며 행마다 cancel 확인
+     * - 워커 커넥션에서는 SQL 문자열(모양)별로 준비된 문장을 재사용 → 값만 다른 반복 질의는 prepare 생략.
+     *   따라서 값은 문자열에 끼워 넣지 말고 binds로 넘겨야 캐시가 커지지 않는다.
+     */
+    static DbResult exec(QSqlDatabase& db, const QString& sql, const QVariantMap& binds,
+                         const std::atomic_bool& cancel);
+
+    /**
+     * @brief 접속 정보만 등록된(열지 않은) 템플릿 커넥션 이름.
+     * 다른 스레드가 자체 커넥션을 만들 때 QSqlDatabase::cloneDatabase()의 원본으로 쓴다.
+     */
+    QString templateConnection() const { return tplName_; }
+
+    const DbConfig& config() const { return cfg_; }
+
+private:
+    struct Task {
+        Job job;
+        std::shared_ptr<QPromise<DbResult>> promise;
+        std::shared_ptr<std::atomic_bool>   cancel;
+        QString channel;
+    };
+
+    void workerLoop(int index);   // 워커 스레드 본체(커넥션 생성 → 큐 소비 → 정리)
+    bool takeTask(Task& out);     // 큐에서 하나 꺼냄(비면 대기, 종료 시 false)
+    static void finish(const Task& t, DbResult r);
+
+    DbConfig cfg_;
+    QString  tplName_;
+    QVector<QThread*> workers_;
+
+    QMutex mutex_;
+    QWaitCondition wake_;
+    std::deque<Task> queue_;                                     ///< 대기 작업(FIFO)
+    QHash<QString, std::shared_ptr<std::atomic_bool>> channels_; ///< 채널별 최신 작업의 취소 플래그
+    bool stopping_ = false;
+};
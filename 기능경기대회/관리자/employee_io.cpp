@@ -0,0 +1,247 @@
+#include "employee_io.h"
+#include "db_service.h"
+#include <QtConcurrent>          // 파싱/검증을 스레드 풀에서
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QRegularExpression>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+namespace {
+
+constexpr int kBatchRows = 200;   // 다중 행 INSERT 한 번에 넣을 행 수(패킷 크기/잠금 시간 균형)
+constexpr int kCols      = 6;     // emp_id, name, department, position, status, phone
+
+enum Col { CEmp, CName, CDept, CPos, CStatus, CPhone };
+
+// 헤더 제목 → 열(한글/영문 모두 인식)
+int columnOf(const QString& title)
+{
+    static const QHash<QString, int> map{
+        {u8"사번", CEmp},   {"emp_id", CEmp},
+        {u8"이름", CName},  {"name", CName},
+        {u8"부서", CDept},  {"department", CDept},
+        {u8"직무", CPos},   {"position", CPos},
+        {u8"상태", CStatus},{"status", CStatus},
+        {u8"연락처", CPhone},{"phone", CPhone},
+    };
+    return map.value(title.trimmed().toLower(), -1);
+}
+
+/*
+ * 다중 행 INSERT 문(행 수 n) — 값은 전부 바인딩(:r{i}c{j})
+ * - 행 수가 같으면 SQL 문자열이 같으므로 워커의 준비된 문장이 재사용된다(마지막 자투리 묶음만 새로 준비)
+ * - emp_id가 NULL이면 AUTO_INCREMENT 채번, 기존 사번이면 나머지 열 갱신
+ */
+QString insertSql(int n)
+{
+    QStringList values;
+    values.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        QStringList ph;
+        for (int c = 0; c < kCols; ++c) ph << QString(":r%1c%2").arg(i).arg(c);
+        values << "(" + ph.join(", ") + ")";
+    }
+    return "INSERT INTO employee (emp_id, name, department, position, status, phone) VALUES "
+         + values.join(", ")
+         + " AS n ON DUPLICATE KEY UPDATE name = n.name, department = n.department, "
+           "position = n.position, status = n.status, phone = n.phone";
+}
+
+void bindRecord(QVariantMap& binds, int i, const EmployeeIo::Record& r)
+{
+    const QString p = QString(":r%1c").arg(i);
+    binds.insert(p + "0", r.empId.isValid() ? r.empId : QVariant(QMetaType::fromType<int>()));
+    binds.insert(p + "1", r.name);
+    binds.insert(p + "2", r.department.isEmpty() ? QVariant(QMetaType::fromType<QString>()) : QVariant(r.department));
+    binds.insert(p + "3", r.position.isEmpty()   ? QVariant(QMetaType::fromType<QString>()) : QVariant(r.position));
+    binds.insert(p + "4", r.status);
+    binds.insert(p + "5", r.phone.isEmpty()      ? QVariant(QMetaType::fromType<QString>()) : QVariant(r.phone));
+}
+
+} // namespace
+
+QStringList EmployeeIo::header()
+{
+    return {u8"사번", u8"이름", u8"부서", u8"직무", u8"상태", u8"연락처"};
+}
+
+QVector<QStringList> EmployeeIo::splitCsv(const QString& text, QVector<int>* lineNumbers)
+{
+    // RFC 4180: 큰따옴표 셀 안의 쉼표/줄바꿈/"" 허용, CRLF/LF 모두 처리
+    QVector<QStringList> records;
+    QStringList row;
+    QString cell;
+    bool quoted = false;
+    int line = 1, rowLine = 1;
+
+    auto endRow = [&] {
+        row << cell;
+        cell.clear();
+        // 완전히 빈 줄은 건너뜀
+        if (!(row.size() == 1 && row.first().trimmed().isEmpty())) {
+            records << row;
+            if (lineNumbers) *lineNumbers << rowLine;
+        }
+        row.clear();
+    };
+
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar ch = text.at(i);
+        if (quoted) {
+            if (ch == '"') {
+                if (i + 1 < text.size() && text.at(i + 1) == '"') { cell += '"'; ++i; }
+                else quoted = false;
+            } else {
+                if (ch == '\n') ++line;
+                cell += ch;
+            }
+            continue;
+        }
+        if (ch == '"' && cell.isEmpty()) { quoted = true; continue; }
+        if (ch == ',') { row << cell; cell.clear(); continue; }
+        if (ch == '\r') continue;
+        if (ch == '\n') { endRow(); ++line; rowLine = line; continue; }
+        cell += ch;
+    }
+    if (!cell.isEmpty() || !row.isEmpty()) endRow();
+    return records;
+}
+
+EmployeeIo::Parsed EmployeeIo::parseCsv(const QString& path)
+{
+    Parsed out;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        out.error = f.errorString();
+        return out;
+    }
+    QString text = QString::fromUtf8(f.readAll());
+    if (text.startsWith(QChar(0xFEFF))) text.remove(0, 1);   // 엑셀 UTF-8 BOM
+
+    QVector<int> lines;
+    const QVector<QStringList> rows = splitCsv(text, &lines);
+    if (rows.isEmpty()) {
+        out.error = u8"빈 파일입니다.";
+        return out;
+    }
+
+    // 헤더 → 열 위치. 이름 열은 필수
+    int pos[kCols];
+    std::fill(std::begin(pos), std::end(pos), -1);
+    for (int i = 0; i < rows.first().size(); ++i) {
+        const int c = columnOf(rows.first().at(i));
+        if (c >= 0 && pos[c] < 0) pos[c] = i;
+    }
+    if (pos[CName] < 0) {
+        out.error = u8"헤더에 '이름'(name) 열이 없습니다. 첫 줄: " + header().join(',');
+        return out;
+    }
+
+    static const QRegularExpression rePhone(QStringLiteral("^[0-9+\\- ]{0,20}$"));
+    QSet<int> seenIds;
+    for (int r = 1; r < rows.size(); ++r) {
+        const QStringList& cells = rows[r];
+        auto cell = [&](int c) { return pos[c] >= 0 ? cells.value(pos[c]).trimmed() : QString(); };
+
+        Record rec;
+        rec.line       = lines[r];
+        rec.name       = cell(CName);
+        rec.department = cell(CDept);
+        rec.position   = cell(CPos);
+        rec.phone      = cell(CPhone);
+
+        QStringList problems;
+        if (rec.name.isEmpty())      problems << u8"이름 없음";
+        else if (rec.name.size() > 50) problems << u8"이름이 50자를 넘음";
+
+        const QString idText = cell(CEmp);
+        if (!idText.isEmpty()) {
+            bool ok = false;
+            const int id = idText.toInt(&ok);
+            if (!ok || id <= 0)               problems << u8"사번 형식 오류: " + idText;
+            else if (seenIds.contains(id))    problems << u8"파일 안에서 사번 중복: " + idText;
+            else { seenIds.insert(id); rec.empId = id; }
+        }
+
+        const QString st = cell(CStatus).toLower();
+        if (st.isEmpty() || st == u8"재직" || st == "1" || st == "active")        rec.status = 1;
+        else if (st == u8"퇴사" || st == "0" || st == "inactive")                 rec.status = 0;
+        else problems << u8"상태 값 오류(재직/퇴사): " + cell(CStatus);
+
+        if (!rePhone.match(rec.phone).hasMatch()) problems << u8"연락처 형식 오류: " + rec.phone;
+
+        if (problems.isEmpty()) out.records << rec;
+        else out.issues << Issue{rec.line, problems.join(", ")};
+    }
+    return out;
+}
+
+QFuture<EmployeeIo::Parsed> EmployeeIo::parseCsvAsync(const QString& path)
+{
+    return QtConcurrent::run([path] { return parseCsv(path); });
+}
+
+QFuture<DbResult> EmployeeIo::submitImport(DbService* db, const QVector<Record>& records, const QString& channel)
+{
+    return db->submitJob([records](QSqlDatabase& con, const std::atomic_bool& cancel) {
+        DbResult r;
+        r.columns = QStringList{"line", "error"};
+        int applied = 0;
+
+        auto run = [&](const QVector<Record>& part, QString* err) {
+            QVariantMap binds;
+            for (int i = 0; i < part.size(); ++i) bindRecord(binds, i, part[i]);
+            const DbResult x = DbService::exec(con, insertSql(part.size()), binds, cancel);
+            if (!x.ok && err) *err = x.error;
+            return x.ok;
+        };
+        auto plain = [&](const QString& sql) { return QSqlQuery(con).exec(sql); };
+
+        if (!con.transaction()) { r.error = con.lastError().text(); return r; }
+        for (int b = 0; b < records.size(); b += kBatchRows) {
+            if (cancel.load()) { con.rollback(); r.canceled = true; return r; }
+            const QVector<Record> batch = records.mid(b, kBatchRows);
+
+            plain("SAVEPOINT emp_batch");
+            QString err;
+            if (run(batch, &err)) { applied += batch.size(); continue; }
+
+            // 묶음 실패 → 되돌리고 한 행씩 다시(실패 행만 보고, 나머지는 반영)
+            if (!plain("ROLLBACK TO SAVEPOINT emp_batch")) {
+                con.rollback();
+                r.error = err;
+                return r;
+            }
+            for (const Record& rec : batch) {
+                plain("SAVEPOINT emp_row");
+                QString rowErr;
+                if (run({rec}, &rowErr)) {
+                    ++applied;
+                } else {
+                    plain("ROLLBACK TO SAVEPOINT emp_row");
+                    r.rows << QVector<QVariant>{rec.line, rowErr};
+                }
+            }
+        }
+        if (cancel.load()) { con.rollback(); r.canceled = true; return r; }   // 커밋 직전 마지막 확인
+        if (!con.commit()) {
+            r.error = con.lastError().text();
+            con.rollback();
+            return r;
+        }
+        r.ok = true;
+        r.numRowsAffected = applied;
+        return r;
+    }, channel);
+}
+
+QString EmployeeIo::exportSql()
+{
+    return "SELECT emp_id, name, COALESCE(department,''), COALESCE(position,''), "
+           "       CASE WHEN status = 1 THEN '" + QString(u8"재직") + "' ELSE '" + QString(u8"퇴사") + "' END, "
+           "       COALESCE(phone,'') "
+           "FROM employee ORDER BY emp_id";
+}
@@ -0,0 +1,75 @@
+#pragma once
+/**
+ * @file employee_io.h
+ * @brief 사원 CSV 일괄 가져오기/내보내기.
+ *
+ * 배경
+ *  - 사원 등록은 한 명씩 입력하는 방식뿐이라, 협력업체 인원 수백 명을 받는 날은 오후 내내 클릭했다.
+ *
+ * 가져오기
+ *  - parseCsv(): 워커 스레드에서 파일 읽기 + 검증(필수/형식/파일 내 사번 중복) → 행별 오류 목록
+ *  - submitImport(): DbService 워커 커넥션에서 한 트랜잭션으로
+ *    · 200행 단위 다중 행 INSERT … ON DUPLICATE KEY UPDATE(사번이 있으면 갱신, 비어 있으면 자동 채번)
+ *    · 묶음이 실패하면 SAVEPOINT로 되돌린 뒤 그 묶음만 한 행씩 다시 넣어 실패 행을 특정
+ *    · 결과 DbResult: numRowsAffected = 반영 행 수, rows = 실패 행 (줄 번호, 사유)
+ *  - 행 하나가 실패해도 나머지는 반영(실패 행은 보고서로 확인 후 고쳐서 다시 가져오기)
+ *
+ * 내보내기
+ *  - exportSql(): 가져오기와 같은 열 순서/상태 표기의 SELECT → CsvExportJob::fromSql로 스트리밍
+ *    (내보낸 파일을 고쳐 그대로 다시 가져올 수 있다)
+ *
+ * CSV 형식(UTF-8, BOM 허용, 첫 줄 헤더)
+ *  - 사번,이름,부서,직무,상태,연락처  (영문 헤더 emp_id,name,department,position,status,phone도 인식)
+ *  - 상태: 재직/퇴사(또는 1/0), 비어 있으면 재직
+ */
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QVariant>
+#include <QFuture>
+
+class DbService;
+struct DbResult;
+
+class EmployeeIo {
+public:
+    /// 가져올 사원 한 명
+    struct Record {
+        int      line = 0;     ///< 파일 줄 번호(보고용, 헤더 = 1)
+        QVariant empId;        ///< 비어 있으면 invalid → 자동 채번
+        QString  name, department, position, phone;
+        int      status = 1;
+    };
+    /// 행 단위 문제(검증 실패/DB 거부)
+    struct Issue {
+        int     line = 0;
+        QString message;
+    };
+    struct Parsed {
+        QVector<Record> records;   ///< 검증을 통과한 행
+        QVector<Issue>  issues;    ///< 검증 실패 행
+        QString         error;     ///< 파일 자체 오류(열기 실패/헤더 없음 등)
+    };
+
+    /// CSV 열 제목(내보내기 헤더 = 가져오기 기준)
+    static QStringList header();
+
+    /// 파일 읽기 + 검증(스레드 안전 — 워커에서 호출)
+    static Parsed parseCsv(const QString& path);
+    /// parseCsv를 스레드 풀에서 실행
+    static QFuture<Parsed> parseCsvAsync(const QString& path);
+
+    /// 검증된 행을 한 트랜잭션으로 반영(channel로 취소 가능 — 취소 시 전체 롤백)
+    static QFuture<DbResult> submitImport(DbService* db, const QVector<Record>& records,
+                                          const QString& channel = "emp.import");
+
+    /// 내보내기 SELECT(MySQL/SQLite 공통)
+    static QString exportSql();
+
+    /**
+     * @brief CSV 본문 → 레코드 목록(RFC 4180: 따옴표 안의 쉼표/줄바꿈/"" 처리, 빈 줄 무시)
+     * @param lineNumbers 각 레코드가 시작한 파일 줄 번호(오류 보고용)
+     */
+    static QVector<QStringList> splitCsv(const QString& text, QVector<int>* lineNumbers = nullptr);
+};
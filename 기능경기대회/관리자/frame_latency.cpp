@@ -0,0 +1,153 @@
+#include "frame_latency.h"
+#include <QDateTime>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// 정렬된 표본의 q 퍼센타일(올림 순위)
+double percentile(const QVector<qint32> &sorted, int q){
+    if(sorted.isEmpty()) return 0;
+    const int k = qBound(0, (int(sorted.size()) * q + 99) / 100 - 1, int(sorted.size()) - 1);
+    return sorted[k];
+}
+
+QVector<qint32> sortedCopy(const QVector<qint32> &v){
+    QVector<qint32> s = v;
+    std::sort(s.begin(), s.end());
+    return s;
+}
+
+} // namespace
+
+// ===================== LatencyStats =====================
+
+QString LatencyStats::summary() const{
+    if(samples == 0) return QString::fromUtf8("지연 측정 없음(서버가 X-Capture-Ts를 보내지 않음)");
+    QString s = QString::fromUtf8("지연 p50 %1 / p95 %2 / p99 %3 ms · 목표 %4 ms 내 %5% · 망 %6 · 디코드 %7 · 그리기 %8")
+        .arg(p50, 0, 'f', 0).arg(p95, 0, 'f', 0).arg(p99, 0, 'f', 0)
+        .arg(sloMs).arg(withinSlo * 100, 0, 'f', 0)
+        .arg(netP50, 0, 'f', 0).arg(decodeP50, 0, 'f', 0).arg(paintP50, 0, 'f', 0);
+    s += synced ? QString::fromUtf8(" · 시계 보정 ±%1 ms").arg(clockErrMs, 0, 'f', 0)
+                : QString::fromUtf8(" · 시계 보정 없음");
+    return s;
+}
+
+// ===================== ClockSync =====================
+
+ClockSync::ClockSync(QNetworkAccessManager *nam, QObject *parent)
+    : QObject(parent), m_nam(nam)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ClockSync::probe);
+}
+
+void ClockSync::start(const QUrl &streamUrl){
+    QUrl u;
+    u.setScheme(streamUrl.scheme());
+    u.setHost(streamUrl.host());
+    u.setPort(streamUrl.port());
+    u.setPath("/clock");
+    if(u == m_clockUrl && (m_timer.isActive() || m_pending || m_unsupported)) return;
+    if(u != m_clockUrl){
+        m_clockUrl = u;
+        m_samples.clear();
+        m_probes = 0;
+        m_bestRtt = -1;
+        m_offset = 0;
+        m_unsupported = false;
+    }
+    if(!m_unsupported && !m_pending) probe();
+}
+
+void ClockSync::stop(){
+    m_timer.stop();
+}
+
+/*
+ * 표본 하나: t0(요청) → 서버 시각 s → t1(응답). offset = s − (t0 + t1)/2.
+ * 왕복이 짧을수록 대칭 가정의 오차가 작으므로 최근 kKeep개 중 왕복 최소 표본을 채택한다.
+ */
+void ClockSync::probe(){
+    if(!m_clockUrl.isValid() || m_unsupported) return;
+    const qint64 t0 = QDateTime::currentMSecsSinceEpoch();
+    QNetworkReply *r = m_nam->get(QNetworkRequest(m_clockUrl));
+    m_pending = r;
+    connect(r, &QNetworkReply::finished, this, [this, r, t0]{
+        r->deleteLater();
+        m_pending = nullptr;
+        const qint64 t1 = QDateTime::currentMSecsSinceEpoch();
+        bool ok = false;
+        const double server = r->error() == QNetworkReply::NoError ? r->readAll().trimmed().toDouble(&ok) : 0;
+        if(!ok){
+            // 없는 엔드포인트/형식 오류: 이 서버는 보정하지 않음. 일시 오류면 다음 주기에 다시
+            if(r->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 404
+               || r->error() == QNetworkReply::NoError){
+                m_unsupported = true;
+                return;
+            }
+            m_timer.start(kIntervalMs);
+            return;
+        }
+
+        m_samples.append(Sample{qint64(server) - (t0 + t1) / 2, t1 - t0});
+        if(m_samples.size() > kKeep) m_samples.removeFirst();
+        const auto best = std::min_element(m_samples.cbegin(), m_samples.cend(),
+                                           [](const Sample &a, const Sample &b){ return a.rtt < b.rtt; });
+        m_offset = best->offset;
+        m_bestRtt = best->rtt;
+
+        ++m_probes;
+        m_timer.start(m_probes < kBurst ? 200 : kIntervalMs);
+    });
+}
+
+// ===================== LatencyRecorder =====================
+
+void LatencyRecorder::Ring::add(qint64 ms){
+    const qint32 val = qint32(qBound<qint64>(0, ms, std::numeric_limits<qint32>::max()));
+    if(v.size() < kSamples) v.append(val);
+    else v[next] = val;
+    next = (next + 1) % kSamples;
+}
+
+void LatencyRecorder::add(const FrameTiming &t, qint64 paintedMs){
+    if(t.recvMs <= 0 || t.decodedMs <= 0) return;
+    m_decode.add(t.decodedMs - t.recvMs);
+    m_paint.add(paintedMs - t.decodedMs);
+    if(t.captureMs > 0){
+        // 보정 오차로 음수가 나올 수 있음 → 0으로 자름(Ring::add)
+        m_net.add(t.recvMs - t.captureMs);
+        m_total.add(paintedMs - t.captureMs);
+    }
+}
+
+LatencyStats LatencyRecorder::compute(int sloMs) const{
+    LatencyStats s;
+    s.sloMs = sloMs;
+    s.samples = int(m_total.v.size());
+    if(s.samples > 0){
+        const QVector<qint32> total = sortedCopy(m_total.v);
+        s.p50 = percentile(total, 50);
+        s.p95 = percentile(total, 95);
+        s.p99 = percentile(total, 99);
+        const auto within = std::upper_bound(total.cbegin(), total.cend(), sloMs) - total.cbegin();
+        s.withinSlo = double(within) / total.size();
+        const QVector<qint32> net = sortedCopy(m_net.v);
+        s.netP50 = percentile(net, 50);
+        s.netP95 = percentile(net, 95);
+    }
+    const QVector<qint32> dec = sortedCopy(m_decode.v);
+    s.decodeP50 = percentile(dec, 50);
+    s.decodeP95 = percentile(dec, 95);
+    const QVector<qint32> paint = sortedCopy(m_paint.v);
+    s.paintP50 = percentile(paint, 50);
+    s.paintP95 = percentile(paint, 95);
+    return s;
+}
+
+void LatencyRecorder::clear(){
+    m_total = m_net = m_decode = m_paint = Ring();
+}
@@ -0,0 +1,118 @@
+#pragma once
+/**
+ * @file frame_latency.h
+ * @brief 프레임 지연 측정(캡처 → 화면) — 시각 기록, 서버 시계 보정, 구간별 퍼센타일.
+ *
+ * 배경
+ *  - 운영자는 화면의 영상을 보고 안전 판단을 하는데, 표시된 프레임이 몇 초 전 것인지 알 수 없었다.
+ *    밀린 디코드/혼잡한 링크/UI 스레드 정체 중 어디가 느린지도 구분할 수 없었다.
+ *
+ * 측정
+ *  - 카메라 서버가 파트마다 X-Capture-Ts(캡처 시각, epoch ms, 서버 시계)를 붙인다(stream_server.py).
+ *  - 구간(모두 로컬 시계 ms):
+ *    · 망    = 수신 완료 − 캡처(서버 시계 보정 후) — 서버 추론/인코딩 + 전송 포함
+ *    · 디코드 = 디코드 완료(UI 스레드 도착) − 수신 완료 — 디코드 대기 + 디코드
+ *    · 그리기 = paintEvent 완료 − 디코드 완료 — 축소/이벤트 루프 대기 + 그리기
+ *    · 전체  = 그리기 완료 − 캡처
+ *    그리기 완료는 백버퍼 기준이므로 화면 합성(수 ms)은 포함하지 않는다.
+ *  - 화면에 그려지지 못하고 덮어써진 프레임은 표본이 아님(운영자가 보지 않은 프레임).
+ *
+ * 시계 보정(ClockSync)
+ *  - 서버 /clock(현재 epoch ms)을 주기적으로 요청해 NTP 방식으로 오프셋 추정:
+ *    offset = 서버 시각 − (요청 시각 + 응답 시각)/2, 최근 표본 중 왕복이 가장 짧은 것을 채택
+ *    → 오차는 그 왕복 시간의 절반 이내
+ *  - /clock이 없는 서버는 보정 없이 두 시계가 맞다고 가정(LatencyStats::synced = false로 표시)
+ *
+ * 목표(SLO)
+ *  - admin_client.ini [stream] latency_slo_ms(기본 500): 전체 지연이 이 안에 든 표본 비율을 함께 보고
+ */
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+/// 프레임 하나의 구간 시각(로컬 epoch ms, 0 = 모름)
+struct FrameTiming {
+    qint64 captureMs = 0;        ///< 캡처 시각(서버 시계를 로컬로 보정, 헤더가 없으면 0)
+    qint64 recvMs = 0;           ///< 파트 수신 완료
+    qint64 decodedMs = 0;        ///< 디코드 완료(UI 스레드 도착)
+};
+
+/// 최근 표본의 지연 지표(ms)
+struct LatencyStats {
+    int samples = 0;             ///< 집계에 쓴 표본 수(0이면 나머지 값은 의미 없음)
+    double p50 = 0, p95 = 0, p99 = 0;   ///< 전체(캡처 → 그리기) 퍼센타일
+    double netP50 = 0, netP95 = 0;       ///< 망 구간
+    double decodeP50 = 0, decodeP95 = 0; ///< 디코드 구간
+    double paintP50 = 0, paintP95 = 0;   ///< 그리기 구간
+    int sloMs = 0;               ///< 목표(latency_slo_ms)
+    double withinSlo = 0;        ///< 목표 안에 든 표본 비율(0~1)
+    bool synced = false;         ///< 서버 시계 보정됨(false = 두 시계가 맞다고 가정)
+    double clockErrMs = 0;       ///< 보정 오차 상한(채택 표본 왕복의 절반)
+
+    /// 한 줄 요약("지연 p50 180 / p95 240 / p99 310 ms · 목표 500 ms 내 99% · 망 120 · 디코드 8 · 그리기 4")
+    QString summary() const;
+};
+
+/**
+ * @brief 서버 시계 오프셋 추정(/clock)
+ *  - start() 직후 몇 번 빠르게, 이후 kIntervalMs마다 한 번 요청
+ *  - 404/형식 오류면 미지원으로 보고 멈춤
+ */
+class ClockSync : public QObject {
+    Q_OBJECT
+public:
+    explicit ClockSync(QNetworkAccessManager *nam, QObject *parent = nullptr);
+
+    /// 스트림 URL의 호스트에 대해 추정 시작(같은 호스트면 기존 추정 유지)
+    void start(const QUrl &streamUrl);
+    void stop();
+
+    bool synced() const { return m_bestRtt >= 0; }
+    /// 서버 시각 − 로컬 시각(ms). 로컬 = 서버 − offset
+    qint64 offsetMs() const { return m_offset; }
+    /// 채택 표본의 왕복(ms, 미보정이면 -1)
+    qint64 rttMs() const { return m_bestRtt; }
+
+private:
+    void probe();
+
+    static constexpr int kIntervalMs = 60000;
+    static constexpr int kBurst = 4;         ///< 시작 직후 빠르게 모을 표본 수
+    static constexpr int kKeep = 8;          ///< 유지할 최근 표본 수
+
+    struct Sample { qint64 offset; qint64 rtt; };
+
+    QNetworkAccessManager *m_nam;
+    QUrl m_clockUrl;
+    QTimer m_timer;
+    QPointer<QObject> m_pending;             ///< 진행 중 요청(겹치지 않게)
+    QVector<Sample> m_samples;
+    int m_probes = 0;
+    qint64 m_offset = 0;
+    qint64 m_bestRtt = -1;
+    bool m_unsupported = false;
+};
+
+/// 뷰 하나의 지연 표본 원형 버퍼(그린 프레임만)
+class LatencyRecorder {
+public:
+    /// 그리기를 마친 프레임 1장(captureMs가 없으면 전체/망 구간은 건너뜀)
+    void add(const FrameTiming &t, qint64 paintedMs);
+    /// 지금까지의 표본으로 지표 계산(표본은 유지 — 원형 버퍼가 오래된 것부터 밀어냄)
+    LatencyStats compute(int sloMs) const;
+    void clear();
+
+private:
+    static constexpr int kSamples = 240;      ///< 15fps 기준 약 16초
+    struct Ring {
+        QVector<qint32> v;
+        int next = 0;
+        void add(qint64 ms);
+    };
+    Ring m_total, m_net, m_decode, m_paint;
+};
@@ -0,0 +1,173 @@
+#include "frame_scaler.h"
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define FRAME_SCALER_SSE2 1
+#  include <emmintrin.h>
+#endif
+// AVX2는 함수 단위 target 속성으로만 켠다(전체 빌드 플래그는 그대로) → GCC/Clang에서만
+#if defined(FRAME_SCALER_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#  define FRAME_SCALER_AVX2 1
+#  include <immintrin.h>
+#endif
+
+namespace {
+
+// ── 세로 누적: acc[i] += row[i] (바이트 → 16비트) ─────────────────────
+
+void addRowScalar(const uchar *row, quint16 *acc, int bytes)
+{
+    for (int i = 0; i < bytes; ++i) acc[i] = quint16(acc[i] + row[i]);
+}
+
+#ifdef FRAME_SCALER_SSE2
+void addRowSse2(const uchar *row, quint16 *acc, int bytes)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        __m128i *a = reinterpret_cast<__m128i *>(acc + i);
+        _mm_storeu_si128(a,     _mm_add_epi16(_mm_loadu_si128(a),     _mm_unpacklo_epi8(px, zero)));
+        _mm_storeu_si128(a + 1, _mm_add_epi16(_mm_loadu_si128(a + 1), _mm_unpackhi_epi8(px, zero)));
+    }
+    addRowScalar(row + i, acc + i, bytes - i);
+}
+#endif
+
+#ifdef FRAME_SCALER_AVX2
+__attribute__((target("avx2")))
+void addRowAvx2(const uchar *row, quint16 *acc, int bytes)
+{
+    int i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        // 16바이트 → 16개 16비트(vpmovzxbw) 한 번에
+        const __m256i px = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)));
+        __m256i *a = reinterpret_cast<__m256i *>(acc + i);
+        _mm256_storeu_si256(a, _mm256_add_epi16(_mm256_loadu_si256(a), px));
+    }
+    addRowScalar(row + i, acc + i, bytes - i);
+}
+#endif
+
+// ── 가로 평균: 출력 픽셀마다 누적 버퍼 kx칸(픽셀)을 더해 역수 곱 ──────
+// 두 경로 모두 평균 = ((합 + half) × inv) >> 16 (half = 블록 픽셀 수의 절반) → CPU와 무관하게 같은 픽셀
+
+void reduceRowScalar(const quint16 *acc, const int *colStart, uchar *out, int dw, int kx, quint32 inv,
+                     quint32 half)
+{
+    for (int x = 0; x < dw; ++x, out += 4) {
+        const quint16 *a = acc + colStart[x];
+        quint32 s0 = half, s1 = half, s2 = half, s3 = half;
+        for (int i = 0; i < kx; ++i, a += 4) {
+            s0 += a[0]; s1 += a[1]; s2 += a[2]; s3 += a[3];
+        }
+        // inv는 올림한 역수라 밝은 큰 블록에서 256이 나올 수 있음 → SSE2의 packus처럼 255로 포화
+        out[0] = uchar(qMin<quint32>(255, (s0 * inv) >> 16));
+        out[1] = uchar(qMin<quint32>(255, (s1 * inv) >> 16));
+        out[2] = uchar(qMin<quint32>(255, (s2 * inv) >> 16));
+        out[3] = uchar(qMin<quint32>(255, (s3 * inv) >> 16));
+    }
+}
+
+#ifdef FRAME_SCALER_SSE2
+// 블록 합 + half가 16비트에 들어갈 때만: 한 픽셀(4채널)을 16비트 4칸으로 한 번에 처리
+void reduceRowSse2(const quint16 *acc, const int *colStart, uchar *out, int dw, int kx, quint32 inv,
+                   quint32 half)
+{
+    const __m128i mul = _mm_set1_epi16(short(quint16(inv)));
+    const __m128i rnd = _mm_set1_epi16(short(quint16(half)));
+    for (int x = 0; x < dw; ++x, out += 4) {
+        const quint16 *a = acc + colStart[x];
+        __m128i s = rnd;
+        for (int i = 0; i < kx; ++i, a += 4)
+            s = _mm_add_epi16(s, _mm_loadl_epi64(reinterpret_cast<const __m128i *>(a)));
+        s = _mm_mulhi_epu16(s, mul);
+        const int px = _mm_cvtsi128_si32(_mm_packus_epi16(s, s));
+        std::memcpy(out, &px, 4);
+    }
+}
+#endif
+
+using AddRowFn = void (*)(const uchar *, quint16 *, int);
+using ReduceRowFn = void (*)(const quint16 *, const int *, uchar *, int, int, quint32, quint32);
+
+struct Kernel {
+    AddRowFn addRow;
+    const char *name;
+};
+
+const Kernel &kernel()
+{
+    static const Kernel k = [] {
+#ifdef FRAME_SCALER_AVX2
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Kernel{addRowAvx2, "avx2"};
+#endif
+#ifdef FRAME_SCALER_SSE2
+        return Kernel{addRowSse2, "sse2"};
+#else
+        return Kernel{addRowScalar, "scalar"};
+#endif
+    }();
+    return k;
+}
+
+bool is32bit(QImage::Format f)
+{
+    return f == QImage::Format_RGB32 || f == QImage::Format_ARGB32
+        || f == QImage::Format_ARGB32_Premultiplied;
+}
+
+} // namespace
+
+namespace FrameScaler {
+
+const char *kernelName()
+{
+    return kernel().name;
+}
+
+bool downscale(const QImage &src, const QRect &srcRect, QImage &dst)
+{
+    if (src.isNull() || dst.isNull() || !is32bit(src.format()) || dst.format() != src.format()) return false;
+    const QRect sr = srcRect.intersected(src.rect());
+    const int sw = sr.width(), sh = sr.height();
+    const int dw = dst.width(), dh = dst.height();
+    const int kx = sw / dw, ky = sh / dh;
+    if (kx < 2 || ky < 2) return false;
+
+    // 세로 누적 버퍼(줄 하나, 바이트당 16비트): 255 × ky가 16비트에 들어가야 함
+    if (255 * ky > 0xFFFF) return false;
+    const int rowBytes = sw * 4;
+    static thread_local std::vector<quint16> acc;   // UI 스레드에서 재사용(프레임마다 할당하지 않음)
+    acc.resize(size_t(rowBytes));
+    // 출력 열 → 누적 버퍼 시작 위치(픽셀마다 나눗셈을 하지 않도록 호출당 한 번 계산)
+    static thread_local std::vector<int> colStart;
+    colStart.resize(size_t(dw));
+    for (int x = 0; x < dw; ++x) colStart[size_t(x)] = int(qint64(x) * sw / dw) * 4;
+
+    // 평균 = (합 + n/2) × (2^16 / n) >> 16 (n = kx·ky), 반올림 포함. 합 최대 255·n → 곱은 32비트 안
+    const quint32 n = quint32(kx * ky);
+    const quint32 inv = (65536u + n / 2) / n;
+    const quint32 half = n / 2;
+    const AddRowFn addRow = kernel().addRow;
+#ifdef FRAME_SCALER_SSE2
+    const ReduceRowFn reduceRow = 255 * n + half <= 0xFFFF ? reduceRowSse2 : reduceRowScalar;
+#else
+    const ReduceRowFn reduceRow = reduceRowScalar;
+#endif
+
+    for (int y = 0; y < dh; ++y) {
+        const int y0 = sr.top() + int(qint64(y) * sh / dh);
+        std::fill(acc.begin(), acc.end(), quint16(0));
+        for (int r = 0; r < ky; ++r)
+            addRow(src.constScanLine(y0 + r) + sr.left() * 4, acc.data(), rowBytes);
+
+        reduceRow(acc.data(), colStart.data(), dst.scanLine(y), dw, kx, inv, half);
+    }
+    return true;
+}
+
+} // namespace FrameScaler
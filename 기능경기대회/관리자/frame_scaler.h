@@ -0,0 +1,42 @@
+#pragma once
+/**
+ * @file frame_scaler.h
+ * @brief 카메라 타일용 면적 평균(box) 축소 — SSE2/AVX2 커널 + 스칼라 대체 경로.
+ *
+ * 배경
+ *  - 같은 카메라를 큰 뷰와 작은 타일이 함께 보면 소스는 큰 쪽 크기로 디코드하고,
+ *    작은 타일은 매 프레임 Qt의 범용 SmoothTransformation으로 다시 줄였다.
+ *    4분할 화면에서는 이 축소가 프레임당 CPU의 큰 몫을 차지했다.
+ *
+ * 방식
+ *  - 출력 한 픽셀 = 원본의 kx × ky 블록 평균(kx = ⌊원본 너비 / 출력 너비⌋, ky도 같은 방식).
+ *    블록 시작은 x·(원본/출력)로 잡으므로 정수가 아닌 비율(640→213 등)도 처리.
+ *  - 두 단계:
+ *    · 세로: 출력 한 줄마다 원본 ky줄을 16비트 누적 버퍼에 더함 ← 원본 바이트 전부를 읽는 단계(SIMD)
+ *    · 가로: 누적 버퍼에서 kx칸씩 더해 역수 곱(고정소수점)으로 평균
+ *      (블록 합이 16비트에 들어가면 SSE2로 한 픽셀 4채널을 한 번에)
+ *  - 채널 구분 없이 바이트 단위로 평균하므로 RGB32/ARGB32 모두 그대로 적용.
+ *
+ * 제약
+ *  - 가로·세로 모두 2배 이상 축소일 때만 사용(그보다 작은 비율은 박스 필터가 최근접과 같아짐).
+ *    조건이 맞지 않으면 false → 호출자는 기존 Qt 경로로 그린다.
+ *  - 커널은 실행 시 CPU 기능으로 선택(AVX2 → SSE2 → 스칼라).
+ */
+
+#include <QImage>
+#include <QRect>
+
+namespace FrameScaler {
+
+/**
+ * @brief src의 srcRect 구간을 dst 크기로 면적 평균 축소
+ * @param dst 호출자가 보유한 출력 버퍼(크기/포맷을 유지하면 프레임 간 재할당 없음).
+ *            src와 같은 32비트 포맷이어야 함.
+ * @return 처리했으면 true, 지원하지 않는 포맷/비율이면 false(dst는 건드리지 않음)
+ */
+bool downscale(const QImage &src, const QRect &srcRect, QImage &dst);
+
+/// 현재 CPU에서 선택된 세로 누적 커널 이름("avx2" / "sse2" / "scalar") — 진단용
+const char *kernelName();
+
+} // namespace FrameScaler
@@ -0,0 +1,112 @@
+/**
+ * @file frame_scaler_bench.cpp
+ * @brief FrameScaler::downscale과 QImage::scaled(SmoothTransformation) 비교 마이크로벤치마크.
+ *
+ * 빌드(기본 꺼짐):
+ *   cmake -S . -B build -DBUILD_BENCHMARKS=ON && cmake --build build --target frame_scaler_bench
+ * 실행:
+ *   ./frame_scaler_bench [반복 횟수=200]
+ *
+ * 출력: 원본 → 타일 크기별 프레임당 평균 시간(µs)과 배율, 두 결과의 채널 최대 차이(참고용 —
+ *       Qt 보간은 면적 평균이 아니므로 0이 아니어도 정상).
+ *       이어서 흰 화면 큰 배율 축소의 포화 검사 — 흰색이 아닌 픽셀이 있으면 종료 코드 1.
+ */
+
+#include "frame_scaler.h"
+#include <QElapsedTimer>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QSize>
+#include <QString>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// 카메라 프레임 흉내: 부드러운 그라데이션 + 잡음(완전 난수보다 실제 영상에 가까운 캐시/분기 특성)
+QImage makeFrame(const QSize &size)
+{
+    QImage img(size, QImage::Format_RGB32);
+    QRandomGenerator rng(42);
+    for (int y = 0; y < img.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(img.scanLine(y));
+        for (int x = 0; x < img.width(); ++x) {
+            const int n = int(rng.bounded(32));
+            line[x] = qRgb((x * 255 / img.width() + n) & 0xFF, (y * 255 / img.height() + n) & 0xFF, (x + y + n) & 0xFF);
+        }
+    }
+    return img;
+}
+
+int maxDiff(const QImage &a, const QImage &b)
+{
+    int worst = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const uchar *pa = a.constScanLine(y);
+        const uchar *pb = b.constScanLine(y);
+        for (int i = 0; i < a.width() * 4; ++i) worst = qMax(worst, std::abs(int(pa[i]) - int(pb[i])));
+    }
+    return worst;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const int iters = argc > 1 ? qMax(1, std::atoi(argv[1])) : 200;
+    const struct { QSize src, dst; } cases[] = {
+        {{640, 480},   {320, 240}},
+        {{640, 480},   {213, 160}},   // 정수가 아닌 비율
+        {{1280, 720},  {320, 180}},
+        {{1920, 1080}, {480, 270}},
+        {{1920, 1080}, {240, 135}},
+    };
+
+    std::printf("kernel: %s, iterations: %d\n", FrameScaler::kernelName(), iters);
+    std::printf("%-22s %12s %12s %8s %8s\n", "src -> dst", "scaled(us)", "scaler(us)", "speedup", "maxdiff");
+    for (const auto &c : cases) {
+        const QImage src = makeFrame(c.src);
+        QImage dst(c.dst, src.format());
+        QImage ref;
+
+        // 첫 호출(버퍼 할당/커널 선택)은 재지 않음
+        ref = src.scaled(c.dst, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        FrameScaler::downscale(src, src.rect(), dst);
+
+        QElapsedTimer t;
+        t.start();
+        for (int i = 0; i < iters; ++i)
+            ref = src.scaled(c.dst, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        const double qtUs = t.nsecsElapsed() / 1000.0 / iters;
+
+        t.restart();
+        for (int i = 0; i < iters; ++i)
+            FrameScaler::downscale(src, src.rect(), dst);
+        const double ourUs = t.nsecsElapsed() / 1000.0 / iters;
+
+        const QString label = QString("%1x%2 -> %3x%4").arg(c.src.width()).arg(c.src.height())
+                                                      .arg(c.dst.width()).arg(c.dst.height());
+        std::printf("%-22s %12.1f %12.1f %7.1fx %8d\n", qPrintable(label), qtUs, ourUs,
+                    ourUs > 0 ? qtUs / ourUs : 0.0, maxDiff(ref, dst));
+    }
+
+    // 포화 확인: 큰 블록(18배 이상 축소, 스칼라 경로)에서 흰 화면이 그대로 흰색이어야 함
+    int failed = 0;
+    const struct { QSize src, dst; } whiteCases[] = {
+        {{1920, 1080}, {101, 56}},    // 19×19 블록
+        {{1280, 720},  {91, 31}},     // 14×23 블록
+    };
+    for (const auto &c : whiteCases) {
+        QImage src(c.src, QImage::Format_RGB32);
+        src.fill(Qt::white);
+        QImage dst(c.dst, src.format());
+        FrameScaler::downscale(src, src.rect(), dst);
+        QImage white(c.dst, src.format());
+        white.fill(Qt::white);
+        const int diff = maxDiff(white, dst);
+        std::printf("white %dx%d -> %dx%d: maxdiff %d%s\n", c.src.width(), c.src.height(),
+                    c.dst.width(), c.dst.height(), diff, diff ? "  FAIL" : "");
+        failed += diff != 0;
+    }
+    return failed ? 1 : 0;
+}
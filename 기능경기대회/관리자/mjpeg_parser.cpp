@@ -0,0 +1,375 @@
+#include "mjpeg_parser.h"
+#include <QIODevice>
+#include <QMutex>
+#include <cstring>
+
+namespace {
+
+constexpr int kMaxHeaderBytes = 16 * 1024;   // 파트 헤더 상한(넘으면 손상으로 보고 재동기화)
+constexpr int kChunkBytes = 256 * 1024;      // 청크 기본 크기(640x480 JPEG 여러 장)
+constexpr int kReadStep = 16 * 1024;         // readFrom에서 최소로 확보할 빈 공간
+constexpr int kMaxSpare = 8;                 // 예비(아무도 안 쓰는) 청크 상한 — 녹화 링이 잡은 청크는 세지 않음
+
+const QByteArrayMatcher kSoi(QByteArray("\xFF\xD8", 2));
+const QByteArrayMatcher kCrlf(QByteArray("\r\n", 2));
+const QByteArrayMatcher kCrlf2(QByteArray("\r\n\r\n", 4));
+
+// Content-Type의 boundary 매개변수 추출(따옴표 허용)
+QByteArray boundaryOf(const QByteArray &contentType)
+{
+    const QByteArray lower = contentType.toLower();
+    if (!lower.startsWith("multipart/")) return {};
+    const int at = lower.indexOf("boundary=");
+    if (at < 0) return {};
+    QByteArray b = contentType.mid(at + 9);
+    const int semi = b.indexOf(';');
+    if (semi >= 0) b.truncate(semi);
+    b = b.trimmed();
+    if (b.size() >= 2 && b.startsWith('"') && b.endsWith('"')) b = b.mid(1, b.size() - 2);
+    if (b.startsWith("--")) b.remove(0, 2);   // 일부 서버는 "--"까지 적어 보냄
+    return b;
+}
+
+} // namespace
+
+/*
+ * 다 쓴 청크의 반환 창구. put()은 청크의 마지막 참조가 놓인 스레드(디코드 워커일 수 있음)에서,
+ * take()는 파서 스레드에서 불린다. shared_ptr 참조 해제 → 삭제자 → 뮤텍스 순으로 이어지므로
+ * 워커의 마지막 읽기가 파서의 다음 쓰기보다 먼저임이 보장된다.
+ */
+class MjpegParser::ChunkPool {
+public:
+    ~ChunkPool() { qDeleteAll(m_free); }
+
+    void put(QByteArray *chunk)
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            if (m_free.size() < kMaxSpare) { m_free.append(chunk); return; }
+        }
+        delete chunk;
+    }
+
+    QByteArray *take(int min)
+    {
+        QMutexLocker lock(&m_mutex);
+        for (int i = 0; i < m_free.size(); ++i)
+            if (m_free[i]->size() >= min) return m_free.takeAt(i);
+        return nullptr;
+    }
+
+private:
+    QMutex m_mutex;
+    QList<QByteArray*> m_free;
+};
+
+QByteArray MjpegParser::Part::header(const QByteArray &name) const
+{
+    for (const auto &h : headers)
+        if (h.first == name) return h.second;
+    return {};
+}
+
+MjpegParser::MjpegParser(int maxPartBytes)
+    : m_pool(std::make_shared<ChunkPool>()), m_maxPart(maxPartBytes)
+{
+}
+
+void MjpegParser::setContentType(const QByteArray &contentType)
+{
+    const QByteArray b = boundaryOf(contentType);
+    if (b.isEmpty()) return;   // 판별은 데이터로(Detect)
+    m_delim     = "--" + b;
+    m_bodyDelim = "\r\n" + m_delim;
+    m_delimMatch.setPattern(m_delim);
+    m_bodyDelimMatch.setPattern(m_bodyDelim);
+    if (m_state == State::Detect) m_state = State::Boundary;
+}
+
+void MjpegParser::reset()
+{
+    m_chunk.reset();        // 조각이 남아 있으면 마지막 조각과 함께 예비 목록으로
+    m_end = m_head = m_scan = 0;
+    m_state = State::Detect;
+    m_delim.clear();
+    m_bodyDelim.clear();
+    m_length = -1;
+    m_headers.clear();
+    m_jpegStart = -1;
+    m_walk = 0;
+    m_inEntropy = false;
+}
+
+void MjpegParser::feed(const QByteArray &data)
+{
+    if (data.isEmpty()) return;
+    reserve(int(data.size()));
+    std::memcpy(m_chunk->data() + m_end, data.constData(), size_t(data.size()));
+    m_end += int(data.size());
+}
+
+qint64 MjpegParser::readFrom(QIODevice *dev)
+{
+    qint64 total = 0;
+    while (dev->bytesAvailable() > 0) {
+        reserve(int(qBound<qint64>(kReadStep, dev->bytesAvailable(), kChunkBytes)));
+        const qint64 n = dev->read(m_chunk->data() + m_end, m_chunk->size() - m_end);
+        if (n <= 0) break;
+        m_end += int(n);
+        total += n;
+    }
+    return total;
+}
+
+/*
+ * 청크 끝 빈 공간이 모자랄 때만 호출되는 정리 단계: 예비 청크로 미완성 구간만 옮기고 이전 청크를 놓음.
+ * 이전 청크는 제자리에서 당겨 쓰지 않는다 — 조각이 남았는지는 참조 해제(삭제자)로만 안전하게 알 수 있다.
+ * 빈 공간에 쓰는 것은 조각이 있어도 안전하다(조각은 이미 소비한 앞부분만 가리킴).
+ */
+void MjpegParser::reserve(int need)
+{
+    if (m_chunk && m_chunk->size() - m_end >= need) return;
+
+    const int live = m_end - m_head;
+    std::shared_ptr<QByteArray> fresh = takeChunk(live + need);
+    if (live > 0) std::memcpy(fresh->data(), m_chunk->constData() + m_head, size_t(live));
+    m_chunk = std::move(fresh);   // 이전 청크: 마지막 조각이 사라질 때 예비 목록으로
+    // 모든 위치를 같이 이동
+    m_scan -= m_head;
+    if (m_jpegStart >= 0) m_jpegStart -= m_head;
+    m_walk = qMax(0, m_walk - m_head);
+    m_end = live;
+    m_head = 0;
+}
+
+std::shared_ptr<QByteArray> MjpegParser::takeChunk(int min)
+{
+    QByteArray *chunk = m_pool->take(min);
+    if (!chunk) {
+        ++m_allocs;
+        chunk = new QByteArray(qMax(kChunkBytes, min), Qt::Uninitialized);
+    }
+    // 삭제자가 풀을 붙잡으므로 파서가 먼저 사라져도 조각은 안전하게 반환/해제됨
+    std::shared_ptr<ChunkPool> pool = m_pool;
+    return std::shared_ptr<QByteArray>(chunk, [pool](QByteArray *c) { pool->put(c); });
+}
+
+int MjpegParser::find(const QByteArrayMatcher &m, int from) const
+{
+    if (!m_chunk || from >= m_end) return -1;
+    return int(m.indexIn(m_chunk->constData(), m_end, from));
+}
+
+void MjpegParser::discardTo(int upTo)
+{
+    if (upTo <= m_head) return;
+    m_discarded += quint64(upTo - m_head);
+    m_head = upTo;
+    m_scan = qMax(m_scan, m_head);
+}
+
+bool MjpegParser::next(Part *out)
+{
+    while (true) {
+        switch (m_state) {
+        case State::Detect:
+            if (!detect()) return false;
+            break;
+
+        case State::Boundary: {
+            // 본문 뒤 줄바꿈은 정상 — 잡음으로 세지 않음
+            while (m_head < m_end && (buf()[m_head] == '\r' || buf()[m_head] == '\n')) ++m_head;
+            m_scan = qMax(m_scan, m_head);
+            const int at = find(m_delimMatch, m_scan);
+            if (at < 0) {
+                // 경계 일부가 끝에 걸쳐 있을 수 있으므로 그 길이만 남기고 버림
+                discardTo(qMax(m_head, m_end - int(m_delim.size()) + 1));
+                return false;
+            }
+            discardTo(at);   // 경계 앞 잡음(보통은 0바이트)
+            m_head = m_scan = at + int(m_delim.size());
+            m_headers.clear();
+            m_length = -1;
+            m_state = State::Headers;
+            break;
+        }
+
+        case State::Headers:
+            if (!readHeaders()) return false;
+            break;
+
+        case State::Body:
+            return readBody(out);
+
+        case State::Jpeg:
+            return readJpeg(out);
+        }
+    }
+}
+
+bool MjpegParser::detect()
+{
+    // 앞쪽 줄바꿈은 무시하고 첫 의미 있는 바이트로 판별
+    int i = m_head;
+    while (i < m_end && (buf()[i] == '\r' || buf()[i] == '\n')) ++i;
+    if (m_end - i < 2) return false;
+
+    if (buf()[i] == '-' && buf()[i + 1] == '-') {
+        const int eol = find(kCrlf, i);
+        if (eol < 0) {
+            if (m_end - i > 256) { m_state = State::Jpeg; return true; }   // 경계 줄이 이렇게 길 리 없음
+            return false;
+        }
+        m_delim     = QByteArray(buf() + i, eol - i).trimmed();
+        m_bodyDelim = "\r\n" + m_delim;
+        m_delimMatch.setPattern(m_delim);
+        m_bodyDelimMatch.setPattern(m_bodyDelim);
+        m_state     = State::Boundary;
+        m_scan      = i;
+        return true;
+    }
+    m_state = State::Jpeg;
+    m_scan  = m_head;
+    return true;
+}
+
+bool MjpegParser::readHeaders()
+{
+    // 경계 줄의 나머지("\r\n" 또는 종료 표시 "--")부터 빈 줄까지
+    const int end = find(kCrlf2, qMax(m_head, m_scan - 3));
+    if (end < 0) {
+        if (m_end - m_head > kMaxHeaderBytes) {
+            discardTo(m_end);
+            m_state = State::Boundary;
+            return true;
+        }
+        m_scan = m_end;
+        return false;
+    }
+
+    const QList<QByteArray> lines = QByteArray(buf() + m_head, end - m_head).split('\n');
+    for (int i = 1; i < lines.size(); ++i) {   // 0번은 경계 줄의 나머지
+        const QByteArray line = lines[i].trimmed();
+        const int colon = line.indexOf(':');
+        if (colon <= 0) continue;
+        const QByteArray name  = line.left(colon).trimmed().toLower();
+        const QByteArray value = line.mid(colon + 1).trimmed();
+        m_headers << qMakePair(name, value);
+        if (name == "content-length") {
+            bool ok = false;
+            const qint64 n = value.toLongLong(&ok);
+            m_length = (ok && n >= 0 && n <= m_maxPart) ? n : -1;
+        }
+    }
+    m_head = m_scan = end + 4;
+    m_state = State::Body;
+    return true;
+}
+
+bool MjpegParser::readBody(Part *out)
+{
+    int bodyEnd = -1, resume = -1;
+    if (m_length >= 0) {
+        // 길이를 알면 본문은 보지 않고 바로 자름
+        if (m_end - m_head < m_length) return false;
+        bodyEnd = resume = m_head + int(m_length);
+    } else {
+        const int at = find(m_bodyDelimMatch, m_scan);
+        if (at < 0) {
+            if (m_end - m_head > m_maxPart) {
+                discardTo(m_end);
+                m_state = State::Boundary;
+                return next(out);
+            }
+            // 경계가 끝에 걸쳐 있을 수 있는 만큼만 되돌아가 다음에 이어서 검색
+            m_scan = qMax(m_head, m_end - int(m_bodyDelim.size()) + 1);
+            return false;
+        }
+        bodyEnd = at;
+        resume = at + 2;   // "\r\n"을 건너뛰면 바로 경계
+    }
+
+    out->jpeg    = slice(m_head, bodyEnd);
+    out->headers = m_headers;
+    m_head = m_scan = resume;
+    m_state = State::Boundary;
+    return true;
+}
+
+bool MjpegParser::readJpeg(Part *out)
+{
+    while (true) {
+        if (m_jpegStart < 0) {
+            const int soi = find(kSoi, m_scan);
+            if (soi < 0) {
+                discardTo(qMax(m_head, m_end - 1));   // FF 하나가 끝에 걸쳐 있을 수 있음
+                return false;
+            }
+            discardTo(soi);
+            m_jpegStart = soi;
+            m_walk = soi + 2;
+            m_inEntropy = false;
+        }
+
+        const int end = walkJpeg();
+        if (end == -1) {
+            if (m_end - m_jpegStart > m_maxPart) {
+                // 끝이 안 보이는 거대한 프레임 → 버리고 다음 SOI부터
+                m_scan = m_jpegStart + 2;
+                m_jpegStart = -1;
+                discardTo(m_scan);
+                continue;
+            }
+            return false;
+        }
+        if (end == -2) {
+            // 세그먼트 구조가 깨짐 → 이 SOI는 가짜로 보고 그다음부터 다시
+            m_scan = m_jpegStart + 2;
+            m_jpegStart = -1;
+            discardTo(m_scan);
+            continue;
+        }
+
+        out->jpeg = slice(m_jpegStart, end);
+        out->headers.clear();
+        m_head = m_scan = end;
+        m_jpegStart = -1;
+        return true;
+    }
+}
+
+int MjpegParser::walkJpeg()
+{
+    const auto *d = reinterpret_cast<const uchar *>(buf());
+    const int n = m_end;
+
+    while (true) {
+        if (m_inEntropy) {
+            // 엔트로피 데이터: FF 00(스터핑)/FF D0~D7(RST)/FF FF(채움)는 데이터로 보고 다음 마커까지
+            for (; m_walk + 1 < n; ++m_walk) {
+                if (d[m_walk] != 0xFF) continue;
+                const uchar m = d[m_walk + 1];
+                if (m == 0x00 || m == 0xFF || (m >= 0xD0 && m <= 0xD7)) continue;
+                break;
+            }
+            if (m_walk + 1 >= n) return -1;
+            m_inEntropy = false;
+        }
+
+        if (m_walk + 2 > n) return -1;
+        if (d[m_walk] != 0xFF) return -2;
+        const uchar m = d[m_walk + 1];
+        if (m == 0xFF) { ++m_walk; continue; }                        // 채움 바이트
+        if (m == 0xD9) return m_walk + 2;                              // EOI
+        if (m == 0x01 || (m >= 0xD0 && m <= 0xD7)) { m_walk += 2; continue; }   // 길이 없는 마커
+        if (m == 0xD8) return -2;                                      // EOI 없이 새 SOI
+
+        // 길이 있는 세그먼트(APPn/DQT/DHT/SOF/SOS...): 통째로 건너뜀 → 안의 썸네일 마커는 보지 않음
+        if (m_walk + 4 > n) return -1;
+        const int len = (d[m_walk + 2] << 8) | d[m_walk + 3];
+        if (len < 2) return -2;
+        if (m_walk + 2 + len > n) return -1;
+        m_walk += 2 + len;
+        if (m == 0xDA) m_inEntropy = true;                             // SOS 다음은 엔트로피 데이터
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+/**
+ * @file mjpeg_parser.h
+ * @brief multipart/x-mixed-replace(MJPEG over HTTP) 증분 파서.
+ *
+ * 배경
+ *  - 기존 뷰어는 readyRead마다 버퍼 처음부터 FFD8/FFD9를 다시 찾았다.
+ *    · 아직 끝나지 않은 프레임을 매번 재검색
+ *    · EXIF 썸네일 안의 FFD9에서 프레임을 잘못 자름
+ *    · 경계를 못 찾으면 1MB에서 버퍼를 통째로 버림
+ *
+ * 동작
+ *  - multipart: 경계(--boundary) → 파트 헤더 → 본문 순으로 읽는다.
+ *    · Content-Length가 있으면 그 길이만큼 그대로 잘라냄(본문은 검색하지 않음)
+ *    · 없으면 다음 경계("\r\n--boundary")를 찾아 본문 끝으로 삼음
+ *  - multipart가 아니면(경계가 없는 JPEG 연속 스트림) JPEG 세그먼트를 길이 필드로 건너뛰며
+ *    엔트로피 데이터 안에서만 EOI를 찾는다 → APPn 안의 썸네일 마커에 속지 않음.
+ *  - 모든 검색은 지난번에 멈춘 위치에서 이어서 한다(m_scan/m_walk).
+ *
+ * 버퍼(복사/할당 최소화)
+ *  - 수신 데이터는 고정 크기 청크(kChunkBytes)에 직접 읽어 넣는다(readFrom: readAll 임시 배열 없음).
+ *  - 완성 프레임은 복사하지 않고 청크의 한 구간(FrameSlice)으로 넘긴다. 조각은 청크를 공유 소유하므로
+ *    디코드 워커/녹화 링이 쥐고 있는 동안 그 바이트는 그대로 유지된다.
+ *  - 청크가 차면 예비 청크로 미완성 파트만 옮기고 이전 청크의 참조를 놓는다.
+ *    청크는 마지막 조각이 사라질 때(어느 스레드든) 삭제자가 예비 목록(ChunkPool, 뮤텍스 보호)으로
+ *    돌려보낸다 → 파서는 목록에서 꺼낸 청크만 다시 쓰므로 워커가 읽는 중인 바이트를 덮어쓰지 않고,
+ *    정상 상태에서는 프레임당 할당이 없다(녹화 링이 잡은 청크는 링에서 밀려날 때 돌아옴).
+ *
+ * 사용
+ *   parser.setContentType(reply->header(QNetworkRequest::ContentTypeHeader).toByteArray());
+ *   parser.readFrom(reply);             // 또는 parser.feed(bytes)
+ *   MjpegParser::Part part;
+ *   while (parser.next(&part)) { ... part.jpeg.data(), part.jpeg.size() ... }
+ */
+
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QList>
+#include <QPair>
+#include <memory>
+
+class QIODevice;
+
+/**
+ * @brief 수신 청크의 한 구간(복사 없는 프레임 바이트)
+ *  - 값 복사 = 참조 복사(청크 공유). 마지막 조각이 사라지면 청크는 파서의 예비 목록으로 돌아감
+ *  - bytes()는 이 조각이 살아 있는 동안만 유효한 QByteArray(fromRawData)
+ */
+class FrameSlice {
+public:
+    FrameSlice() = default;
+    /// 파서를 거치지 않은 JPEG(단일 프레임 폴링 등)을 조각으로 감쌈(암시적 공유, 복사 없음)
+    static FrameSlice fromByteArray(const QByteArray &bytes)
+    {
+        return FrameSlice(std::make_shared<const QByteArray>(bytes), 0, int(bytes.size()));
+    }
+    const char *data() const { return m_chunk ? m_chunk->constData() + m_off : nullptr; }
+    int size() const { return m_len; }
+    bool isEmpty() const { return m_len == 0; }
+    /// 복사 없는 QByteArray 보기(조각보다 오래 쓰면 안 됨 — 조각을 함께 들고 다닐 것)
+    QByteArray bytes() const { return QByteArray::fromRawData(data(), m_len); }
+    /// 독립 사본(조각 수명과 무관하게 보관해야 할 때)
+    QByteArray toByteArray() const { return QByteArray(data(), m_len); }
+
+private:
+    friend class MjpegParser;
+    FrameSlice(std::shared_ptr<const QByteArray> chunk, int off, int len)
+        : m_chunk(std::move(chunk)), m_off(off), m_len(len) {}
+    std::shared_ptr<const QByteArray> m_chunk;
+    int m_off = 0;
+    int m_len = 0;
+};
+
+class MjpegParser {
+public:
+    /// 분리된 파트 하나
+    struct Part {
+        FrameSlice jpeg;                                  ///< JPEG 본문(수신 청크의 구간, 복사 없음)
+        QList<QPair<QByteArray, QByteArray>> headers;     ///< 파트 헤더(이름은 소문자, 값은 앞뒤 공백 제거)
+        /// 헤더 값(없으면 빈 값). name은 소문자로
+        QByteArray header(const QByteArray &name) const;
+    };
+
+    /// @param maxPartBytes 파트 하나의 상한(넘으면 그 파트를 버리고 다음 경계/SOI로 재동기화)
+    explicit MjpegParser(int maxPartBytes = 8 << 20);
+
+    /**
+     * @brief 응답 Content-Type으로 모드 결정
+     *  - "multipart/...; boundary=xxx" → 해당 경계 사용
+     *  - 그 외/빈 값 → 첫 데이터에서 자동 판별("--"로 시작하면 그 줄을 경계로, 아니면 JPEG 연속 모드)
+     */
+    void setContentType(const QByteArray &contentType);
+
+    /// 수신 데이터 추가(청크에 복사)
+    void feed(const QByteArray &data);
+    /// 장치에서 읽을 수 있는 만큼 청크에 바로 읽어 넣음(readAll 임시 배열 없음). 읽은 바이트 수 반환
+    qint64 readFrom(QIODevice *dev);
+
+    /// 완성된 다음 파트를 꺼냄. 없으면 false(데이터가 더 와야 함)
+    bool next(Part *out);
+
+    /// 상태/버퍼 초기화(재연결 시). 경계 설정도 지움
+    void reset();
+
+    /// 재동기화 등으로 버린 바이트 누계(손상/잡음 진단용)
+    quint64 discardedBytes() const { return m_discarded; }
+    /// 현재 미처리 버퍼 크기
+    int buffered() const { return m_end - m_head; }
+    /// 지금까지 새로 할당한 청크 수(재사용이 잘 되면 연결당 몇 개에서 멈춤)
+    quint64 chunkAllocations() const { return m_allocs; }
+
+private:
+    enum class State {
+        Detect,     ///< 모드 미정(첫 데이터 대기)
+        Boundary,   ///< 다음 경계 줄 찾는 중
+        Headers,    ///< 파트 헤더 끝(빈 줄) 찾는 중
+        Body,       ///< 본문 수신 중
+        Jpeg,       ///< 경계 없는 JPEG 연속 스트림
+    };
+
+    bool detect();                  ///< Detect: 모드 결정(결정되면 true)
+    bool readHeaders();             ///< Headers → Body(헤더가 다 오면 true)
+    bool readBody(Part *out);       ///< Body: 본문이 다 오면 out 채우고 true
+    bool readJpeg(Part *out);       ///< Jpeg: SOI~EOI 하나를 out에 채우면 true
+    /// m_walk부터 JPEG 세그먼트를 따라가 EOI 다음 위치 반환. -1 = 데이터 부족, -2 = 손상
+    int walkJpeg();
+    /// [m_head, upTo) 구간을 버림(버린 양 집계)
+    void discardTo(int upTo);
+    /// 청크 끝에 need 바이트 이상 빈 공간 확보(제자리 압축 또는 예비 청크로 이동)
+    void reserve(int need);
+    /// min 이상 크기의 청크(예비 목록에서, 없으면 새로). 마지막 참조가 놓이면 예비 목록으로 돌아감
+    std::shared_ptr<QByteArray> takeChunk(int min);
+    const char *buf() const { return m_chunk ? m_chunk->constData() : nullptr; }
+    int find(const QByteArrayMatcher &m, int from) const;
+    FrameSlice slice(int from, int to) const { return FrameSlice(m_chunk, from, to - from); }
+
+    std::shared_ptr<QByteArray> m_chunk;   ///< 현재 수신 청크([m_head, m_end)가 미처리, 그 뒤는 빈 공간)
+    class ChunkPool;
+    std::shared_ptr<ChunkPool> m_pool;     ///< 예비 청크(조각보다 오래 살 수 있게 공유 소유)
+    quint64 m_allocs = 0;
+    int m_end = 0;                  ///< 청크 안 유효 데이터 끝
+    int m_head = 0;                 ///< 미처리 시작 위치
+    int m_scan = 0;                 ///< 다음 검색 시작 위치(이미 본 구간은 다시 보지 않음)
+    State m_state = State::Detect;
+    QByteArray m_delim;             ///< "--boundary"
+    QByteArray m_bodyDelim;         ///< "\r\n--boundary"(Content-Length가 없을 때 본문 끝)
+    QByteArrayMatcher m_delimMatch;     ///< m_delim 검색기(패턴 전처리는 경계 설정 때 한 번)
+    QByteArrayMatcher m_bodyDelimMatch;
+    qint64 m_length = -1;           ///< 현재 파트의 Content-Length(-1 = 없음)
+    QList<QPair<QByteArray, QByteArray>> m_headers;   ///< 현재 파트 헤더
+    int m_jpegStart = -1;           ///< Jpeg 모드: 현재 프레임 SOI 위치(-1 = SOI 찾는 중)
+    int m_walk = 0;                 ///< Jpeg 모드: 세그먼트 탐색 위치
+    bool m_inEntropy = false;       ///< Jpeg 모드: SOS 뒤 엔트로피 데이터 안
+    int m_maxPart;
+    quint64 m_discarded = 0;
+};
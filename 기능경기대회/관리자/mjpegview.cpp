@@ -1,23 +1,25 @@
 #include "mjpegview.h"
-#include <QVBoxLayout>      // 내부에 정중앙 라벨을 꽉 채워 넣기 위한 단순 레이아웃
-#include <QNetworkRequest>  // HTTP 요청 헤더 조작(keep-alive 등)
-#include <QMouseEvent>      // 라벨 클릭 → clicked() 시그널 방출
+#include "frame_scaler.h"   // 2배 이상 축소는 SIMD 면적 평균 커널
+#include <QMouseEvent>      // 좌클릭 → clicked() 시그널 방출
+#include <QEvent>           // 창 상태 변경(최소화) 감지
+#include <QPainter>         // 프레임/상태 문구 직접 그리기
+#include <QPaintEvent>      // 다시 그릴 영역(지연 표본 판단)
+#include <QDateTime>        // 그리기 완료 시각
 
 /**
  * @brief MJPEG 스트림 단순 뷰어 구현
  *
  * 기능 초점:
- *  - HTTP(MJPEG) 응답 바디를 바이트 스트림으로 받아, JPEG 프레임 경계(FFD8~FFD9)를
- *    직접 파싱해 순차 렌더링합니다.
- *  - 연결/에러/종료 시 자동 재시도(지정 지연)로 스트림 복구를 시도합니다.
+ *  - StreamHub에서 URL의 공유 소스를 구독해, 소스가 디코드한 최신 프레임을 그립니다.
+ *  - 연결/에러/재연결은 소스가 처리하고, 뷰는 상태 문구만 표시합니다.
  *  - 최근 프레임을 캐시(m_lastImg)하여 리사이즈 시 재샘플링 표시 품질을 유지합니다.
- *  - UI는 중앙의 QLabel 하나만 사용(간단/저비용), 배경은 검정으로 고정.
+ *  - 자식 위젯 없이 paintEvent에서 직접 그림, 배경은 검정으로 고정.
  *
  * 설계 포인트:
- *  - QNetworkAccessManager를 이용한 단일 GET 스트림(keep-alive) 사용.
- *  - ReadyRead에서 바이트 누적 → parseBuffer()에서 SOI/EOI로 프레임 분리.
- *  - 오류/종료 시 stop()으로 네트워크 객체 안전 종료 후 재시도 타이머 구동.
- *  - 대용량/손상 버퍼 방지: 경계가 안 보이면 일정 크기 초과 시 버퍼 drop.
+ *  - 같은 카메라를 미리보기와 확대 보기가 함께 봐도 HTTP 연결/서버 렌더 루프/디코드는 하나.
+ *  - 뷰는 자기 표시 크기를 소스에 알려 주고(setHint), 소스는 구독자 중 최대 크기로 디코드.
+ *  - 뷰는 가시성도 알려 준다(setActive). 운영자가 근태/알림/설정 탭에 있는 동안
+ *    모니터링 타일의 스트림은 닫히고, 돌아오면 마지막 프레임을 보여 주며 바로 재개.
  */
 
 MjpegView::MjpegView(QWidget *parent): QWidget(parent) {
@@ -25,24 +27,12 @@ MjpegView::MjpegView(QWidget *parent): QWidget(parent) {
     setAttribute(Qt::WA_OpaquePaintEvent);
     setAttribute(Qt::WA_NoSystemBackground);
 
-    // 내부 레이아웃: 여백 0, 중앙 라벨 1개
-    auto lay = new QVBoxLayout(this);
-    lay->setContentsMargins(0,0,0,0);
-
-    // 초기 상태 표시용 라벨(스트림 준비 전까지 텍스트 출력)
-    m_label = new QLabel(this);
-    m_label->setAlignment(Qt::AlignCenter);
-    m_label->setText(QString::fromUtf8("미리보기 로딩중…"));
-    m_label->setStyleSheet("background:#000; color:#9aa; font-size:13px;"); // 검정 바탕에 흐린 회색 텍스트
-    lay->addWidget(m_label);
-
-    // 재시도 타이머: 연결 실패/종료 시 일정 시간 뒤 start() 재호출
-    connect(&m_retryTimer, &QTimer::timeout, this, &MjpegView::retry);
-    m_retryTimer.setSingleShot(true); // 1회성 타이머(수동 재시작)
+    // 초기 상태 문구(스트림 준비 전까지 표시)
+    m_status = QString::fromUtf8("미리보기 로딩중…");
 }
 
 MjpegView::~MjpegView() {
-    // 네트워크 핸들/버퍼 정리(안전 종료)
+    // 구독 해제(마지막 구독자면 허브가 잠시 뒤 연결 종료)
     stop();
 }
 
@@ -53,74 +43,172 @@ MjpegView::~MjpegView() {
 void MjpegView::setUrl(const QUrl &u){ m_url=u; }
 
 /**
- * @brief 스트림 시작(또는 재시작)
+ * @brief 스트림 구독 시작(또는 URL 변경 후 재구독)
  *
  * 동작:
- *  - 기존 연결/타이머를 정리(stop)한 뒤, 유효한 URL이면 GET 수행.
- *  - readyRead/finished/errorOccurred 신호를 수신하여 파이프라인 구성.
- *  - 화면에는 "연결 중…" 상태 텍스트 출력.
+ *  - 이미 같은 URL을 구독 중이면 그대로 둠(중복 구독/재연결 없음).
+ *  - 허브에서 공유 소스를 얻어 frameReady/statusChanged 연결.
+ *  - 소스에 최근 프레임이 있으면 바로 그림, 없으면 "연결 중…" 등 상태 텍스트 출력.
  */
 void MjpegView::start(){
-    m_retryTimer.stop();    // ✅ 겹치는 재시도 예약 무효화
-    stop();                 // 이전 연결/버퍼 완전 종료
+    if(m_source && StreamHub::keyOf(m_source->url()) == StreamHub::keyOf(m_url)) return;
+    stop();
     if(!m_url.isValid()) return;
 
-    QNetworkRequest req(m_url);
-    req.setRawHeader("Connection","keep-alive"); // 장시간 스트리밍 연결 힌트
-    m_reply = m_nam.get(req);
-
-    // 네트워크 수신 루프: 바디 수신 → 내부 버퍼 누적 → 프레임 분리
-    connect(m_reply,&QNetworkReply::readyRead, this,&MjpegView::onReadyRead);
-    // 서버/네트워크 종료: 재시도 타이머 가동
-    connect(m_reply,&QNetworkReply::finished,  this,&MjpegView::onFinished);
-    // 오류: 사용자 안내 → stop → 재시도 타이머
-    connect(m_reply,&QNetworkReply::errorOccurred, this,&MjpegView::onError);
+    m_active = isShown();
+    m_latency.clear();       // 다른 카메라의 표본이 섞이지 않게
+    m_pendingTiming = FrameTiming();
+    m_source = StreamHub::instance()->acquire(m_url, this, hintSize(), m_active);
+    m_source->setMaxFps(this, m_maxFps);
+    connect(m_source, &StreamSource::frameReady,    this, &MjpegView::drawFrame);
+    connect(m_source, &StreamSource::statusChanged, this, &MjpegView::showStatus);
+    connect(m_source, &StreamSource::statsUpdated,  this, &MjpegView::onStats);
 
-    m_label->setText(QString::fromUtf8("연결 중…"));
-    m_buf.clear();
+    if(!m_source->lastFrame().isNull()) drawFrame(m_source->lastFrame());
+    else showStatus(m_source->status());
 }
 
 /**
- * @brief 스트림/연결 정리
- *
- * 안전성:
- *  - reply 시그널을 모두 해제(disconnect)하여 중복 콜백 방지.
- *  - 정상 상태(NoError)에서만 abort() 호출(에러 상태에서 abort는 추가 에러를 유발할 수 있음).
- *  - reply는 deleteLater로 이벤트 루프에서 파괴 예약.
- *  - 누적 버퍼도 함께 초기화.
+ * @brief 구독 해제
+ * @details 소스 신호를 끊고 허브에 반납합니다. 연결 정리는 허브가 참조 계수로 판단.
  */
 void MjpegView::stop(){
-    if(m_reply){
-        disconnect(m_reply,nullptr,this,nullptr);
-        // 이미 에러 난 상태에서는 abort()를 호출하지 않음 (중복 에러 방지)
-        if (!m_reply->isFinished()
-            && m_reply->error() == QNetworkReply::NoError) {
-            m_reply->abort();
-        }
-        m_reply->deleteLater();
-        m_reply=nullptr;
+    if(!m_source) return;
+    disconnect(m_source, nullptr, this, nullptr);
+    StreamHub::instance()->release(m_source, this);
+    m_source = nullptr;
+}
+
+quint64 MjpegView::droppedFrames() const{
+    return m_source ? m_source->droppedFrames() : 0;
+}
+
+StreamStats MjpegView::stats() const{
+    return m_source ? m_source->stats() : StreamStats{};
+}
+
+void MjpegView::setStatsOverlay(bool on){
+    if(m_statsOverlay == on) return;
+    m_statsOverlay = on;
+    if(on && m_source) onStats(m_source->stats());
+    update();
+}
+
+LatencyStats MjpegView::latency() const{
+    LatencyStats ls = m_latency.compute(StreamHub::instance()->latencySloMs());
+    if(m_source && m_source->clock().synced()){
+        ls.synced = true;
+        ls.clockErrMs = m_source->clock().rttMs() / 2.0;
+    }
+    return ls;
+}
+
+void MjpegView::onStats(const StreamStats &st){
+    const LatencyStats ls = latency();
+    if(m_statsOverlay){
+        m_statsText = QString::fromUtf8("수신 %1 fps / 디코드 %2 fps%10\n"
+                                        "디코드 평균 %3 ms · p95 %4 ms\n"
+                                        "%5 · 버퍼 최고 %6 KB\n"
+                                        "드롭 %7 · 재연결 %8%9")
+            .arg(st.recvFps, 0, 'f', 1).arg(st.decodeFps, 0, 'f', 1)
+            .arg(st.decodeMeanMs, 0, 'f', 1).arg(st.decodeP95Ms, 0, 'f', 1)
+            .arg(st.bitrateText()).arg((st.bufferPeak + 1023) / 1024)
+            .arg(st.dropped).arg(st.reconnects)
+            .arg(!st.live ? QString::fromUtf8(" · 일시정지")
+                 : st.qualityLevel > 0 ? QString::fromUtf8(" · 품질 단계 %1").arg(st.qualityLevel) : QString())
+            .arg(st.fpsCap > 0 ? QString::fromUtf8(" (상한 %1)").arg(st.fpsCap) : QString());
+        if(ls.samples > 0)
+            m_statsText += QString::fromUtf8("\n지연 p50 %1 / p95 %2 ms · 망 %3 · 디코드 %4 · 그리기 %5%6")
+                .arg(ls.p50, 0, 'f', 0).arg(ls.p95, 0, 'f', 0)
+                .arg(ls.netP50, 0, 'f', 0).arg(ls.decodeP50, 0, 'f', 0).arg(ls.paintP50, 0, 'f', 0)
+                .arg(ls.synced ? QString() : QString::fromUtf8(" (시계 미보정)"));
+        update(0, 0, width(), 96);   // 오버레이 영역만
+    }
+    emit statsUpdated(st);
+    emit latencyUpdated(ls);
+}
+
+void MjpegView::showStatus(const QString &text){
+    if(m_status == text) return;
+    m_status = text;
+    update();
+}
+
+void MjpegView::setFillMode(bool fill){
+    if(m_fillMode == fill) return;
+    m_fillMode = fill;
+    if(m_source) m_source->setHint(this, hintSize());
+    layoutFrame();
+    renderFrame();
+    update();
+}
+
+void MjpegView::setTileBudget(int maxFps, const QSize &maxSize){
+    m_maxFps = qMax(0, maxFps);
+    m_maxSize = maxSize;
+    if(m_source){
+        m_source->setMaxFps(this, m_maxFps);
+        m_source->setHint(this, hintSize());
     }
-    m_buf.clear();
+}
+
+QSize MjpegView::hintSize() const{
+    // Fill: 위젯을 덮도록(크롭될 쪽이 더 큼). 프레임 비율을 아직 모르면 위젯 크기
+    QSize hint = size();
+    if(m_fillMode && !m_lastImg.isNull())
+        hint = m_lastImg.size().scaled(size(), Qt::KeepAspectRatioByExpanding);
+    if(m_maxSize.isValid() && (hint.width() > m_maxSize.width() || hint.height() > m_maxSize.height()))
+        hint = hint.scaled(m_maxSize, Qt::KeepAspectRatio);
+    return hint;
+}
+
+bool MjpegView::isShown() const{
+    const QWidget *w = window();
+    return isVisible() && !(w && w->isMinimized());
+}
+
+void MjpegView::updateActive(){
+    const bool active = isShown();
+    if(active == m_active) return;
+    m_active = active;
+    if(m_source) m_source->setActive(this, active);
 }
 
 /**
- * @brief 재시도 타이머 만료 콜백
- * @details 이미 연결 시도 중(reply 존재)이면 재시작하지 않아 중복 연결을 막습니다.
+ * @brief 보일 때: 최상위 창에 최소화 감지 필터를 걸고(재배치로 창이 바뀌었을 수 있음) 활성 알림
  */
-void MjpegView::retry(){
-    if (!m_reply) start();  // ✅ 이미 시도 중이면 중복 start() 방지
+void MjpegView::showEvent(QShowEvent *e){
+    QWidget::showEvent(e);
+    QWidget *w = window();
+    if(w != m_watchedWindow){
+        if(m_watchedWindow) m_watchedWindow->removeEventFilter(this);
+        m_watchedWindow = w;
+        if(w && w != this) w->installEventFilter(this);
+    }
+    updateActive();
 }
 
 /**
- * @brief 리사이즈 시 최근 프레임을 현재 위젯 크기에 맞춰 리샘플링
- * @details m_lastImg 캐시를 사용해 즉각 품질 유지(새 프레임 대기 없음).
+ * @brief 숨겨질 때(스택 페이지 전환/창 숨김): 비활성 알림
+ */
+void MjpegView::hideEvent(QHideEvent *e){
+    QWidget::hideEvent(e);
+    updateActive();
+}
+
+bool MjpegView::eventFilter(QObject *obj, QEvent *e){
+    if(obj == m_watchedWindow && e->type() == QEvent::WindowStateChange) updateActive();
+    return QWidget::eventFilter(obj, e);
+}
+
+/**
+ * @brief 리사이즈 시 대상 사각형/축소 버퍼를 새 크기로 잡고 마지막 프레임으로 즉시 재그리기
+ * @details 캐시는 이전 크기로 디코드된 것이므로, 커진 경우 다음 프레임부터 새 크기로 선명해진다.
  */
 void MjpegView::resizeEvent(QResizeEvent *){
-    if(!m_lastImg.isNull()){
-        QPixmap px = QPixmap::fromImage(m_lastImg).scaled(
-            size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        m_label->setPixmap(px);
-    }
+    if(m_source) m_source->setHint(this, hintSize());   // 다음 프레임부터 새 크기 기준으로 디코드
+    layoutFrame();
+    renderFrame();
 }
 
 /**
@@ -133,87 +221,110 @@ void MjpegView::mousePressEvent(QMouseEvent *e){
 }
 
 /**
- * @brief 네트워크로부터 데이터 수신 시(조각 단위) 버퍼 누적 → 파싱 트리거
+ * @brief 새 프레임 수신: 크기가 바뀌었을 때만 배치를 다시 계산하고 표시 이미지 준비
  */
-void MjpegView::onReadyRead(){
-    if(!m_reply) return;
-    m_buf += m_reply->readAll();
-    parseBuffer();
+void MjpegView::drawFrame(const QImage &img, const FrameTiming &timing){
+    const bool sizeChanged = img.size() != m_lastImg.size();
+    m_lastImg = img;
+    m_pendingTiming = timing;   // 그리기 전에 덮어써진 프레임은 표본이 아님
+    if(sizeChanged){
+        layoutFrame();
+        if(m_fillMode && m_source) m_source->setHint(this, hintSize());   // 비율을 알게 됐으니 Fill 크기 갱신
+    }
+    renderFrame();
+    if(sizeChanged) update();
+    else update(m_target);   // 배치가 같으면 레터박스 영역은 다시 그릴 필요 없음
 }
 
-/**
- * @brief 스트림 종료(서버 닫힘/정상 종료 포함)
- * @details 먼저 stop()으로 정리 후, 일정 지연(1.5s) 뒤 자동 재시도.
- */
-// void MjpegView::onFinished(){ m_retryTimer.start(1500); }
-void MjpegView::onFinished(){
-    stop();                 // ✅ 먼저 정상 정리
-    m_retryTimer.start(1500);
+void MjpegView::layoutFrame(){
+    if(m_lastImg.isNull() || width() <= 0 || height() <= 0){
+        m_srcRect = m_target = QRect();
+        return;
+    }
+    const QSize img = m_lastImg.size();
+    if(m_fillMode){
+        // Fill: 위젯 전체가 대상, 원본은 위젯 비율로 가운데 크롭
+        m_target = rect();
+        const QSize crop = size().scaled(img, Qt::KeepAspectRatio);
+        m_srcRect = QRect(QPoint((img.width() - crop.width()) / 2, (img.height() - crop.height()) / 2), crop);
+    } else {
+        // Fit: 원본 전체, 대상은 비율 유지로 가운데(남는 곳은 검정 여백)
+        const QSize fit = img.scaled(size(), Qt::KeepAspectRatio);
+        m_target = QRect(QPoint((width() - fit.width()) / 2, (height() - fit.height()) / 2), fit);
+        m_srcRect = QRect(QPoint(0, 0), img);
+    }
 }
 
-/**
- * @brief 네트워크 오류 처리
- * @details 사용자에게 상태 텍스트를 보여주고, stop() 후 재시도 예약.
- */
-void MjpegView::onError(QNetworkReply::NetworkError){
-    m_label->setText(QString::fromUtf8("연결 오류, 재시도 중…"));
-    stop();
-    m_retryTimer.start(1500);
+void MjpegView::renderFrame(){
+    if(m_target.isEmpty()){
+        m_shown = QImage();
+        return;
+    }
+    // 디코드 단계에서 이미 대상 크기면 복사/축소 없이 그대로
+    if(m_srcRect.size() == m_target.size() && m_srcRect.topLeft().isNull()
+        && m_lastImg.size() == m_target.size()){
+        m_shown = m_lastImg;
+        return;
+    }
+    // 위젯 크기당 버퍼 하나: 크기가 같으면 같은 메모리에 덮어씀
+    // (m_shown이 이전 프레임 때 이 버퍼를 공유하고 있으면 먼저 놓아 줘야 분리 복사가 생기지 않음)
+    m_shown = QImage();
+    if(m_scaled.size() != m_target.size())
+        m_scaled = QImage(m_target.size(), QImage::Format_RGB32);
+    // 큰 공유 디코드를 작은 타일로 줄이는 경우(2배 이상)는 전용 커널, 그 외는 Qt 보간
+    if(FrameScaler::downscale(m_lastImg, m_srcRect, m_scaled)){
+        m_shown = m_scaled;
+        return;
+    }
+    QPainter p(&m_scaled);
+    p.setRenderHint(QPainter::SmoothPixmapTransform);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.drawImage(m_scaled.rect(), m_lastImg, m_srcRect);
+    p.end();
+    m_shown = m_scaled;
 }
 
 /**
- * @brief 내부 누적 버퍼에서 JPEG 프레임을 분리/디코드/렌더링
- *
- * 파싱 전략:
- *  - JPEG SOI(0xFF 0xD8)부터 EOI(0xFF 0xD9)까지를 한 프레임으로 간주.
- *  - SOI가 없으면 다음 데이터 대기(버퍼가 비정상적으로 커지면 드랍).
- *  - SOI만 있고 EOI가 없으면 부분 프레임 → 다음 수신때까지 보관.
- *
- * 안정성:
- *  - 경계가 안 보이는 손상/이상 스트림 대비: 버퍼가 1MB를 넘으면 초기화.
- *  - 프레임을 성공 디코드하면 drawFrame()에서 리샘플링 및 화면 갱신.
+ * @brief 그리기: 여백은 검정, 프레임은 대상 사각형에 그대로(축소는 renderFrame에서 끝남)
+ *  - 프레임이 없거나 상태 문구가 있으면 가운데에 문구 표시(프레임 위에서는 반투명 띠)
  */
-void MjpegView::parseBuffer(){
-    // JPEG SOI(FFD8)/EOI(FFD9) 기준으로 프레임 분리
-    while(true){
-        int soi = m_buf.indexOf("\xFF\xD8", 0);
-        if(soi < 0) {
-            // SOI 자체가 없다면 프레임 시작점 대기.
-            // 너무 커지면 스팸/손상 데이터로 보고 리셋.
-            if(m_buf.size() > (1<<20)) m_buf.clear();
-            break;
-        }
-        int eoi = m_buf.indexOf("\xFF\xD9", soi+2);
-        if(eoi < 0) {
-            // SOI는 있지만 EOI가 아직 없음 → 다음 수신까지 보류.
-            // 앞부분 잡음 제거: SOI 이전은 삭제하여 버퍼 누수 방지.
-            if(soi > 0) m_buf.remove(0, soi);
-            break;
-        }
+void MjpegView::paintEvent(QPaintEvent *e){
+    QPainter p(this);
+    if(m_shown.isNull()){
+        p.fillRect(rect(), Qt::black);
+    } else {
+        // 대상 사각형 밖(레터박스)만 칠하고 프레임은 한 번만 그림
+        const QRegion bars = QRegion(rect()).subtracted(m_target);
+        for(const QRect &r : bars) p.fillRect(r, Qt::black);
+        p.drawImage(m_target.topLeft(), m_shown);
+    }
 
-        // [SOI..EOI] 구간을 하나의 JPEG로 추출
-        int len = eoi - soi + 2;
-        QByteArray jpg = m_buf.mid(soi, len);
-        m_buf.remove(0, soi + len); // 사용한 구간 제거(다음 프레임 탐색 대비)
+    if(!m_status.isEmpty()){
+        QFont f = font();
+        f.setPixelSize(13);
+        p.setFont(f);
+        if(!m_shown.isNull()){
+            const QRect band(0, height() / 2 - 14, width(), 28);
+            p.fillRect(band, QColor(0, 0, 0, 160));
+        }
+        p.setPen(QColor("#99aaaa"));   // 검정 바탕에 흐린 회색 텍스트
+        p.drawText(rect(), Qt::AlignCenter, m_status);
+    }
 
-        // JPEG 디코드 → 성공 시 프레임 그리기
-        QImage img = QImage::fromData(jpg, "JPG");
-        if(!img.isNull()) drawFrame(img);
-        // 실패한 경우(깨진 프레임)는 조용히 건너뛰고 다음 루프 진행
+    if(m_statsOverlay && !m_statsText.isEmpty()){
+        QFont f = font();
+        f.setPixelSize(11);
+        p.setFont(f);
+        const QRect box = p.boundingRect(QRect(6, 6, width() - 12, 88), Qt::AlignLeft | Qt::AlignTop, m_statsText)
+                              .adjusted(-4, -3, 4, 3);
+        p.fillRect(box, QColor(0, 0, 0, 170));
+        p.setPen(QColor("#d1fae5"));
+        p.drawText(box.adjusted(4, 3, -4, -3), Qt::AlignLeft | Qt::AlignTop, m_statsText);
     }
-}
 
-/**
- * @brief 한 프레임을 현재 위젯 크기에 맞춰 비율 유지로 표시
- *
- *  - m_lastImg 캐시에 저장해 리사이즈 시 재활용.
- *  - QLabel 픽스맵으로 그려 flicker 없이 즉시 반영.
- */
-void MjpegView::drawFrame(const QImage &img){
-    m_lastImg = img;
-    // Fit: 비율 유지 + 프레임 전체 보이기 (여백 허용)
-    QPixmap px = QPixmap::fromImage(img).scaled(
-        size(), Qt::KeepAspectRatio, Qt::SmoothTransformation
-        );
-    m_label->setPixmap(px);
+    // 새 프레임 전체를 그린 그리기만 지연 표본(오버레이만 다시 그린 경우 제외)
+    if(m_pendingTiming.decodedMs > 0 && !m_shown.isNull() && e->rect().contains(m_target)){
+        m_latency.add(m_pendingTiming, QDateTime::currentMSecsSinceEpoch());
+        m_pendingTiming = FrameTiming();
+    }
 }
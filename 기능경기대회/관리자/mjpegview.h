@@ -2,27 +2,33 @@
 #define MJPEGVIEW_H
 
 #include <QWidget>                  // 위젯 기반 커스텀 뷰
-#include <QLabel>                   // 프레임 표시(픽스맵)용 단일 라벨
-#include <QNetworkAccessManager>    // HTTP 스트리밍(MJPEG) 수신
-#include <QNetworkReply>            // 비동기 응답/에러/종료 신호
-#include <QTimer>                   // 자동 재시도(백오프) 타이머
 #include <QUrl>                     // 대상 스트림 URL 표현
 #include <QImage>                   // 디코드된 JPEG 프레임 보관
+#include <QPointer>                 // 공유 소스 참조(허브가 정리할 수 있음)
+#include "stream_hub.h"             // StreamSource/StreamStats
+#include "frame_latency.h"          // FrameTiming/LatencyRecorder
 
 /**
  * @brief 단일 HTTP MJPEG 스트림 뷰어
  *
  * 기능 요약(무엇을 하는가):
- *  - HTTP 응답 바이트 스트림에서 JPEG 프레임 경계(0xFFD8~0xFFD9)를 직접 찾아 분리/디코딩.
- *  - 최신 프레임을 QLabel 픽스맵으로 그려 간단하고 저비용으로 렌더링.
- *  - 네트워크 종료/에러 시 stop()으로 안전 정리 후 지연 재시도(retry)로 연결 복구 시도.
- *  - 리사이즈 시 마지막 프레임을 고품질 리샘플링(SmoothTransformation)하여 즉시 반영.
+ *  - StreamHub의 공유 소스(StreamSource)를 구독해 최신 프레임을 표시.
+ *    같은 URL을 보는 뷰가 여럿이어도 HTTP 연결/디코드는 URL당 하나.
+ *  - 최신 프레임을 paintEvent에서 QImage 그대로 그림(프레임마다 QPixmap 변환/라벨 갱신 없음).
+ *  - 화면 맞춤 모드: Fit(비율 유지, 레터박스) / Fill(꽉 채우기, 가장자리 크롭).
+ *  - 스트림 통계(StreamStats): stats()/statsUpdated로 제공, 선택적으로 좌상단 오버레이.
+ *  - 캡처 → 화면 지연(LatencyStats): 그린 프레임마다 구간 시각을 모아 latency()/latencyUpdated로 제공.
  *
  * 설계 포인트:
- *  - 네트워크는 QNetworkAccessManager 하나와 단일 QNetworkReply로 관리(keep-alive).
- *  - 내부 누적 버퍼에 조각 단위로 적재 → SOI/EOI 스캔으로 프레임 분리(parseBuffer).
- *  - 과도한/손상 데이터 대비 버퍼 상한 체크로 누수/메모리 팽창 방지.
- *  - UI 스레드에서만 라벨 갱신(스레드 전환 없음).
+ *  - 수신/파싱/디코드/재연결은 StreamSource 담당(stream_hub.h 참고). 뷰는 표시 크기만 알려 준다.
+ *  - 구독 시 소스에 이미 프레임이 있으면 바로 그림(확대 보기를 열 때 첫 프레임 대기 없음).
+ *  - 가시성 추적: 숨겨지거나(스택 페이지 전환) 창이 최소화되면 소스에 비활성으로 알림
+ *    → 보이는 구독자가 없는 소스는 스트림을 닫고 저속 정지 화면 갱신으로 전환.
+ *  - 그리기 경로:
+ *    · 대상 사각형(m_target)은 위젯 크기/프레임 크기/모드가 바뀔 때만 다시 계산
+ *    · 프레임이 대상 크기와 같으면(디코드 단계에서 이미 맞춰진 경우) 복사 없이 그대로 그림
+ *    · 다르면 위젯 크기당 하나인 축소 버퍼(m_scaled)에 덮어써서 그림 — 버퍼는 프레임 간 재사용
+ *    · 2배 이상 축소는 FrameScaler(SIMD 면적 평균), 그 외 비율은 Qt 보간(frame_scaler.h 참고)
  */
 class MjpegView : public QWidget {
     Q_OBJECT
@@ -34,72 +40,115 @@ public:
     void setUrl(const QUrl &url);
     /// 현재 설정된 URL 반환(상태 조회용)
     QUrl url() const { return m_url; }
+    /// 소스에서 디코드하지 않고 버린(밀린) 프레임 누계(같은 URL의 뷰끼리 공유)
+    quint64 droppedFrames() const;
+
+    /// 구독 중인 소스의 최근 1초 통계(구독 전이면 기본값)
+    StreamStats stats() const;
+    /// 통계 오버레이(좌상단 반투명 박스) 표시 여부
+    void setStatsOverlay(bool on);
+    bool statsOverlay() const { return m_statsOverlay; }
+
+    /// 이 뷰가 그린 프레임의 캡처 → 화면 지연(최근 표본, 목표는 [stream] latency_slo_ms)
+    LatencyStats latency() const;
+
+    /// 화면 맞춤 모드: true = Fill(꽉 채우기, 크롭), false = Fit(비율 유지, 여백 허용)
+    void setFillMode(bool fill);
+    bool fillMode() const { return m_fillMode; }
+
+    /**
+     * @brief 타일 예산(영상 벽 등 여러 대를 함께 볼 때)
+     *  - maxFps: 이 뷰가 요구하는 디코드 fps 상한(0 = 제한 없음). 같은 소스의 다른 뷰(확대 보기 등)가
+     *    더 높게 요구하면 그쪽을 따름
+     *  - maxSize: 소스에 알릴 표시 크기 상한(비율 유지, invalid = 위젯 크기 그대로)
+     *    → 큰 화면에 타일이 커져도 디코드 해상도는 이 안에서 멈춤
+     */
+    void setTileBudget(int maxFps, const QSize &maxSize);
 
     /**
-     * @brief 스트림 수신 파이프라인 시작
-     * 동작: 기존 연결 정리 → 유효 URL이면 GET 시작 → readyRead/finished/error 신호 연결 →
-     *       라벨에 상태 텍스트 출력 및 버퍼 초기화.
+     * @brief 스트림 구독 시작
+     * 동작: 다른 URL을 구독 중이면 해제 → 허브에서 URL의 공유 소스를 얻어 frameReady/statusChanged 연결 →
+     *       소스에 최근 프레임이 있으면 즉시 표시, 없으면 상태 텍스트 출력.
      */
     void start();
 
     /**
-     * @brief 스트림/네트워크 핸들 정리
-     * 동작: reply 신호 해제 → 에러 없는 진행중일 때만 abort → deleteLater → 버퍼 초기화.
-     * 목적: 중복 콜백/에러를 막고 안전한 재시작/종료 보장.
+     * @brief 구독 해제
+     * 동작: 소스 신호 해제 → 허브에 반납(마지막 구독자면 잠시 뒤 연결 종료).
      */
     void stop();
 
 signals:
-    /// 라벨 좌클릭 신호(예: 전체 화면 전환/컨트롤 표시 등 상위 제어 트리거)
+    /// 좌클릭 신호(예: 전체 화면 전환/컨트롤 표시 등 상위 제어 트리거)
     void clicked();  // 미리보기 클릭(확대용)
+    /// 소스 통계 갱신(1초 주기, 같은 URL의 뷰끼리 같은 값)
+    void statsUpdated(const StreamStats &stats);
+    /// 지연 지표 갱신(statsUpdated와 같은 1초 주기, 뷰마다 다름 — 그리기 구간 포함)
+    void latencyUpdated(const LatencyStats &latency);
 
 protected:
-    /// 리사이즈 시 마지막 프레임을 현재 크기에 맞춰 비율 유지 스케일링하여 즉시 재그리기
+    /// 최신 프레임(또는 상태 문구)을 그림
+    void paintEvent(QPaintEvent *e) override;
+    /// 리사이즈 시 대상 사각형/축소 버퍼를 다시 잡고 마지막 프레임으로 즉시 재그리기
     void resizeEvent(QResizeEvent *e) override;
     /// 좌클릭을 clicked()로 래핑해 상위에서 제스처로 활용 가능하도록 노출
     void mousePressEvent(QMouseEvent *e) override;
-
-private slots:
-    /// 바디 수신: 조각 데이터를 내부 버퍼에 누적 후 프레임 분리(parseBuffer) 시도
-    void onReadyRead();
-    /// 서버가 연결을 닫거나 종료된 경우: stop() 후 재시도 타이머 기동
-    void onFinished();
-    /// 네트워크 오류: 상태 반영 → stop() → 재시도 타이머 기동
-    void onError(QNetworkReply::NetworkError);
-    /// 재시도 타이머 만료: 기존 reply가 없을 때에만 start() 호출(중복 연결 방지)
-    void retry();
+    /// 보이기/숨기기 → 소스에 활성 상태 반영
+    void showEvent(QShowEvent *e) override;
+    void hideEvent(QHideEvent *e) override;
+    /// 최상위 창의 최소화/복원 감지
+    bool eventFilter(QObject *obj, QEvent *e) override;
 
 private:
     /**
-     * @brief 디코드된 한 프레임을 QLabel 픽스맵으로 적용
-     *  - m_lastImg에 캐시해 리사이즈 시 즉시 재표시 품질 확보
-     *  - 스케일링 품질은 SmoothTransformation 사용
+     * @brief 디코드된 한 프레임을 받아 표시 준비(m_shown) 후 다시 그리기 예약
+     *  - m_lastImg에 보관해 리사이즈/모드 변경 시 즉시 재표시
+     *  - 크기가 다르면 축소 버퍼에 그려 넣음(FrameScaler, 안 되면 SmoothPixmapTransform)
+     *  - timing은 다음 paintEvent에서 지연 표본이 됨(그 전에 다음 프레임이 오면 덮어씀)
      */
-    void drawFrame(const QImage &img);
+    void drawFrame(const QImage &img, const FrameTiming &timing = {});
+    /// 위젯/프레임 크기와 모드로 원본 구간(m_srcRect)과 대상 사각형(m_target) 계산
+    void layoutFrame();
+    /// m_lastImg → m_shown(필요하면 m_scaled에 축소)
+    void renderFrame();
+    /// 소스에 알릴 표시 크기(Fill이면 위젯을 덮는 크기)
+    QSize hintSize() const;
 
-    /**
-     * @brief 내부 누적 버퍼에서 JPEG SOI/EOI(FFD8/FFD9) 경계를 찾아 프레임을 추출/디코드
-     * 안정성:
-     *  - SOI 미발견 상태에서 버퍼가 비정상적으로 커지면 드롭(스팸/손상 대비).
-     *  - SOI만 있고 EOI가 없으면 다음 데이터까지 보류(부분 프레임).
-     */
-    void parseBuffer(); // SOI/EOI 기준으로 JPEG 분리
+    /// 상태 문구 표시(빈 문자열 = 스트리밍 중 → 그대로 둠)
+    void showStatus(const QString &text);
+    /// 소스 통계 수신 → 오버레이 갱신 + statsUpdated 중계
+    void onStats(const StreamStats &stats);
+    /// 화면에 실제로 보이는지(숨김/최소화 아님)
+    bool isShown() const;
+    /// 가시성이 바뀌었으면 소스에 알림
+    void updateActive();
 
     /**
-     * @brief 화면 맞춤 모드(미사용 옵션 토글)
+     * @brief 화면 맞춤 모드
      *  - true: Fill(꽉 채우기, 크롭 가능)
-     *  - false: Fit(비율 유지, 레터박스 허용) — 현재 구현은 Fit 기준으로 drawFrame/resize에서 처리
+     *  - false: Fit(비율 유지, 레터박스 허용)
      */
     bool m_fillMode = false; // ← true면 Fill(꽉 채우기), false면 Fit(여백 허용)
 
     // ── 표시부/상태 ─────────────────────────────────────────────
-    QLabel *m_label{nullptr};        ///< 중앙 표시 라벨(픽스맵 적용 대상)
-    QNetworkAccessManager m_nam;     ///< 단일 HTTP 세션 관리자(앱 스레드에서 사용)
-    QNetworkReply *m_reply{nullptr}; ///< 진행중 응답 핸들(수신/종료/에러 신호 소스)
+    QString m_status;                ///< 상태 문구(연결 중/오류 등, 빈 값 = 스트리밍 중)
+    bool m_statsOverlay{false};      ///< 통계 오버레이 표시
+    QString m_statsText;             ///< 오버레이에 그릴 통계 문구(여러 줄)
     QUrl m_url;                      ///< 대상 스트림 URL
-    QByteArray m_buf;                ///< 조각 수신 누적 버퍼(프레임 경계 탐색용)
-    QImage m_lastImg;                ///< 최근 프레임 캐시(리사이즈 즉시 반영)
-    QTimer m_retryTimer;             ///< 자동 재시도 타이머(중복 시도 방지 로직 포함)
+    QImage m_lastImg;                ///< 최근 프레임(원본 크기 그대로, 리사이즈 즉시 반영)
+    QImage m_scaled;                 ///< 대상 크기 축소 버퍼(위젯 크기당 1개, 프레임 간 재사용)
+    QImage m_shown;                  ///< 실제로 그릴 이미지(m_lastImg 또는 m_scaled)
+    QRect m_srcRect;                 ///< m_lastImg에서 그릴 구간(Fill이면 가운데 크롭)
+    QRect m_target;                  ///< 위젯 안의 대상 사각형(Fit이면 레터박스 안쪽)
+    QPointer<StreamSource> m_source; ///< 구독 중인 공유 소스(허브 소유)
+    QPointer<QWidget> m_watchedWindow; ///< 최소화 감지용 이벤트 필터를 건 최상위 창
+    bool m_active{false};            ///< 소스에 마지막으로 알린 가시성
+    int m_maxFps{0};                 ///< 디코드 fps 상한(0 = 없음)
+    QSize m_maxSize;                 ///< 표시 크기 상한(invalid = 없음)
+
+    // ── 지연 측정 ───────────────────────────────────────────────
+    FrameTiming m_pendingTiming;     ///< 아직 그리지 않은 최신 프레임의 구간 시각
+    LatencyRecorder m_latency;       ///< 그린 프레임의 지연 표본
 };
 
 #endif // MJPEGVIEW_H
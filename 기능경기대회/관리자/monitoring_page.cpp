@@ -6,22 +6,28 @@
 #include <QMouseEvent>
 #include <QFrame>
 #include <QUrl>
+#include <QSettings>
+#include <QtMath>
 /*
  * 파일: monitoring_page.cpp
- * 개요: "모니터링" 탭/페이지 위젯. 출입구/화재 카메라 프리뷰를 보여주고,
- *       프리뷰를 클릭하면 시그널로 상위 창(메인 윈도우 등)에 선택 이벤트를 전달합니다.
- *       외부에서 setEntranceCamUrl(), setFireCamUrl()로 스트림 URL을 주입해 재생하도록 설계되었습니다.
+ * 개요: "모니터링" 탭/페이지 위젯. 설정된 카메라들을 N×M 격자(영상 벽)로 보여주고,
+ *       타일을 클릭하면 시그널로 상위 창(메인 윈도우 등)에 선택 이벤트를 전달합니다.
  *
  * 구성요소 요약:
- *   - buildUi(): 위젯/레이아웃 생성 및 MJPEG 뷰 연결
+ *   - buildUi(): 격자 레이아웃 생성
  *   - applyStyle(): 폰트/간격/색/여백 등 스타일 적용
- *   - setEntranceCamUrl(), setFireCamUrl(): 각 카메라 스트림 URL 설정 및 표시/재생
- *   - signals: entranceCamClicked(), fireCamClicked(), cameraSelected(name, url)
+ *   - loadCameras()/setCameras(): 카메라 목록 → 타일(카드) 생성, 타일마다 MjpegView 1개
+ *   - signals: cameraSelected(name, url)
+ *
+ * 타일 예산:
+ *   - 타일 뷰마다 fps/해상도 상한(setTileBudget)을 걸어 수신은 그대로 두고 디코드만 줄입니다.
+ *     같은 카메라를 확대 보기로 열면 그쪽은 상한이 없으므로 원래 속도/해상도로 디코드됩니다.
+ *   - 모든 타일의 디코드는 StreamHub의 공유 디코드 풀에서 돌고, 전역 예산(decode_budget_pct)을
+ *     넘으면 허브가 스트림 전체의 fps를 고르게 낮춥니다.
  *
  * 사용법:
  *   MonitoringPage* page = new MonitoringPage(this);
- *   page->setEntranceCamUrl("http://<ip>:<port>/stream1.mjpg");
- *   page->setFireCamUrl("http://<ip>:<port>/stream2.mjpg");
+ *   page->loadCameras(QCoreApplication::applicationDirPath() + "/admin_client.ini");
  *   connect(page, &MonitoringPage::cameraSelected, this, [&](const QString& name, const QString& url){{ /* 선택 반응 */ }});
  *
  * 작성자 주석: 아래에 함수/멤버별로 한국어 주석을 상세히 달아 두었습니다.
@@ -54,17 +60,11 @@ MonitoringPage::MonitoringPage(QWidget* parent)
 {
     buildUi();
     applyStyle();
-
-    // 상태 라벨 기본 숨김
-    entranceCamStatus->hide();
-    fireCamStatus->hide();
 }
 /**
  * @brief UI를 구성합니다.
- *  - 좌/우(또는 위/아래) 레이아웃에 출입구/화재 프리뷰 영역을 만듭니다.
- *  - 각 프리뷰에 MJPEG 뷰(MjpegView) 또는 라벨을 배치합니다.
- *  - 프리뷰를 클릭하면 해당 카메라가 선택되도록 시그널을 연결합니다
- *    (entranceCamClicked, fireCamClicked, cameraSelected(name, url)).
+ *  - 타일이 들어갈 격자와, 카메라가 하나도 없을 때의 안내 라벨만 만듭니다.
+ *  - 타일은 setCameras()에서 카메라 목록대로 만듭니다.
  */
 
 void MonitoringPage::buildUi() {
@@ -72,109 +72,17 @@ void MonitoringPage::buildUi() {
     root->setContentsMargins(16,16,16,16);
     root->setSpacing(12);
 
-    auto* grid = new QGridLayout;
-    grid->setHorizontalSpacing(16);
-    grid->setVerticalSpacing(16);
-
-    // ===== 카드 1: 출입 카메라 =====
-    {
-        auto* card = new QFrame(this);
-        card->setObjectName("camCard");
-        auto* v = new QVBoxLayout(card);
-        v->setContentsMargins(12,12,12,12);
-        v->setSpacing(8);
-
-        auto* title = new QLabel(u8"출입 카메라", card);
-        title->setObjectName("camTitle");
-
-        auto* view = new ClickLabel(card);
-        view->setObjectName("camView");
-        view->setMinimumSize(320, 180);
-        view->setAlignment(Qt::AlignCenter);
-        view->setText(u8"\n미리보기 자리\n(클릭하면 확대)");
-        entranceCamView = view;
-
-        entranceCamStatus = new QLabel(u8"URL: (없음)", card);
-        entranceCamStatus->setObjectName("camStatus");
-
-        v->addWidget(title);
-        v->addWidget(view, 1);
-        v->addWidget(entranceCamStatus);
-
-        grid->addWidget(card, 0, 0);
-
-        // 클릭 → 이름+URL 함께 알림(빈 경우 폴백 수행)
-        // 클릭 이벤트를 MonitoringPage의 시그널로 전달
-        
-        connect(view, &ClickLabel::clicked, this, [this]{
-            // URL 폴백: 미리보기 스트림에서 베이스 URL 추출
-            QString url = entranceUrl_;
-            if (url.isEmpty() && entranceStream && entranceStream->url().isValid()) {
-                QUrl u = entranceStream->url();   // 예: http://X.X.X.X:8000/mjpeg
-                if (u.path().startsWith("/mjpeg")) u.setPath(""); // 베이스만
-                url = u.toString();
-            }
-            emit entranceCamClicked();
-        // 사용자가 선택한 카메라 이름/URL을 상위에 알림
-        
-            emit cameraSelected(QStringLiteral("출입 카메라"), url);
-        });
-    }
-
-    // ===== 카드 2: 화재 감지 카메라 =====
-    {
-        auto* card = new QFrame(this);
-        card->setObjectName("camCard");
-        auto* v = new QVBoxLayout(card);
-        v->setContentsMargins(12,12,12,12);
-        v->setSpacing(8);
-
-        auto* title = new QLabel(u8"화재 감지 카메라", card);
-        title->setObjectName("camTitle");
-
-        auto* view = new ClickLabel(card);
-        view->setObjectName("camView");
-        view->setMinimumSize(320, 180);
-        view->setAlignment(Qt::AlignCenter);
-        view->setText(u8"\n미리보기 자리\n(클릭하면 확대)");
-        fireCamView = view;
-
-        fireCamStatus = new QLabel(u8"URL: (없음)", card);
-        fireCamStatus->setObjectName("camStatus");
-
-        v->addWidget(title);
-        v->addWidget(view, 1);
-        v->addWidget(fireCamStatus);
-
-        grid->addWidget(card, 0, 1);
-        // 클릭 이벤트를 MonitoringPage의 시그널로 전달
-        
+    grid_ = new QGridLayout;
+    grid_->setHorizontalSpacing(16);
+    grid_->setVerticalSpacing(16);
 
-        connect(view, &ClickLabel::clicked, this, [this]{
-            // 1) 기본은 설정된 fireUrl_
-            QString url = fireUrl_;
+    emptyLabel_ = new QLabel(u8"표시할 카메라가 없습니다.\n(admin_client.ini의 [camera]/[wall] 설정 확인)", this);
+    emptyLabel_->setObjectName("camStatus");
+    emptyLabel_->setAlignment(Qt::AlignCenter);
+    emptyLabel_->hide();
 
-            // 2) 비어있다면, 프리뷰 스트림에서 현재 URL을 가져와 사용
-            if (url.isEmpty() && fireStream && fireStream->url().isValid()) {
-                url = fireStream->url().toString();
-            }
-
-            // 3) 경로가 비어 있으면 /video_feed 붙여서 "완전한 스트림 URL" 보장
-            if (!url.isEmpty()) {
-                QUrl u(url);
-                if (u.path().isEmpty() || u.path() == "/")
-                    u.setPath("/video_feed");
-                url = u.toString();
-            }
-
-            emit fireCamClicked();
-        // 사용자가 선택한 카메라 이름/URL을 상위에 알림
-        
-            emit cameraSelected(QStringLiteral("화재 감지 카메라"), url);
-        });
-    }
-
-    root->addLayout(grid, 1);
+    root->addLayout(grid_, 1);
+    root->addWidget(emptyLabel_, 1);
 }
 /**
  * @brief 페이지 전반의 스타일을 적용합니다.
@@ -206,75 +114,101 @@ void MonitoringPage::applyStyle() {
     )");
 }
 /**
- * @brief 출입구 카메라 스트림 URL을 설정하고 화면에 반영합니다.
- *  - 유효한 URL이면 MjpegView에 재생을 요청하고 상태 라벨을 갱신합니다.
- *  - 빈 문자열이라면 "미설정" 등의 안내를 표시하며 재생을 중단합니다.
+ * @brief admin_client.ini에서 영상 벽 설정과 카메라 목록을 읽어 타일을 구성합니다.
+ *  - [wall] cameras가 없으면 [camera]의 모든 *_url 키(출입/화재 먼저)
+ *  - URL이 비어 있는 카메라도 자리는 만들어 "URL: (없음)"으로 표시(설정 누락을 바로 알 수 있도록)
  */
 
-void MonitoringPage::setEntranceCamUrl(const QString& url) {
-    entranceUrl_ = url;
-    if (entranceCamStatus)
-        entranceCamStatus->setText(url.isEmpty() ? u8"URL: (없음)" : u8"URL: " + url);
+void MonitoringPage::loadCameras(const QString& iniPath) {
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup("wall");
+    QStringList keys = ini.value("cameras").toString().split(',', Qt::SkipEmptyParts);
+    columns_     = qMax(0, ini.value("columns", 0).toInt());
+    tileFps_     = qMax(0, ini.value("tile_fps", 15).toInt());
+    tileMaxSize_ = QSize(ini.value("tile_max_width", 640).toInt(),
+                         ini.value("tile_max_height", 480).toInt());
+    ini.endGroup();
+
+    if (keys.isEmpty()) keys = CameraList::allKeys(iniPath);
+    setCameras(CameraList::load(iniPath, keys));
+}
+/**
+ * @brief 카메라 목록으로 타일을 다시 만듭니다.
+ *  - 기존 타일은 지우고(뷰가 파괴되며 스트림 구독도 반납) 새 목록대로 행 우선 배치
+ *  - 열 수: columns_(0이면 ⌈√n⌉ — 2대면 1×2, 4대 2×2, 16대 4×4)
+ *  - 타일이 많으면 최소 크기를 줄여 한 화면에 들어가게 함
+ */
 
-    // 여기서 미리보기 시작
-    if (!url.isEmpty()) {
-        const QUrl mjpeg(url + "/mjpeg");
-        if (!entranceStream) {
-            entranceStream = new MjpegView(entranceCamView);
-            auto lay = new QVBoxLayout(entranceCamView);
-            lay->setContentsMargins(0,0,0,0);
-            lay->addWidget(entranceStream);
-        }
-        entranceStream->setUrl(mjpeg);
-        entranceStream->start();
+void MonitoringPage::setCameras(const QList<CameraEntry>& cams) {
+    clearTiles();
+    emptyLabel_->setVisible(cams.isEmpty());
+    if (cams.isEmpty()) return;
+
+    const int n = int(cams.size());
+    const int cols = columns_ > 0 ? qMin(columns_, n) : qCeil(qSqrt(double(n)));
+    for (int i = 0; i < n; ++i) {
+        QWidget* tile = makeTile(cams[i], n > 4);
+        grid_->addWidget(tile, i / cols, i % cols);
+        tiles_ << tile;
     }
+    // 남는 공간은 행/열에 고르게(마지막 행이 덜 차도 타일 크기는 같게)
+    for (int c = 0; c < cols; ++c) grid_->setColumnStretch(c, 1);
+    for (int r = 0; r < (n + cols - 1) / cols; ++r) grid_->setRowStretch(r, 1);
 }
 
-// void MonitoringPage::setFireCamUrl(const QString& url) {
-//     fireUrl_ = url;
-//     if (fireCamStatus)
-//         fireCamStatus->setText(url.isEmpty() ? u8"URL: (없음)" : u8"URL: " + url);
-
-//     ❌ 지금은 화재 카메라 스트림을 시작하지 않음
-//     if (!url.isEmpty()) {
-//         const QUrl mjpeg(url + "/mjpeg");
-//         if (!fireStream) {
-//             fireStream = new MjpegView(fireCamView);
-//             auto lay = new QVBoxLayout(fireCamView);
-//             lay->setContentsMargins(0,0,0,0);
-//             lay->addWidget(fireStream);
-//         }
-//         fireStream->setUrl(mjpeg);
-//         fireStream->start();
-//     }
-// }
+void MonitoringPage::clearTiles() {
+    for (QWidget* t : std::as_const(tiles_)) {
+        grid_->removeWidget(t);
+        delete t;               // 자식 MjpegView 소멸자에서 구독 해제
+    }
+    tiles_.clear();
+    for (int c = 0; c < grid_->columnCount(); ++c) grid_->setColumnStretch(c, 0);
+    for (int r = 0; r < grid_->rowCount(); ++r) grid_->setRowStretch(r, 0);
+}
 /**
- * @brief 화재 감시 카메라 스트림 URL을 설정하고 화면에 반영합니다.
- *  - 유효한 URL이면 MjpegView에 재생을 요청하고 상태 라벨을 갱신합니다.
- *  - 빈 문자열이라면 "미설정" 등의 안내를 표시하며 재생을 중단합니다.
+ * @brief 카드 1장: 제목 + 미리보기(클릭하면 확대).
+ *  - compact: 타일이 많을 때 미리보기 최소 크기를 줄임(320×180 → 160×90)
+ *  - URL이 있으면 미리보기 안에 MjpegView를 채우고 타일 예산을 건 뒤 재생
+ *  - 클릭 → cameraSelected(이름, 스트림 URL)
  */
 
-void MonitoringPage::setFireCamUrl(const QString& url) {
-    fireUrl_ = url;
-    if (fireCamStatus)
-        fireCamStatus->setText(url.isEmpty() ? u8"URL: (없음)" : u8"URL: " + url);
+QWidget* MonitoringPage::makeTile(const CameraEntry& cam, bool compact) {
+    auto* card = new QFrame(this);
+    card->setObjectName("camCard");
+    auto* v = new QVBoxLayout(card);
+    v->setContentsMargins(12,12,12,12);
+    v->setSpacing(8);
 
-    // 🔧 화재 카메라 프리뷰 시작: /video_feed 사용
-    if (!url.isEmpty()) {
-        QUrl mjpeg(url);
-        // 경로가 비어 있으면 /video_feed를 붙여 완전한 스트림 URL을 만든다
-        if (mjpeg.path().isEmpty() || mjpeg.path() == "/")
-            mjpeg.setPath("/video_feed");
+    auto* title = new QLabel(cam.title, card);
+    title->setObjectName("camTitle");
+    title->setToolTip(cam.url.isValid() ? cam.url.toString() : u8"URL: (없음)");
 
-        if (!fireStream) {
-            fireStream = new MjpegView(fireCamView);
-            auto lay = new QVBoxLayout(fireCamView);
-            lay->setContentsMargins(0,0,0,0);
-            lay->addWidget(fireStream);
-        }
-        fireStream->setUrl(mjpeg);
-        fireStream->start();
+    auto* view = new ClickLabel(card);
+    view->setObjectName("camView");
+    view->setMinimumSize(compact ? QSize(160, 90) : QSize(320, 180));
+    view->setAlignment(Qt::AlignCenter);
+
+    v->addWidget(title);
+    v->addWidget(view, 1);
+
+    if (!cam.url.isValid()) {
+        view->setText(u8"\n미리보기 자리\nURL: (없음)");
+        return card;
     }
+
+    auto* stream = new MjpegView(view);
+    auto* lay = new QVBoxLayout(view);
+    lay->setContentsMargins(0,0,0,0);
+    lay->addWidget(stream);
+    stream->setTileBudget(tileFps_, tileMaxSize_);
+    stream->setUrl(cam.url);
+    stream->start();
+
+    // 클릭 이벤트를 MonitoringPage의 시그널로 전달(확대 보기는 같은 URL → 연결 공유)
+    connect(view, &ClickLabel::clicked, this, [this, cam]{
+        emit cameraSelected(cam.title, cam.url.toString());
+    });
+    return card;
 }
 
 #include "monitoring_page.moc"
@@ -2,63 +2,64 @@
 #pragma once
 /*
  * 파일: monitoring_page.h
- * 개요: "모니터링" 탭/페이지 위젯. 출입구/화재 카메라 프리뷰를 보여주고,
- *       프리뷰를 클릭하면 시그널로 상위 창(메인 윈도우 등)에 선택 이벤트를 전달합니다.
- *       외부에서 setEntranceCamUrl(), setFireCamUrl()로 스트림 URL을 주입해 재생하도록 설계되었습니다.
+ * 개요: "모니터링" 탭/페이지 위젯. 설정된 카메라들을 N×M 격자(영상 벽)로 보여주고,
+ *       타일을 클릭하면 시그널로 상위 창(메인 윈도우 등)에 선택 이벤트를 전달합니다.
+ *       카메라 목록/배치/타일 예산은 admin_client.ini에서 읽습니다(loadCameras()).
  *
  * 구성요소 요약:
- *   - buildUi(): 위젯/레이아웃 생성 및 MJPEG 뷰 연결
+ *   - buildUi(): 격자 레이아웃 생성
  *   - applyStyle(): 폰트/간격/색/여백 등 스타일 적용
- *   - setEntranceCamUrl(), setFireCamUrl(): 각 카메라 스트림 URL 설정 및 표시/재생
- *   - signals:   // 외부로 전달하는 이벤트. 프리뷰 클릭/선택 시 상위에 알립니다.
-entranceCamClicked(), fireCamClicked(), cameraSelected(name, url)
+ *   - loadCameras(): [wall]/[camera] 설정으로 타일을 다시 만듦
+ *   - setCameras(): 카메라 목록을 직접 지정(타일 재구성)
+ *   - signals: cameraSelected(name, url)
+ *
+ * 설정(admin_client.ini [wall]):
+ *   - cameras   : 표시할 [camera] 키 목록(쉼표 구분, 순서대로 배치). 없으면 [camera]의 모든 *_url
+ *   - columns   : 열 수(0 = 카메라 수에 맞춰 자동, 거의 정사각형)
+ *   - tile_fps  : 타일 하나의 디코드 fps 상한(기본 15, 0 = 제한 없음). 확대 보기는 영향받지 않음
+ *   - tile_max_width / tile_max_height : 타일 디코드 해상도 상한(기본 640×480, 비율 유지)
+ *   전체 CPU 예산은 [stream] decode_budget_pct(stream_hub.h)가 모든 스트림에 걸쳐 적용합니다.
  *
  * 사용법:
  *   MonitoringPage* page = new MonitoringPage(this);
- *   page->setEntranceCamUrl("http://<ip>:<port>/stream1.mjpg");
- *   page->setFireCamUrl("http://<ip>:<port>/stream2.mjpg");
+ *   page->loadCameras(QCoreApplication::applicationDirPath() + "/admin_client.ini");
  *   connect(page, &MonitoringPage::cameraSelected, this, [&](const QString& name, const QString& url){{ /* 선택 반응 */ }});
  *
  * 작성자 주석: 아래에 함수/멤버별로 한국어 주석을 상세히 달아 두었습니다.
  */
 #include <QWidget>
 #include <QString>
+#include <QList>
+#include <QSize>
+#include "camera_list.h"
 
 class QLabel;
+class QGridLayout;
 class MjpegView;
 
 class MonitoringPage : public QWidget {
     Q_OBJECT
 public:
     explicit MonitoringPage(QWidget* parent = nullptr);  // 생성자: 부모 위젯(없으면 nullptr). UI 구성 및 초기화 수행
-void setEntranceCamUrl(const QString& url);  // 출입구 카메라(MJPEG/HTTP 등) 스트림 URL 설정
-void setFireCamUrl(const QString& url);  // 화재 감시 카메라 스트림 URL 설정
+    void loadCameras(const QString& iniPath);             // [wall]/[camera] 설정으로 타일 구성
+    void setCameras(const QList<CameraEntry>& cams);      // 카메라 목록으로 타일 재구성(기존 타일/구독 정리)
 signals:
-      // 외부로 전달하는 이벤트. 프리뷰 클릭/선택 시 상위에 알립니다.
-void entranceCamClicked();  // 출입구 프리뷰가 클릭되었음을 알림
-void fireCamClicked();  // 화재 프리뷰가 클릭되었음을 알림
-void cameraSelected(const QString& name, const QString& url);  // 어떤 카메라가 선택되었는지 이름/URL을 함께 전달
-private:
-      // 내부 구현(헬퍼 함수/멤버 변수)
-void buildUi();  // 위젯과 레이아웃 생성, 클릭 시그널 연결 등
-void applyStyle();  // 폰트/여백/색상 등 스타일 적용
+    // 외부로 전달하는 이벤트. 프리뷰 클릭/선택 시 상위에 알립니다.
+    void cameraSelected(const QString& name, const QString& url);  // 어떤 카메라가 선택되었는지 이름/URL(스트림 URL)을 함께 전달
 private:
-      // 내부 구현(헬퍼 함수/멤버 변수)
-// 프리뷰 표시용 라벨들
-    QLabel* entranceCamView{  // 출입구 카메라 프리뷰 라벨(스냅샷/상태 텍스트 표기)
-};    // 좌측 카드
-    QLabel* entranceCamStatus{};  // 좌측 상태 라벨
-    QLabel* fireCamView{  // 화재 카메라 프리뷰 라벨
-};        // 우측 카드
-    QLabel* fireCamStatus{};      // 우측 상태 라벨
-
-    // URL 캐시
-    QString entranceUrl_;
-    QString fireUrl_;
+    // 내부 구현(헬퍼 함수/멤버 변수)
+    void buildUi();                                  // 격자/빈 목록 안내 생성
+    void applyStyle();                               // 폰트/여백/색상 등 스타일 적용
+    QWidget* makeTile(const CameraEntry& cam, bool compact);  // 카드 1장(제목 + 미리보기) 생성
+    void clearTiles();                               // 타일 제거(뷰 구독 해제 포함)
 
-    // ❗스트림 뷰어 포인터 (여기가 중요)
-    MjpegView* entranceStream{};  // 출입구 카메라 MJPEG 스트림 뷰어 위젯
-
-    MjpegView* fireStream{};  // 화재 카메라 MJPEG 스트림 뷰어 위젯
+private:
+    QGridLayout* grid_{};            // 타일 격자
+    QLabel* emptyLabel_{};           // 카메라가 하나도 없을 때 안내
+    QList<QWidget*> tiles_;          // 현재 타일(카드) 목록
 
+    // [wall] 설정
+    int columns_ = 0;                // 0 = 자동
+    int tileFps_ = 15;               // 타일 디코드 fps 상한
+    QSize tileMaxSize_{640, 480};    // 타일 디코드 해상도 상한
 };
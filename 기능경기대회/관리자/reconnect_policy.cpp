@@ -0,0 +1,86 @@
+#include "reconnect_policy.h"
+#include <QRandomGenerator>
+#include <QSettings>
+
+ReconnectPolicy::ReconnectPolicy(QObject *parent)
+    : QObject(parent)
+{
+    m_retryTimer.setSingleShot(true);
+    m_stallTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, [this]{
+        emit retryRequested();
+    });
+    connect(&m_stallTimer, &QTimer::timeout, this, [this]{
+        setHealth(Health::Stalled);
+        emit stalled();
+    });
+}
+
+ReconnectPolicy::Params ReconnectPolicy::fromSettings(const QString &iniPath){
+    Params p;
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup("stream");
+    p.baseMs  = qMax(100, ini.value("reconnect_base_ms", p.baseMs).toInt());
+    p.maxMs   = qMax(p.baseMs, ini.value("reconnect_max_ms", p.maxMs).toInt());
+    p.stallMs = qMax(0, int(ini.value("stall_sec", p.stallMs / 1000.0).toDouble() * 1000));
+    ini.endGroup();
+    return p;
+}
+
+void ReconnectPolicy::connecting(){
+    m_retryTimer.stop();
+    if(m_params.stallMs > 0) m_stallTimer.start(m_params.stallMs);
+    setHealth(Health::Connecting);
+}
+
+void ReconnectPolicy::frameArrived(){
+    m_failures = 0;
+    if(m_params.stallMs > 0) m_stallTimer.start(m_params.stallMs);
+    setHealth(Health::Live);
+}
+
+void ReconnectPolicy::failed(){
+    m_stallTimer.stop();
+    ++m_failures;
+    m_retryTimer.start(nextDelayMs());
+    setHealth(Health::Backoff);
+}
+
+void ReconnectPolicy::stop(){
+    m_retryTimer.stop();
+    m_stallTimer.stop();
+    m_failures = 0;
+    setHealth(Health::Idle);
+}
+
+int ReconnectPolicy::remainingMs() const{
+    return m_retryTimer.isActive() ? qMax(0, m_retryTimer.remainingTime()) : 0;
+}
+
+/*
+ * equal jitter: 상한의 절반은 보장하고 나머지 절반만 무작위.
+ * 첫 실패도 base의 절반 이상 기다리므로 즉시 재시도 폭주가 없다.
+ */
+int ReconnectPolicy::nextDelayMs() const{
+    const int shift = qMin(m_failures - 1, 16);
+    const qint64 cap = qMin<qint64>(m_params.maxMs, qint64(m_params.baseMs) << shift);
+    const int half = int(cap / 2);
+    return half + int(QRandomGenerator::global()->bounded(quint32(cap - half + 1)));
+}
+
+void ReconnectPolicy::setHealth(Health h){
+    if(m_health == h) return;
+    m_health = h;
+    emit healthChanged(h);
+}
+
+QString ReconnectPolicy::healthText(Health h){
+    switch(h){
+    case Health::Idle:       return QString::fromUtf8("정지");
+    case Health::Connecting: return QString::fromUtf8("연결 중");
+    case Health::Live:       return QString::fromUtf8("수신 중");
+    case Health::Stalled:    return QString::fromUtf8("영상 끊김");
+    case Health::Backoff:    return QString::fromUtf8("재연결 대기");
+    }
+    return {};
+}
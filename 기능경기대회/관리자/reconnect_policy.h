@@ -0,0 +1,90 @@
+#pragma once
+/**
+ * @file reconnect_policy.h
+ * @brief 스트림 재연결 정책(지수 백오프 + 지터 + 정지 감지) 및 상태 머신.
+ *
+ * 배경
+ *  - 재연결이 고정 1.5초 간격이라, 네트워크가 잠깐 끊겼다 돌아오면 관제 콘솔 여러 대가
+ *    같은 순간에 1.5초마다 카메라 호스트를 두드렸다(호스트는 연결마다 렌더 루프를 돈다).
+ *  - 연결은 살아 있는데 프레임이 안 오는 경우(카메라 프로세스 정지 등)는 감지하지 못했다.
+ *  - 출입 SMS 클라이언트는 재연결 자체가 없어 한 번 끊기면 재시작할 때까지 멈춰 있었다.
+ *
+ * 동작
+ *  - 실패 n번째 대기 = min(max, base × 2^(n-1))의 [1/2, 1] 구간 무작위(equal jitter)
+ *    → 콘솔끼리 시점이 흩어지고, 오래 죽어 있는 호스트는 최대 간격으로만 두드림
+ *  - 프레임이 한 장이라도 오면 실패 횟수 초기화
+ *  - 연결 후 stall 시간 동안 프레임이 없으면 stalled() → 호출자가 연결을 끊고 failed()
+ *
+ * 상태(Health)
+ *  - Idle → Connecting → Live ⇄ Stalled → Backoff → Connecting …
+ *
+ * 설정(admin_client.ini [stream], fromSettings()로 읽음)
+ *  - reconnect_base_ms(기본 1000), reconnect_max_ms(기본 30000), stall_sec(기본 5)
+ *
+ * 관리자 클라이언트(StreamSource)와 출입 SMS 클라이언트가 같은 소스를 쓴다.
+ */
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class ReconnectPolicy : public QObject {
+    Q_OBJECT
+public:
+    enum class Health {
+        Idle,          ///< 연결하지 않음(정지/숨김)
+        Connecting,    ///< 연결 시도 중, 아직 프레임 없음
+        Live,          ///< 프레임 수신 중
+        Stalled,       ///< 연결은 있으나 stall 시간 동안 프레임 없음
+        Backoff,       ///< 실패 후 다음 시도 대기
+    };
+    Q_ENUM(Health)
+
+    struct Params {
+        int baseMs = 1000;
+        int maxMs = 30000;
+        int stallMs = 5000;        ///< 0 = 정지 감지 끔
+    };
+
+    explicit ReconnectPolicy(QObject *parent = nullptr);
+
+    /// admin_client.ini [stream] 값(파일/키가 없으면 기본값)
+    static Params fromSettings(const QString &iniPath);
+    void setParams(const Params &p) { m_params = p; }
+    Params params() const { return m_params; }
+
+    /// 연결 시도 시작(Connecting, 정지 감지 시작)
+    void connecting();
+    /// 프레임 한 장 수신(Live, 실패 횟수 초기화, 정지 감지 재시작)
+    void frameArrived();
+    /// 연결 실패/종료 → 백오프 후 retryRequested
+    void failed();
+    /// 재연결 중단(Idle, 모든 타이머 정지) — 실패 횟수는 유지하지 않음
+    void stop();
+
+    Health health() const { return m_health; }
+    /// 연속 실패 횟수(프레임을 받으면 0)
+    int failures() const { return m_failures; }
+    /// Backoff 상태에서 다음 시도까지 남은 시간(ms, 그 외 0)
+    int remainingMs() const;
+
+    /// 상태 한글 표기(진단 표/상태 라벨용)
+    static QString healthText(Health h);
+
+signals:
+    /// 재연결할 시점(Backoff 대기 종료)
+    void retryRequested();
+    /// 연결은 있으나 프레임이 끊김 — 호출자는 연결을 정리하고 failed() 호출
+    void stalled();
+    void healthChanged(ReconnectPolicy::Health h);
+
+private:
+    void setHealth(Health h);
+    int nextDelayMs() const;
+
+    Params m_params;
+    Health m_health = Health::Idle;
+    int m_failures = 0;
+    QTimer m_retryTimer;
+    QTimer m_stallTimer;
+};
@@ -1,5 +1,6 @@
 #include "robot_page.h"
 #include "notification.h"
+#include "csv_export.h"
 /*
  * @file robot_page.cpp
  * @brief 로봇/증거영상 페이지 구현부.
@@ -38,8 +39,6 @@
 #include <QMimeData>
 #include <QDragEnterEvent>
 #include <QDropEvent>
-#include <QFile>
-#include <QTextStream>
 
 static QString niceSize(qint64 b){
     double d=b; const char* u[]={"B","KB","MB","GB"}; int i=0;
@@ -455,32 +454,8 @@ void RobotPage::exportLogCsv(){
     const QString path = QFileDialog::getSaveFileName(this, u8"CSV로 내보내기", QDir::homePath()+"/robot_log.csv", "CSV (*.csv)");
     if (path.isEmpty()) return;
 
-    QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return;
-
-    auto esc = [](const QString& s){
-        QString t = s;
-        t.replace('"', "\"\"");
-        return QString("\"%1\"").arg(t);
-    };
-
-    // UTF-8 BOM (엑셀 호환)
-    static const unsigned char bom[3] = {0xEF,0xBB,0xBF};
-    f.write(reinterpret_cast<const char*>(bom), 3);
-
-    QTextStream out(&f);
-
-    // 헤더
-    out << esc(u8"시각") << "," << esc(u8"이벤트") << "," << esc(u8"세부") << "\n";
-
-    // 데이터
-    for (int r=0; r<logTable->rowCount(); ++r){
-        const QString c0 = logTable->item(r,0) ? logTable->item(r,0)->text() : "";
-        const QString c1 = logTable->item(r,1) ? logTable->item(r,1)->text() : "";
-        const QString c2 = logTable->item(r,2) ? logTable->item(r,2)->text() : "";
-        out << esc(c0) << "," << esc(c1) << "," << esc(c2) << "\n";
-    }
-    f.close();
+    // 표 스냅샷 후 워커 스레드에서 기록(진행 대화상자 + 취소)
+    CsvExportJob::startWithProgress(CsvExportJob::fromModel(logTable->model(), path, this), this);
 }
 /** @brief 선택된 로그 행을 탭으로 구분하여 클립보드에 복사(첫 줄은 헤더) */ 
 
@@ -22,9 +22,12 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QCoreApplication>   // ✅ QCoreApplication 사용
+#include <QTimer>
 
 #include "networkclient.h"
 #include "user_editor_dialog.h"
+#include "table_fit.h"
+#include "stream_hub.h"
 
 namespace {
 constexpr int kDefaultPort = 8888;  // 기본 포트(미입력 시 사용)
@@ -138,12 +141,13 @@ void SettingsPage::buildUi()
     auto* hh = tblUsers->horizontalHeader();
     hh->setStretchLastSection(false);
     hh->setMinimumSectionSize(50);
-    hh->setSectionResizeMode(0, QHeaderView::ResizeToContents); // ID
-    hh->setSectionResizeMode(1, QHeaderView::ResizeToContents); // 이름
-    hh->setSectionResizeMode(2, QHeaderView::ResizeToContents); // 권한
-    hh->setSectionResizeMode(3, QHeaderView::ResizeToContents); // 상태
+    hh->setSectionResizeMode(0, QHeaderView::Interactive); // ID
+    hh->setSectionResizeMode(1, QHeaderView::Interactive); // 이름
+    hh->setSectionResizeMode(2, QHeaderView::Interactive); // 권한
+    hh->setSectionResizeMode(3, QHeaderView::Interactive); // 상태
     hh->setSectionResizeMode(4, QHeaderView::Stretch);  // 연락처 칼럼을 크게
           // 연락처(넓게)
+    TableColumnFitter::install(tblUsers);  // 0~3열 폭은 표본 행으로 추정(목록 갱신 후 유휴 시 1회)
 
     // 테이블 배치
     usersLay->addWidget(tblUsers);
@@ -153,10 +157,72 @@ void SettingsPage::buildUi()
     connect(btnEditUser,   &QPushButton::clicked, this, &SettingsPage::onClickEditUser);
     connect(btnRemoveUser, &QPushButton::clicked, this, &SettingsPage::onClickRemoveUser);
 
+    // ── 스트림 진단 ──
+    auto* boxStreams = new QGroupBox(tr("스트림 진단"), this);
+    auto* streamsLay = new QVBoxLayout(boxStreams);
+
+    // 10열: URL / 상태 / 수신·디코드 fps / 디코드 평균·p95 / 비트레이트 / 드롭 / 버퍼 최고 / 재연결 / 구독
+    tblStreams = new QTableWidget(0, 10, this);
+    tblStreams->setHorizontalHeaderLabels({ tr("URL"), tr("상태"), tr("수신 fps"), tr("디코드 fps"),
+                                            tr("디코드 ms(평균/p95)"), tr("비트레이트"), tr("드롭"),
+                                            tr("버퍼 최고"), tr("재연결"), tr("구독") });
+    tblStreams->setSelectionMode(QAbstractItemView::NoSelection);
+    tblStreams->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tblStreams->verticalHeader()->setVisible(false);
+    tblStreams->setMaximumHeight(180);
+    auto* sh = tblStreams->horizontalHeader();
+    sh->setStretchLastSection(false);
+    sh->setSectionResizeMode(QHeaderView::Interactive);
+    sh->setSectionResizeMode(0, QHeaderView::Stretch);   // URL
+    TableColumnFitter::install(tblStreams);  // 매초 갱신되므로 전체 재측정 대신 유휴 시 표본 추정
+    streamsLay->addWidget(tblStreams);
+
+    streamTimer = new QTimer(this);
+    streamTimer->setInterval(1000);
+    connect(streamTimer, &QTimer::timeout, this, &SettingsPage::refreshStreamStats);
+    streamTimer->start();
+
     root->addWidget(boxSys);
     root->addWidget(boxUsers);
+    root->addWidget(boxStreams);
     root->addStretch();
 }
+
+/**
+ * @brief 스트림 진단 표 갱신
+ *  - StreamHub에 열린 소스(정리 대기 포함)마다 한 행, 값은 소스가 1초마다 집계한 통계
+ *  - 페이지가 안 보이면 건너뜀(표 갱신 비용 없음)
+ */
+void SettingsPage::refreshStreamStats()
+{
+    if (!isVisible()) return;
+    const QList<StreamSource*> sources = StreamHub::instance()->sources();
+    tblStreams->setRowCount(sources.size());
+    int row = 0;
+    for (StreamSource* src : sources) {
+        const StreamStats st = src->stats();
+        QString state = st.live ? ReconnectPolicy::healthText(st.health) : tr("일시정지");
+        if (!src->status().isEmpty()) state = src->status();   // "연결 오류, 4초 후 재시도…" 등 상세 문구
+        const QStringList cells{
+            src->url().toString(),
+            state,
+            QString::number(st.recvFps, 'f', 1),
+            QString::number(st.decodeFps, 'f', 1),
+            QString("%1 / %2").arg(st.decodeMeanMs, 0, 'f', 1).arg(st.decodeP95Ms, 0, 'f', 1),
+            st.bitrateText(),
+            QString::number(st.dropped),
+            QString("%1 KB").arg((st.bufferPeak + 1023) / 1024),
+            QString::number(st.reconnects),
+            QString::number(src->subscriberCount()),
+        };
+        for (int c = 0; c < cells.size(); ++c) {
+            auto* it = tblStreams->item(row, c);
+            if (!it) { it = new QTableWidgetItem; tblStreams->setItem(row, c, it); }
+            it->setText(cells[c]);
+        }
+        ++row;
+    }
+}
 /** @brief 스타일 적용 지점(현재는 기본값 사용) */ 
 
 void SettingsPage::applyStyle()
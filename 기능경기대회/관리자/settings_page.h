@@ -4,6 +4,7 @@
  * @brief 시스템 설정 + 사용자/권한 관리 페이지 헤더.
  *        - 시스템: 서버 호스트/포트 저장(QSettings) 및 연결 테스트
  *        - 사용자: USER_LIST/ADD/UPDATE/DELETE JSON 프로토콜로 서버와 동기화
+ *        - 스트림 진단: 열린 카메라 스트림별 통계(StreamHub) 1초 갱신 표
  *        - NetworkClient는 AdminWindow에서 주입(setNetwork)
  */
 
@@ -19,6 +20,7 @@ class QPushButton;
 class QTableWidget;
 class QCheckBox;
 class QLabel;
+class QTimer;
 
 class NetworkClient;                // 네트워크 주입
 #include "user_editor_dialog.h"     // UserRecord 정의 사용
@@ -75,6 +77,8 @@ private:
 
     bool currentRowToRecord(UserRecord& out) const;  // 현재 선택된 행을 UserRecord로 추출
 
+    void refreshStreamStats();  // 스트림 진단 표 갱신(페이지가 보일 때만)
+
 
     static int      stateToActive(const QString& state);  // "활성/비활성" ↔ 1/0 변환
  // "활성"/"비활성" -> 1/0
@@ -108,6 +112,12 @@ private:
     QHash<QString, UserRecord> profileStore;  // 현재 테이블과 동기화된 간단 캐시
 
 
+    // ── 스트림 진단 ──
+    QTableWidget *tblStreams{};  // 소스별 fps/디코드 시간/비트레이트/드롭/재연결
+
+    QTimer *streamTimer{};  // 1초 주기 갱신
+
+
     // 네트워크
     NetworkClient* net_{};  // 서버 통신 객체(외부 주입)
 
@@ -0,0 +1,609 @@
+#include "stream_hub.h"
+#include <QCoreApplication>
+#include <QSettings>        // [stream] 섹션 읽기
+#include <QNetworkRequest>  // HTTP 요청 헤더 조작(keep-alive 등)
+#include <QtConcurrent>     // 워커 스레드 디코드
+#include <QThreadPool>      // 디코드 전용 풀
+#include <QImageReader>     // 축소 디코드(setScaledSize)
+#include <QBuffer>          // QByteArray → QIODevice(QImageReader 입력)
+#include <QRegularExpression>
+#include <QDateTime>         // 녹화 탭 파트 수신 시각, 프레임 구간 시각
+#include <algorithm>         // p95(nth_element)
+#include <utility>           // std::exchange
+
+/*
+ * 디코드는 decodePool()의 워커에서, 목표 크기로 바로(QImageReader::setScaledSize).
+ * Qt JPEG 플러그인은 이를 libjpeg의 DCT 축소(1/2, 1/4, 1/8)로 처리하므로
+ * 640x480 → 타일 크기 디코드가 원본 디코드 + 축소보다 훨씬 싸다.
+ */
+
+namespace {
+
+constexpr int kStatsMs = 1000;   // 통계 집계 주기
+constexpr int kNegotiateMs = 800; // 구독자 요구 변화 모으는 시간
+
+// 디코드 전용 풀: 통계/CSV 등 전역 풀 작업에 밀리지 않도록 분리(앱 종료까지 유지)
+QThreadPool *decodePool(){
+    static QThreadPool *pool = []{
+        auto *p = new QThreadPool;
+        p->setMaxThreadCount(qMax(2, QThread::idealThreadCount() / 2));
+        p->setExpiryTimeout(30000);
+        return p;
+    }();
+    return pool;
+}
+
+struct Decoded {
+    QImage img;
+    qint64 us = 0;       // 워커에서 잰 디코드 시간(대기 시간 제외)
+};
+
+// 워커 스레드: JPEG → box 안에 비율 유지로 들어가는 크기로 디코드(축소만, 확대는 하지 않음)
+Decoded decodeJpeg(const FrameSlice &jpg, const QSize &box){
+    QElapsedTimer t;
+    t.start();
+    QBuffer dev;
+    dev.setData(jpg.bytes());            // 복사 없이 청크 구간을 그대로 읽음(jpg가 청크를 붙잡고 있음)
+    dev.open(QIODevice::ReadOnly);
+    QImageReader reader(&dev, "jpeg");
+    const QSize src = reader.size();   // 헤더만 읽음
+    if(src.isValid() && box.isValid()
+        && (src.width() > box.width() || src.height() > box.height())) {
+        reader.setScaledSize(src.scaled(box, Qt::KeepAspectRatio));
+    }
+    Decoded out;
+    out.img = reader.read();
+    out.us = t.nsecsElapsed() / 1000;
+    return out;
+}
+
+} // namespace
+
+// ===================== StreamSource =====================
+
+StreamSource::StreamSource(const QUrl &url, int hiddenPollMs, const ReconnectPolicy::Params &reconnect,
+                           const StreamQuality::Params &quality, QObject *parent)
+    : QObject(parent), m_url(url), m_clock(&m_nam), m_hiddenPollMs(hiddenPollMs)
+{
+    m_policy.setParams(reconnect);
+    m_quality.setParams(quality);
+    m_negotiateTimer.setSingleShot(true);
+    connect(&m_negotiateTimer, &QTimer::timeout, this, &StreamSource::renegotiate);
+    m_lingerTimer.setSingleShot(true);
+    connect(&m_lingerTimer, &QTimer::timeout, this, &StreamSource::lingerExpired);
+    connect(&m_policy, &ReconnectPolicy::retryRequested, this, &StreamSource::retry);
+    connect(&m_policy, &ReconnectPolicy::stalled,        this, &StreamSource::onStalled);
+    connect(&m_policy, &ReconnectPolicy::healthChanged,  this, &StreamSource::healthChanged);
+    connect(&m_pollTimer, &QTimer::timeout, this, &StreamSource::pollFrame);
+    connect(&m_statsTimer, &QTimer::timeout, this, &StreamSource::updateStats);
+    m_throttleTimer.setSingleShot(true);
+    connect(&m_throttleTimer, &QTimer::timeout, this, &StreamSource::decodeNext);
+    m_decodeUs.reserve(kDecodeSamples);
+    m_statsClock.start();
+    m_statsTimer.start(kStatsMs);
+}
+
+StreamSource::~StreamSource(){
+    stop();
+}
+
+void StreamSource::subscribe(QObject *sub, const QSize &hint, bool active, bool decode){
+    m_lingerTimer.stop();   // 정리 대기 중 다시 구독 → 연결 유지
+    m_subs.insert(sub, Sub{hint, active, decode});
+    updateMode();
+    scheduleRenegotiate();
+}
+
+void StreamSource::setHint(QObject *sub, const QSize &hint){
+    auto it = m_subs.find(sub);
+    if(it == m_subs.end() || it->hint == hint) return;
+    it->hint = hint;
+    scheduleRenegotiate();
+}
+
+void StreamSource::setMaxFps(QObject *sub, int fps){
+    auto it = m_subs.find(sub);
+    if(it == m_subs.end() || it->maxFps == qMax(0, fps)) return;
+    it->maxFps = qMax(0, fps);
+    scheduleRenegotiate();
+}
+
+// 전역 예산은 매초 조금씩 움직이므로 서버 요청에는 넣지 않는다(재연결 반복 방지) — 디코드 간격만 조절
+void StreamSource::setBudgetFps(int fps){
+    m_budgetFps = qMax(0, fps);
+}
+
+int StreamSource::subscriberFpsCap() const{
+    // 제한 없는 구독자가 하나라도 보이면 제한 없음, 아니면 가장 높은 상한
+    int cap = -1;
+    for(const Sub &s : m_subs){
+        if(!s.decode || !s.active) continue;
+        if(s.maxFps <= 0) return 0;
+        cap = qMax(cap, s.maxFps);
+    }
+    return qMax(0, cap);
+}
+
+int StreamSource::fpsCap() const{
+    const int cap = subscriberFpsCap();
+    if(m_budgetFps <= 0) return cap;
+    return cap > 0 ? qMin(cap, m_budgetFps) : m_budgetFps;
+}
+
+void StreamSource::setActive(QObject *sub, bool active){
+    auto it = m_subs.find(sub);
+    if(it == m_subs.end() || it->active == active) return;
+    it->active = active;
+    updateMode();
+    scheduleRenegotiate();   // 보이는 구독자가 바뀌면 최대 크기/fps도 바뀜
+}
+
+void StreamSource::unsubscribe(QObject *sub){
+    m_subs.remove(sub);
+    updateMode();
+    scheduleRenegotiate();
+}
+
+/*
+ * 보이는 구독자가 있으면 스트림, 없으면 스트림을 닫고 저속 폴링.
+ * 구독자가 아예 없으면(허브 정리 대기 중) 모드를 바꾸지 않는다 → 곧바로 다시 구독하면 끊김 없음.
+ */
+void StreamSource::updateMode(){
+    if(m_subs.isEmpty()) return;
+    bool want = false;
+    for(const Sub &s : std::as_const(m_subs)) want = want || s.active;
+    if(want == m_live){
+        // 첫 구독자가 숨겨진 채로 들어온 경우: m_live는 처음부터 false라 전환이 없으므로 폴링만 시작
+        if(!want && !m_pollTimer.isActive() && m_hiddenPollMs > 0 && !m_pollUnsupported){
+            m_pollTimer.start(m_hiddenPollMs);
+            pollFrame();                  // 첫 정지 화면은 바로(주기만큼 빈 타일로 두지 않음)
+        }
+        return;
+    }
+
+    m_live = want;
+    if(want){
+        m_pollTimer.stop();
+        start();                          // 숨김 동안 폴링한 프레임은 뷰에 남아 있음
+    } else {
+        m_policy.stop();
+        m_clock.stop();                   // 숨김 동안은 보정 요청도 쉼(오프셋은 유지)
+        stop();
+        if(m_hiddenPollMs > 0 && !m_pollUnsupported) m_pollTimer.start(m_hiddenPollMs);
+    }
+}
+
+QUrl StreamSource::frameUrl() const{
+    QUrl u = m_url;
+    QString path = u.path();
+    const int slash = path.lastIndexOf('/');
+    path = (slash >= 0 ? path.left(slash) : QString()) + "/frame.jpg";
+    u.setPath(path);
+    QUrlQuery q = requestQuery();     // 정지 화면도 같은 크기/품질로(fps는 의미 없음)
+    q.removeAllQueryItems("fps");
+    u.setQuery(q);
+    return u;
+}
+
+QUrlQuery StreamSource::requestQuery() const{
+    // 녹화 탭(디코드 안 하는 구독자)이 있으면 해상도는 원본 — 증거 영상은 줄이지 않음
+    bool tap = false;
+    for(const Sub &s : m_subs) tap = tap || !s.decode;
+    return m_quality.query(tap ? QSize() : decodeBox(), tap ? 0 : subscriberFpsCap());
+}
+
+QUrl StreamSource::requestUrl() const{
+    QUrl u = m_url;
+    QUrlQuery q(u);
+    for(const auto &item : requestQuery().queryItems())
+        if(!q.hasQueryItem(item.first)) q.addQueryItem(item.first, item.second);
+    u.setQuery(q);
+    return u;
+}
+
+void StreamSource::scheduleRenegotiate(){
+    if(m_quality.enabled() && m_reply) m_negotiateTimer.start(kNegotiateMs);
+}
+
+/*
+ * 쿼리가 그대로면 아무것도 하지 않는다(폭/fps를 단계로 올려 두었으므로 대부분의 리사이즈는 여기서 끝남).
+ * 서버가 파라미터를 모르면(X-Stream-Params 없음) 다시 연결해도 같은 스트림이므로 건너뛴다.
+ * 재연결 사이의 짧은 공백은 녹화 링에서 끊긴 구간으로 보지 않는다(링은 그대로 이어 씀).
+ * 단 폭(w)이 바뀌면 프레임 크기가 달라지므로 링을 비운다 — 녹화 파일 하나는 한 가지 크기만 담는다.
+ */
+void StreamSource::renegotiate(){
+    if(!m_live || !m_reply || !m_quality.negotiated()) return;
+    const QString next = requestUrl().query();
+    if(next == m_requestQuery) return;
+    const bool sameSize = QUrlQuery(next).queryItemValue("w") == QUrlQuery(m_requestQuery).queryItemValue("w");
+    QList<StreamPart> ring = sameSize ? std::move(m_ring) : QList<StreamPart>();
+    const qint64 ringBytes = sameSize ? m_ringBytes : 0;
+    start();
+    m_ring = std::move(ring);
+    m_ringBytes = ringBytes;
+    setStatus(QString());   // 뷰는 마지막 프레임을 계속 보여 줌("연결 중…" 깜빡임 없음)
+}
+
+void StreamSource::pollFrame(){
+    if(m_live || m_pollReply) return;
+    m_pollReply = m_nam.get(QNetworkRequest(frameUrl()));
+    connect(m_pollReply, &QNetworkReply::finished, this, [this]{
+        QNetworkReply *r = m_pollReply;
+        m_pollReply = nullptr;
+        if(!r) return;
+        r->deleteLater();
+        if(r->error() == QNetworkReply::NoError){
+            const QByteArray jpg = r->readAll();
+            m_rxBytes += jpg.size();
+            ++m_rxFrames;
+            submitDecode(FrameSlice::fromByteArray(jpg), arrivalTiming(r->rawHeader("X-Capture-Ts")));
+        } else if(r->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 404){
+            m_pollUnsupported = true;     // 단일 프레임 엔드포인트가 없는 서버 → 숨김 동안은 정지
+            m_pollTimer.stop();
+        }
+    });
+}
+
+void StreamSource::setStatus(const QString &text){
+    if(m_status == text) return;
+    m_status = text;
+    emit statusChanged(text);
+}
+
+void StreamSource::start(){
+    stop();                 // 이전 연결/버퍼 완전 종료
+    if(!m_url.isValid()) return;
+    m_policy.connecting();  // 겹치는 재시도 예약 무효화 + 정지 감지 시작
+
+    const QUrl url = requestUrl();
+    m_requestQuery = url.query();
+    m_quality.restart();
+    QNetworkRequest req(url);
+    req.setRawHeader("Connection","keep-alive"); // 장시간 스트리밍 연결 힌트
+    m_reply = m_nam.get(req);
+
+    connect(m_reply,&QNetworkReply::readyRead, this,&StreamSource::onReadyRead);
+    connect(m_reply,&QNetworkReply::finished,  this,&StreamSource::onFinished);
+    connect(m_reply,&QNetworkReply::errorOccurred, this,&StreamSource::onError);
+
+    m_clock.start(m_url);   // 같은 호스트면 기존 추정을 이어 씀
+
+    setStatus(QString::fromUtf8("연결 중…"));
+}
+
+/*
+ * 정리 순서: reply 신호 해제 → (에러 없는 진행 중일 때만) abort → deleteLater.
+ * 에러 상태에서 abort()는 추가 에러를 유발할 수 있어 호출하지 않는다.
+ */
+void StreamSource::stop(){
+    if(m_reply){
+        disconnect(m_reply,nullptr,this,nullptr);
+        if (!m_reply->isFinished()
+            && m_reply->error() == QNetworkReply::NoError) {
+            m_reply->abort();
+        }
+        m_reply->deleteLater();
+        m_reply=nullptr;
+    }
+    if(m_pollReply){
+        disconnect(m_pollReply,nullptr,this,nullptr);
+        m_pollReply->abort();
+        m_pollReply->deleteLater();
+        m_pollReply=nullptr;
+    }
+    m_parser.reset();
+    m_typeSeen = false;
+    m_ring.clear();         // 끊긴 구간을 건너 이어 붙이지 않음(녹화는 연속 구간만)
+    m_ringBytes = 0;
+    m_pending = FrameSlice();
+    m_pendingTiming = FrameTiming();
+    m_throttleTimer.stop();
+    m_negotiateTimer.stop();
+    ++m_epoch;              // 진행 중인 디코드 결과는 도착해도 버림
+}
+
+void StreamSource::retry(){
+    if (m_reply || !m_live) return;   // 이미 시도 중이거나 숨김 상태면 재연결하지 않음
+    ++m_stats.reconnects;
+    start();
+}
+
+void StreamSource::onReadyRead(){
+    if(!m_reply) return;
+    if(!m_typeSeen){
+        // 첫 조각: 응답 헤더의 boundary로 파서 모드 결정(없으면 파서가 데이터로 판별)
+        m_parser.setContentType(m_reply->header(QNetworkRequest::ContentTypeHeader).toByteArray());
+        m_quality.setAdvertised(m_reply->rawHeader("X-Stream-Params"));   // 없으면 협상 미지원 서버
+        m_typeSeen = true;
+    }
+    m_rxBytes += m_parser.readFrom(m_reply);   // 소켓 → 파서 청크로 바로(readAll 임시 배열 없음)
+    m_stats.bufferPeak = qMax(m_stats.bufferPeak, m_parser.buffered());
+    parseBuffer();
+}
+
+void StreamSource::onFinished(){
+    scheduleRetry(QString::fromUtf8("연결 끊김"));
+}
+
+void StreamSource::onError(QNetworkReply::NetworkError){
+    scheduleRetry(QString::fromUtf8("연결 오류"));
+}
+
+void StreamSource::onStalled(){
+    scheduleRetry(QString::fromUtf8("영상 수신 없음"));
+}
+
+void StreamSource::scheduleRetry(const QString &reason){
+    stop();
+    if(!m_live) return;                 // 숨김 상태: 재연결하지 않음(폴링이 담당)
+    m_policy.failed();
+    const int sec = (m_policy.remainingMs() + 999) / 1000;
+    setStatus(QString::fromUtf8("%1, %2초 후 재시도…").arg(reason).arg(sec));
+}
+
+void StreamSource::parseBuffer(){
+    MjpegParser::Part part, latest;
+    int complete = 0;
+    while(m_parser.next(&part)){
+        tapPart(part.jpeg);              // 녹화용: 디코드에서 버려질 프레임도 전부
+        latest = std::move(part);
+        ++complete;
+    }
+    if(complete == 0) return;
+    m_rxFrames += complete;
+    m_policy.frameArrived();
+    if(!wantsDecode()) return;
+
+    // 최신 완성 프레임만 디코드, 그보다 오래된 완성 프레임은 디코드 없이 버림
+    m_dropped += complete - 1;
+    m_backlog += complete - 1;          // 한 번에 여러 장 = 읽기가 밀렸음
+    submitDecode(latest.jpeg, arrivalTiming(latest.header("x-capture-ts")));
+}
+
+FrameTiming StreamSource::arrivalTiming(const QByteArray &captureTs) const{
+    FrameTiming t;
+    t.recvMs = QDateTime::currentMSecsSinceEpoch();
+    bool ok = false;
+    const double server = captureTs.toDouble(&ok);
+    if(ok && server > 0) t.captureMs = qint64(server) - m_clock.offsetMs();   // 미보정이면 오프셋 0
+    return t;
+}
+
+void StreamSource::submitDecode(const FrameSlice &jpg, const FrameTiming &timing){
+    if(!wantsDecode()) return;              // 녹화 탭만 남은 경우: 스트림은 유지, 디코드는 생략
+    if(!m_pending.isEmpty()){               // 아직 디코드 못 한 이전 프레임은 최신 것으로 대체
+        ++m_dropped;
+        if(m_decoding) ++m_backlog;         // fps 상한 대기가 아니라 디코드가 못 따라감
+    }
+    m_pending = jpg;
+    m_pendingTiming = timing;
+    decodeNext();
+}
+
+/*
+ * 소스당 한 건만 디코드. 그동안 도착한 프레임은 슬롯 1칸을 덮어쓰므로 끝나면 항상 최신 프레임을 디코드.
+ * fps 상한이 있으면 디코드 시작 간격을 1/상한 이상으로 벌린다(기다리는 동안 온 프레임도 슬롯을 덮어씀).
+ * 결과는 this 컨텍스트로 UI 스레드에 돌아오며, 소스가 파괴되면 호출되지 않는다.
+ */
+void StreamSource::decodeNext(){
+    if(m_decoding || m_pending.isEmpty() || m_throttleTimer.isActive()) return;
+    const int cap = fpsCap();
+    if(cap > 0 && m_decodeClock.isValid()){
+        const qint64 wait = 1000 / cap - m_decodeClock.elapsed();
+        if(wait > 0){
+            m_throttleTimer.start(int(wait));
+            return;
+        }
+    }
+    m_decodeClock.start();
+    m_decoding = true;
+
+    const FrameSlice jpg = std::exchange(m_pending, FrameSlice());
+    const FrameTiming timing = std::exchange(m_pendingTiming, FrameTiming());
+    const quint64 epoch = m_epoch;
+    QtConcurrent::run(decodePool(), decodeJpeg, jpg, decodeBox())
+        .then(this, [this, epoch, timing](const Decoded &d){
+            m_decoding = false;
+            recordDecode(d.us);
+            if(epoch == m_epoch && !d.img.isNull()){
+                ++m_decFrames;
+                m_lastImg = d.img;
+                setStatus(QString());
+                FrameTiming t = timing;
+                t.decodedMs = QDateTime::currentMSecsSinceEpoch();
+                emit frameReady(d.img, t);
+            }
+            decodeNext();
+        });
+}
+
+void StreamSource::recordDecode(qint64 us){
+    const qint32 v = qint32(qMin<qint64>(us, 0x7fffffff));
+    if(m_decodeUs.size() < kDecodeSamples) m_decodeUs.append(v);
+    else m_decodeUs[m_decodeNext] = v;
+    m_decodeNext = (m_decodeNext + 1) % kDecodeSamples;
+}
+
+/*
+ * 구간 카운터를 초당 값으로 바꿔 m_stats에 반영하고 0으로 되돌린다.
+ * 타이머가 늦게 불려도(모달 대화상자 등) 실제 경과 시간으로 나누므로 값이 부풀지 않는다.
+ */
+void StreamSource::updateStats(){
+    const qint64 ms = qMax<qint64>(1, m_statsClock.restart());
+    m_stats.recvFps   = m_rxFrames  * 1000.0 / ms;
+    m_stats.decodeFps = m_decFrames * 1000.0 / ms;
+    m_stats.kbps      = m_rxBytes * 8.0 / ms;          // bit/ms = kbit/s
+    m_stats.dropped   = m_dropped;
+    m_stats.live      = m_live;
+    m_stats.health    = m_policy.health();
+    m_stats.fpsCap    = fpsCap();
+    // 자동 단계: 받는 중인 연결만 판단(연결 중/백오프/숨김 구간은 표본이 아님)
+    const bool stepped = m_live && m_reply && m_policy.health() == ReconnectPolicy::Health::Live
+                         && m_quality.sample(m_rxFrames, m_backlog, m_stats.recvFps);
+    m_stats.qualityLevel = m_quality.level();
+    m_stats.negotiated   = m_quality.advertised();
+    m_rxFrames = m_decFrames = 0;
+    m_rxBytes = 0;
+    m_backlog = 0;
+    if(stepped) renegotiate();
+
+    if(!m_decodeUs.isEmpty()){
+        qint64 sum = 0;
+        for(qint32 v : std::as_const(m_decodeUs)) sum += v;
+        m_stats.decodeMeanMs = sum / 1000.0 / m_decodeUs.size();
+        QVector<qint32> sorted = m_decodeUs;
+        const int k = (sorted.size() * 95 + 99) / 100 - 1;   // 95퍼센타일(올림 순위)
+        std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+        m_stats.decodeP95Ms = sorted[k] / 1000.0;
+    }
+    emit statsUpdated(m_stats);
+}
+
+QString StreamStats::bitrateText() const{
+    return kbps >= 1000 ? QString::number(kbps / 1000.0, 'f', 1) + " Mbps"
+                        : QString::number(kbps, 'f', 0) + " kbps";
+}
+
+QString StreamStats::summary() const{
+    QString s = QString::fromUtf8("%1/%2 fps · %3 · 디코드 %4/%5 ms · 드롭 %6 · 재연결 %7")
+        .arg(recvFps, 0, 'f', 1).arg(decodeFps, 0, 'f', 1).arg(bitrateText())
+        .arg(decodeMeanMs, 0, 'f', 1).arg(decodeP95Ms, 0, 'f', 1)
+        .arg(dropped).arg(reconnects);
+    if(fpsCap > 0) s += QString::fromUtf8(" · 상한 %1 fps").arg(fpsCap);
+    if(qualityLevel > 0) s += QString::fromUtf8(" · 품질 단계 %1").arg(qualityLevel);
+    if(!negotiated.isEmpty()) s += QString::fromUtf8(" · 서버 %1").arg(negotiated);
+    return s;
+}
+
+bool StreamSource::wantsDecode() const{
+    for(const Sub &s : m_subs)
+        if(s.decode && s.active) return true;
+    // 숨김 상태 폴링(보이는 구독자 없음)은 다시 보일 때 쓸 정지 화면이므로 디코드
+    return !m_live && !m_subs.isEmpty();
+}
+
+void StreamSource::setPreRoll(int ms){
+    m_preRollMs = qMax(0, ms);
+    if(m_preRollMs == 0){
+        m_ring.clear();
+        m_ringBytes = 0;
+    }
+}
+
+void StreamSource::tapPart(const FrameSlice &jpg){
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    emit partReceived(jpg, now);
+    if(m_preRollMs <= 0) return;
+
+    m_ring.append(StreamPart{jpg, now});
+    m_ringBytes += jpg.size();
+    while(!m_ring.isEmpty()
+          && (now - m_ring.first().ms > m_preRollMs || m_ringBytes > kPreRollMaxBytes)){
+        m_ringBytes -= m_ring.first().jpeg.size();
+        m_ring.removeFirst();
+    }
+}
+
+QSize StreamSource::decodeBox() const{
+    // 배치 전(0 또는 아주 작은 크기) 구독자는 무시. 아무도 크기를 모르면 원본 크기로 디코드
+    QSize box;
+    for(const Sub &s : m_subs){
+        if(!s.decode) continue;
+        if(s.hint.width() < 16 || s.hint.height() < 16) continue;
+        box = box.isValid() ? box.expandedTo(s.hint) : s.hint;
+    }
+    return box;
+}
+
+// ===================== StreamHub =====================
+
+StreamHub::StreamHub(QObject *parent)
+    : QObject(parent)
+{
+    connect(&m_budgetTimer, &QTimer::timeout, this, &StreamHub::rebalance);
+}
+
+StreamHub *StreamHub::instance(){
+    static StreamHub *hub = []{
+        auto *h = new StreamHub(QCoreApplication::instance());
+        QSettings ini(QCoreApplication::applicationDirPath() + "/admin_client.ini", QSettings::IniFormat);
+        ini.beginGroup("stream");
+        h->m_hiddenPollMs = qMax(0, int(ini.value("hidden_poll_sec", 5).toDouble() * 1000));
+        const int budgetPct = qBound(0, ini.value("decode_budget_pct", 50).toInt(), 100);
+        h->m_latencySloMs = qMax(1, ini.value("latency_slo_ms", h->m_latencySloMs).toInt());
+        ini.endGroup();
+        const int cores = qMax(1, QThread::idealThreadCount());
+        if(budgetPct > 0){
+            decodePool()->setMaxThreadCount(qMax(2, (cores * budgetPct + 99) / 100));
+            h->m_budgetMs = cores * 1000.0 * budgetPct / 100;
+            h->m_budgetTimer.start(kStatsMs);
+        }
+        h->m_reconnect = ReconnectPolicy::fromSettings(ini.fileName());
+        h->m_quality = StreamQuality::fromSettings(ini.fileName());
+        return h;
+    }();
+    return hub;
+}
+
+QString StreamHub::keyOf(const QUrl &url){
+    QUrl u = url.adjusted(QUrl::StripTrailingSlash | QUrl::NormalizePathSegments);
+    static const QRegularExpression reSlashes(QStringLiteral("/{2,}"));
+    u.setPath(u.path().replace(reSlashes, QStringLiteral("/")));
+    return u.toString();
+}
+
+StreamSource *StreamHub::acquire(const QUrl &url, QObject *subscriber, const QSize &hint, bool active,
+                                 bool decode){
+    const QString key = keyOf(url);
+    StreamSource *src = m_sources.value(key);
+    if(!src){
+        src = new StreamSource(url, m_hiddenPollMs, m_reconnect, m_quality, this);
+        m_sources.insert(key, src);
+        connect(src, &StreamSource::lingerExpired, this, [this, src]{
+            if(src->subscriberCount() > 0) return;
+            m_sources.remove(keyOf(src->url()));
+            src->deleteLater();
+        });
+    }
+    src->subscribe(subscriber, hint, active, decode);   // 보이는 구독자면 여기서 연결 시작
+    return src;
+}
+
+/*
+ * 디코드 비용 = Σ(디코드 fps × 평균 디코드 시간). 예산을 넘으면 스트림마다 지금 fps에 같은 비율을 곱해
+ * 상한으로 걸고(fps가 높은 스트림이 절대량을 더 양보), 예산의 80% 아래로 내려가면 상한을 25%씩 풀어
+ * 수신 fps를 넘으면 해제한다. 여유 구간(80~100%)에서는 그대로 두어 매초 오르내리지 않게 한다.
+ */
+void StreamHub::rebalance(){
+    double total = 0;
+    for(StreamSource *src : std::as_const(m_sources)){
+        const StreamStats st = src->stats();
+        if(st.live) total += st.decodeFps * st.decodeMeanMs;
+    }
+
+    if(total > m_budgetMs){
+        const double k = m_budgetMs / total;
+        for(StreamSource *src : std::as_const(m_sources)){
+            const StreamStats st = src->stats();
+            if(!st.live || st.decodeFps <= 0) continue;
+            src->setBudgetFps(qMax(kMinBudgetFps, int(st.decodeFps * k)));
+        }
+    } else if(total < m_budgetMs * 0.8){
+        for(StreamSource *src : std::as_const(m_sources)){
+            const int b = src->budgetFps();
+            if(b <= 0) continue;
+            const int next = b + qMax(1, b / 4);
+            src->setBudgetFps(next > src->stats().recvFps ? 0 : next);
+        }
+    }
+}
+
+void StreamHub::release(StreamSource *src, QObject *subscriber){
+    if(!src) return;
+    src->unsubscribe(subscriber);
+    if(src->subscriberCount() > 0) return;
+
+    // 잠시 기다렸다가도 아무도 없으면 정리(그사이 다시 구독하면 연결 유지).
+    // 소스당 타이머 하나를 다시 시작하므로 해제 → 구독 → 해제가 겹쳐도 마지막 해제부터 kLingerMs를 센다
+    src->startLinger(kLingerMs);
+}
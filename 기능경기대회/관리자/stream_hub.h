@@ -0,0 +1,297 @@
+#pragma once
+/**
+ * @file stream_hub.h
+ * @brief 카메라 스트림 공유 허브(URL당 HTTP 연결 1개 + 디코더 1개 → 여러 뷰로 분배).
+ *
+ * 배경
+ *  - 모니터링 미리보기와 확대 보기(CameraViewerPage)가 같은 카메라에 각각 연결을 열었다.
+ *    stream_server.py는 연결마다 render_frame()(YOLO 추론 포함)을 따로 돌리므로,
+ *    확대 보기를 여는 순간 카메라 호스트 부하가 두 배가 됐다.
+ *
+ * 구성
+ *  - StreamSource: URL 하나의 수신(QNetworkReply) → MjpegParser → 워커 디코드 → frameReady.
+ *    · 소켓 데이터는 파서 청크에 바로 읽고, 프레임은 청크 구간(FrameSlice)으로 디코드/녹화까지 복사 없이 전달
+ *    · 최신 프레임 우선(밀린 프레임은 디코드하지 않고 드롭 집계), 디코드는 한 번에 하나
+ *    · 디코드 크기 = 구독자 표시 크기 중 최대(작은 타일은 받은 이미지를 축소해 그림)
+ *    · 디코드 fps 상한 = 구독자 상한 중 최대(setMaxFps, 0 = 제한 없음)와 허브 전역 예산 중 작은 값
+ *    · 연결 종료/오류/프레임 끊김 시 자동 재연결(ReconnectPolicy: 지터 있는 지수 백오프)
+ *    · 요청 파라미터 협상(StreamQuality): 구독자 최대 크기/구독자 fps 상한을 쿼리(w/fps/q)로 서버에 요청하고,
+ *      디코드가 밀리거나 링크가 혼잡하면 단계를 내려 다시 연결. 녹화 탭이 있으면 해상도는 원본 유지
+ *    · 보이는 구독자가 하나도 없으면 스트림을 닫고 /frame.jpg를 저속 폴링(hidden_poll_sec, 0 = 완전 정지)
+ *      → 다시 보이면 즉시 스트림 재개(그동안은 폴링한 최근 프레임을 표시)
+ *    · 1초마다 통계(StreamStats) 집계 → statsUpdated (뷰 오버레이/카메라 보기 상태/설정 페이지 진단 표)
+ *    · 프레임마다 구간 시각(FrameTiming: 캡처/수신/디코드 완료)을 frameReady로 함께 전달
+ *      캡처 시각은 파트 헤더 X-Capture-Ts를 서버 /clock으로 보정(ClockSync)한 값 → 뷰가 그린 뒤 지연 집계
+ *    · 압축 상태 그대로의 파트 탭: 완성 파트마다 partReceived, 선택적으로 최근 N초 링(setPreRoll)
+ *      → 녹화(ClipRecorder)가 디코드/재인코딩 없이 사건 이전 구간부터 저장
+ *    · 디코드하지 않는 구독자(녹화 등)는 스트림만 유지시키고 디코드 크기/여부에는 관여하지 않음
+ *  - StreamHub: URL → StreamSource 레지스트리(참조 계수).
+ *    · acquire(): 있으면 공유, 없으면 만들어 시작
+ *    · release(): 마지막 구독자가 떠나면 잠시(kLingerMs) 기다렸다 정리
+ *      → 페이지 전환/뷰 교체처럼 곧바로 다시 구독하는 경우 재연결 없이 이어짐
+ *    · 전역 디코드 예산: 1초마다 전체 디코드 시간(Σ 디코드 fps × 평균 디코드 시간)을 예산과 비교해
+ *      넘으면 모든 스트림의 fps 상한을 같은 비율로 낮추고, 여유가 생기면 천천히 풀어 줌
+ *      → 카메라가 16대 이상이어도 콘솔 CPU는 예산 안, 특정 타일만 멈추지 않고 고르게 느려짐
+ *
+ * 설정(admin_client.ini [stream])
+ *  - hidden_poll_sec: 숨겨진 스트림의 정지 화면 갱신 주기(초, 기본 5, 0 = 갱신 안 함)
+ *  - reconnect_base_ms / reconnect_max_ms / stall_sec: 재연결 정책(reconnect_policy.h)
+ *  - adaptive / adaptive_down_sec / adaptive_up_sec: 품질 협상/자동 단계(stream_quality.h)
+ *  - decode_budget_pct: 디코드에 쓸 CPU 비율(논리 코어 합 기준 %, 기본 50, 0 = 예산 조정 없음)
+ *                       디코드 풀 스레드 수도 이 비율로 정함(최소 2)
+ *  - latency_slo_ms: 캡처 → 화면 지연 목표(ms, 기본 500) — 뷰 지연 지표의 목표 내 비율 기준(frame_latency.h)
+ *
+ * 스레드
+ *  - 모두 UI 스레드 객체. 디코드만 전용 스레드 풀에서 돌고 결과는 UI 스레드로 돌아온다.
+ */
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QSize>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+#include "frame_latency.h"
+#include "mjpeg_parser.h"
+#include "reconnect_policy.h"
+#include "stream_quality.h"
+
+/// 압축된 JPEG 파트 하나(수신 시각 포함) — 녹화 링 버퍼 단위
+struct StreamPart {
+    FrameSlice jpeg;                 ///< 파서 청크의 구간(링에 있는 동안 그 청크는 재사용되지 않음)
+    qint64 ms = 0;               ///< 수신 시각(epoch ms)
+};
+
+/**
+ * @brief 스트림 하나의 상태 지표(1초 구간 집계, 누계 항목은 소스 생성 이후)
+ *  - 하드웨어 산정(카메라 수 × fps × 디코드 시간)과 링크 품질 저하 조기 발견용
+ */
+struct StreamStats {
+    double recvFps = 0;          ///< 수신 완성 프레임/초
+    double decodeFps = 0;        ///< 디코드 완료 프레임/초(수신보다 낮으면 밀려서 드롭 중)
+    quint64 dropped = 0;         ///< 디코드하지 않고 버린 프레임 누계
+    double decodeMeanMs = 0;     ///< 최근 디코드 시간 평균(워커 기준, 최근 kDecodeSamples건)
+    double decodeP95Ms = 0;      ///< 최근 디코드 시간 95퍼센타일
+    double kbps = 0;             ///< 수신 비트레이트(kbit/s, 헤더 제외 본문 바이트)
+    int bufferPeak = 0;          ///< 파서 버퍼 최고치(바이트) — 커지면 파싱이 못 따라가거나 경계 손상
+    int reconnects = 0;          ///< 오류/종료 후 재연결 횟수 누계
+    int fpsCap = 0;              ///< 적용 중인 디코드 fps 상한(0 = 없음, 구독자/전역 예산 중 작은 값)
+    int qualityLevel = 0;        ///< 자동 품질 단계(0 = 요청 그대로, 클수록 낮춤)
+    QString negotiated;          ///< 서버가 적용한 요청 파라미터(X-Stream-Params, 미지원 서버면 빈 값)
+    ReconnectPolicy::Health health = ReconnectPolicy::Health::Idle;   ///< 연결 상태
+    bool live = false;           ///< 전체 속도 스트림 중(false = 숨김/정지 또는 저속 폴링)
+
+    /// 비트레이트 표기("850 kbps" / "1.2 Mbps")
+    QString bitrateText() const;
+    /// 한 줄 요약("29.8/29.8 fps · 1.2 Mbps · 디코드 4.1/6.0 ms · 드롭 3 · 재연결 0")
+    QString summary() const;
+};
+
+class StreamSource : public QObject {
+    Q_OBJECT
+public:
+    /// @param hiddenPollMs 보이는 구독자가 없을 때 /frame.jpg 폴링 주기(0 = 폴링 안 함)
+    /// @param reconnect    재연결 백오프/정지 감지 설정
+    /// @param quality      요청 파라미터 협상/자동 단계 설정
+    StreamSource(const QUrl &url, int hiddenPollMs, const ReconnectPolicy::Params &reconnect,
+                 const StreamQuality::Params &quality, QObject *parent = nullptr);
+    ~StreamSource() override;
+
+    QUrl url() const { return m_url; }
+    /// 가장 최근에 디코드한 프레임(새 구독자가 첫 프레임을 기다리지 않도록)
+    QImage lastFrame() const { return m_lastImg; }
+    /// 현재 상태 문구(스트리밍 중이면 빈 문자열)
+    QString status() const { return m_status; }
+    /// 디코드하지 않고 버린(밀린) 프레임 누계
+    quint64 droppedFrames() const { return m_dropped; }
+    int subscriberCount() const { return int(m_subs.size()); }
+    /// 전체 속도 스트림을 받는 중인지(false = 숨김 상태: 정지 또는 저속 폴링)
+    bool isLive() const { return m_live; }
+    /// 연결 상태(Live/Stalled/Backoff …)
+    ReconnectPolicy::Health health() const { return m_policy.health(); }
+    /// 연결 세대(연결을 닫을 때마다 증가). 같은 값이면 같은 연결 — 프레임 크기가 바뀌지 않음
+    quint64 connection() const { return m_epoch; }
+    /// 가장 최근 1초 구간 통계(statsUpdated와 같은 값)
+    StreamStats stats() const { return m_stats; }
+    /// 서버 시계 보정 상태(캡처 시각을 로컬 시계로 옮길 때 쓰는 오프셋)
+    const ClockSync &clock() const { return m_clock; }
+    /// 지금 적용 중인 디코드 fps 상한(0 = 없음)
+    int fpsCap() const;
+    /// 구독자가 요구한 fps 상한만(전역 예산 제외, 0 = 없음) — 서버 요청 fps
+    int subscriberFpsCap() const;
+    /// 허브 전역 예산이 정한 상한(0 = 없음) — StreamHub만 호출
+    void setBudgetFps(int fps);
+    int budgetFps() const { return m_budgetFps; }
+
+    /**
+     * @brief 사건 이전 구간 링 버퍼 길이(ms, 0 = 끔)
+     *  - 스트림 중 완성 파트를 압축 상태 그대로 보관(메모리 상한 kPreRollMaxBytes)
+     *  - 여러 녹화기가 요청하면 가장 긴 값을 쓰는 것은 호출자 몫(현재는 ClipRecorder 하나)
+     */
+    void setPreRoll(int ms);
+    /// 링 버퍼 스냅샷(오래된 것부터)
+    QList<StreamPart> preRoll() const { return m_ring; }
+
+    /**
+     * @brief 구독자 등록/갱신/해제
+     *  - hint: 표시 크기(디코드 크기 = 구독자 중 최대)
+     *  - active: 화면에 보이는지. 보이는 구독자가 하나라도 있으면 전체 속도 스트림
+     *  - decode: false면 프레임 디코드를 요구하지 않음(녹화 탭: 스트림 유지 + partReceived만)
+     *  - 구독자가 모두 떠난 동안(허브의 정리 대기)은 현재 모드를 유지
+     */
+    void subscribe(QObject *sub, const QSize &hint, bool active = true, bool decode = true);
+    void setHint(QObject *sub, const QSize &hint);
+    /// 구독자의 디코드 fps 상한(0 = 제한 없음). 보이는 디코드 구독자 중 가장 높은 요구를 따름
+    void setMaxFps(QObject *sub, int fps);
+    void setActive(QObject *sub, bool active);
+    void unsubscribe(QObject *sub);
+    /// 구독자가 모두 떠남 → ms 뒤 lingerExpired(다시 부르면 처음부터 다시, 그사이 subscribe하면 취소)
+    void startLinger(int ms) { m_lingerTimer.start(ms); }
+
+signals:
+    /// 디코드 완료된 최신 프레임(+ 구간 시각, decodedMs는 이 신호 직전)
+    void frameReady(const QImage &img, const FrameTiming &timing);
+    /// 연결 상태 문구("연결 중…", "연결 오류, 재시도 중…", 스트리밍 시작 시 빈 문자열)
+    void statusChanged(const QString &text);
+    /// 1초마다 갱신된 통계
+    void statsUpdated(const StreamStats &stats);
+    /// 연결 상태 변화
+    void healthChanged(ReconnectPolicy::Health h);
+    /// 완성 파트 하나(디코드 드롭 여부와 무관하게 전부, 압축 상태 그대로)
+    void partReceived(const FrameSlice &jpeg, qint64 ms);
+    /// startLinger 대기가 끝남(허브가 정리 여부 판단)
+    void lingerExpired();
+
+private slots:
+    void onReadyRead();
+    void onFinished();
+    void onError(QNetworkReply::NetworkError);
+    void retry();
+    void onStalled();                         ///< 연결은 있으나 프레임 끊김 → 끊고 백오프
+    void pollFrame();                         ///< 숨김 상태: /frame.jpg 한 장 요청
+    void updateStats();                       ///< 1초 구간 카운터 → m_stats, statsUpdated
+    void renegotiate();                       ///< 요청 파라미터가 바뀌었으면 새 쿼리로 다시 연결
+
+private:
+    struct Sub {
+        QSize hint;
+        bool active = true;
+        bool decode = true;          ///< 디코드된 프레임을 쓰는 구독자(뷰)인지
+        int maxFps = 0;              ///< 디코드 fps 상한(0 = 제한 없음)
+    };
+
+    void start();                             ///< 스트림 연결(이미 연결 중이면 다시 연결)
+    void stop();                              ///< 스트림/폴링 정리(진행 중 디코드 결과는 버림)
+    void updateMode();                        ///< 구독자 가시성 → 스트림/폴링 전환
+    QUrl frameUrl() const;                    ///< 스트림 URL의 마지막 경로를 frame.jpg로 바꾼 단일 프레임 URL
+    QUrl requestUrl() const;                  ///< 스트림 URL + 협상 쿼리(URL에 직접 적은 값이 우선)
+    QUrlQuery requestQuery() const;           ///< 구독자 요구 + 자동 단계 → w/fps/q
+    void scheduleRenegotiate();               ///< 구독자 요구 변화 → 잠시 모아서 renegotiate
+    void setStatus(const QString &text);
+    void scheduleRetry(const QString &reason); ///< 연결 정리 후 백오프 예약 + "…, N초 후 재시도" 문구
+    void parseBuffer();                       ///< 완성 파트 중 최신 것만 디코드로
+    void submitDecode(const FrameSlice &jpg, const FrameTiming &timing); ///< 대기 슬롯 1칸을 최신 JPEG으로 덮어씀
+    /// 수신 완료 시각 + X-Capture-Ts(서버 epoch ms, 없으면 빈 값) → 로컬 시계 기준 구간 시각
+    FrameTiming arrivalTiming(const QByteArray &captureTs) const;
+    void decodeNext();                        ///< 진행 중 디코드가 없으면 대기 슬롯을 워커로
+    QSize decodeBox() const;                  ///< 구독자 표시 크기 중 최대(없으면 invalid = 원본)
+    void recordDecode(qint64 us);             ///< 디코드 시간 표본 1건(원형 버퍼)
+    bool wantsDecode() const;                 ///< 보이는 디코드 구독자가 있는지
+    void tapPart(const FrameSlice &jpg);      ///< 링 버퍼 적재 + partReceived
+
+    QUrl m_url;
+    QNetworkAccessManager m_nam;
+    QNetworkReply *m_reply{nullptr};
+    MjpegParser m_parser;
+    bool m_typeSeen{false};          ///< 이번 연결의 Content-Type을 파서에 알렸는지
+    ReconnectPolicy m_policy;
+    StreamQuality m_quality;
+    ClockSync m_clock;               ///< 서버 /clock 오프셋(X-Capture-Ts 보정)
+    QString m_requestQuery;          ///< 현재 연결에 보낸 협상 쿼리
+    QTimer m_negotiateTimer;         ///< 구독자 요구 변화 디바운스(리사이즈 중 재연결 폭주 방지)
+    QTimer m_lingerTimer;            ///< 마지막 구독자가 떠난 뒤 정리 대기(소스당 하나, 재시작 가능)
+    QString m_status;
+    QImage m_lastImg;
+
+    QHash<QObject*, Sub> m_subs;     ///< 구독자 → 표시 크기/가시성
+    bool m_live{false};              ///< 전체 속도 스트림 모드(보이는 구독자 있음)
+
+    QTimer m_pollTimer;              ///< 숨김 상태 정지 화면 갱신
+    QNetworkReply *m_pollReply{nullptr};
+    int m_hiddenPollMs;
+    bool m_pollUnsupported{false};   ///< 서버에 /frame.jpg가 없음(404) → 숨김 상태에서는 완전 정지
+
+    FrameSlice m_pending;            ///< 다음에 디코드할 최신 JPEG(1칸)
+    FrameTiming m_pendingTiming;     ///< m_pending의 캡처/수신 시각
+    quint64 m_dropped{0};
+    bool m_decoding{false};          ///< 워커에서 디코드 중(소스당 최대 1건)
+    quint64 m_epoch{0};              ///< stop()마다 증가 — 이전 연결의 늦은 디코드 결과 폐기
+    int m_budgetFps{0};              ///< 허브 전역 예산 상한(0 = 없음)
+    QElapsedTimer m_decodeClock;     ///< 마지막 디코드 시작 시각(fps 상한 간격 계산)
+    QTimer m_throttleTimer;          ///< fps 상한 때문에 미룬 디코드를 다시 시도
+
+    // ── 통계 ─────────────────────────────────────────────
+    static constexpr int kDecodeSamples = 120;   ///< 디코드 시간 표본 수(30fps 기준 약 4초)
+    QTimer m_statsTimer;
+    QElapsedTimer m_statsClock;      ///< 구간 길이 측정(타이머 지연 보정)
+    StreamStats m_stats;
+    int m_rxFrames{0};               ///< 이번 구간 수신 완성 프레임
+    int m_decFrames{0};              ///< 이번 구간 디코드 완료
+    qint64 m_rxBytes{0};             ///< 이번 구간 수신 바이트
+    int m_backlog{0};                ///< 이번 구간 디코드가 바빠서 버린 프레임(자동 단계 판단용)
+    QVector<qint32> m_decodeUs;      ///< 최근 디코드 시간(µs) 원형 버퍼
+    int m_decodeNext{0};
+
+    // ── 녹화 탭 ─────────────────────────────────────────
+    static constexpr qint64 kPreRollMaxBytes = 64 << 20;   ///< 링 버퍼 메모리 상한(소스당)
+    int m_preRollMs{0};
+    QList<StreamPart> m_ring;        ///< 최근 m_preRollMs 구간 파트(오래된 것부터)
+    qint64 m_ringBytes{0};
+};
+
+class StreamHub : public QObject {
+    Q_OBJECT
+public:
+    /// 프로세스 전역 허브(QApplication 수명)
+    static StreamHub *instance();
+
+    /**
+     * @brief URL의 공유 소스를 얻음(참조 +1). 없으면 만들어 연결 시작.
+     * @param hint   구독자 표시 크기(디코드 크기 결정에 사용)
+     * @param active 구독자가 화면에 보이는지(보이지 않는 구독자만 있으면 스트림을 열지 않음)
+     * @param decode 디코드된 프레임이 필요한지(false = 녹화 등 압축 파트만 쓰는 구독자)
+     */
+    StreamSource *acquire(const QUrl &url, QObject *subscriber, const QSize &hint = {}, bool active = true,
+                          bool decode = true);
+    /// 구독 해제(참조 -1). 0이 되면 kLingerMs 뒤 연결을 닫고 소스를 정리
+    void release(StreamSource *src, QObject *subscriber);
+
+    /// 현재 열린 소스 목록(진단용)
+    QList<StreamSource*> sources() const { return m_sources.values(); }
+
+    /// 같은 스트림으로 볼 URL 키(중복 슬래시/끝 슬래시 무시)
+    static QString keyOf(const QUrl &url);
+
+    /// 캡처 → 화면 지연 목표(ms, [stream] latency_slo_ms)
+    int latencySloMs() const { return m_latencySloMs; }
+
+private:
+    explicit StreamHub(QObject *parent = nullptr);
+
+    /// 전역 디코드 예산에 맞춰 소스별 fps 상한 조정(1초마다)
+    void rebalance();
+
+    static constexpr int kLingerMs = 3000;
+    static constexpr int kMinBudgetFps = 2;   ///< 예산이 모자라도 타일이 멈춰 보이지 않을 최소치
+    QHash<QString, StreamSource*> m_sources;
+    double m_budgetMs = 0;           ///< 초당 디코드에 쓸 수 있는 시간(ms, 0 = 조정 안 함)
+    QTimer m_budgetTimer;
+    int m_hiddenPollMs = 5000;       ///< [stream] hidden_poll_sec
+    ReconnectPolicy::Params m_reconnect;   ///< [stream] reconnect_base_ms/reconnect_max_ms/stall_sec
+    StreamQuality::Params m_quality;       ///< [stream] adaptive/adaptive_down_sec/adaptive_up_sec
+    int m_latencySloMs = 500;        ///< [stream] latency_slo_ms
+};
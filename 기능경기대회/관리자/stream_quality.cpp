@@ -0,0 +1,117 @@
+#include "stream_quality.h"
+#include <QSettings>
+#include <cmath>
+
+namespace {
+
+struct Level {
+    int quality;      ///< JPEG 품질(0 = 서버 기본)
+    int sizeSteps;    ///< 폭 단계를 몇 칸 내릴지
+    int fpsDiv;       ///< fps 나눗수
+};
+constexpr Level kLevels[StreamQuality::kMaxLevel + 1] = {
+    {0, 0, 1}, {50, 0, 1}, {40, 1, 1}, {35, 1, 2}, {30, 2, 2},
+};
+
+constexpr int kWidths[] = {320, 480, 640, 960, 1280};
+constexpr int kWidthCount = int(sizeof(kWidths) / sizeof(kWidths[0]));
+constexpr int kFpsSteps[] = {1, 2, 3, 5, 8, 10, 12, 15, 20, 25, 30};
+
+int roundUpFps(int fps){
+    for(int f : kFpsSteps) if(f >= fps) return f;
+    return fps;
+}
+
+} // namespace
+
+StreamQuality::Params StreamQuality::fromSettings(const QString &iniPath){
+    Params p;
+    QSettings ini(iniPath, QSettings::IniFormat);
+    ini.beginGroup("stream");
+    p.enabled = ini.value("adaptive", p.enabled).toBool();
+    p.downSec = qMax(1, ini.value("adaptive_down_sec", p.downSec).toInt());
+    p.upSec   = qMax(p.downSec, ini.value("adaptive_up_sec", p.upSec).toInt());
+    ini.endGroup();
+    return p;
+}
+
+/*
+ * 폭: box 폭 이상인 첫 단계(없으면 원본 = kWidthCount)에서 sizeSteps만큼 내림. 원본 단계면 w 생략.
+ *     box가 없으면(녹화 탭의 원본 요청) 단계와 무관하게 w를 보내지 않음 — 증거 영상은 줄이지 않는다.
+ * fps: 상한이 있으면 그 값, 없으면 서버 최대 fps를 fpsDiv로 나눔(0단계처럼 나눗수 1이면 생략).
+ */
+QUrlQuery StreamQuality::query(const QSize &box, int fpsCap) const{
+    QUrlQuery q;
+    if(!m_params.enabled) return q;
+    const Level &lv = kLevels[m_level];
+
+    if(box.isValid()){
+        int idx = kWidthCount;
+        for(int i = 0; i < kWidthCount; ++i)
+            if(kWidths[i] >= box.width()){ idx = i; break; }
+        idx = qMax(0, idx - lv.sizeSteps);
+        if(idx < kWidthCount) q.addQueryItem("w", QString::number(kWidths[idx]));
+    }
+
+    int fps = fpsCap;
+    if(lv.fpsDiv > 1){
+        const int base = fpsCap > 0 ? fpsCap : int(std::ceil(m_maxServerFps));
+        if(base > 0) fps = qMax(1, base / lv.fpsDiv);
+    }
+    if(fps > 0) q.addQueryItem("fps", QString::number(roundUpFps(fps)));
+    if(lv.quality > 0) q.addQueryItem("q", QString::number(lv.quality));
+    return q;
+}
+
+void StreamQuality::setAdvertised(const QByteArray &value){
+    m_advertised = value.trimmed();
+    m_serverFps = 0;
+    for(const QByteArray &kv : m_advertised.split(';')){
+        const int eq = kv.indexOf('=');
+        if(eq > 0 && kv.left(eq).trimmed() == "fps") m_serverFps = kv.mid(eq + 1).toDouble();
+    }
+    m_maxServerFps = qMax(m_maxServerFps, m_serverFps);
+}
+
+void StreamQuality::restart(){
+    m_bad = m_good = 0;
+    m_skip = true;
+}
+
+bool StreamQuality::sample(int frames, int backlog, double recvFps){
+    if(!m_params.enabled || !negotiated()) return false;
+    if(m_skip){ m_skip = false; return false; }
+
+    const bool linkKnown = m_serverFps > 0 && !m_serverBound;
+    const bool backedUp  = frames >= 3 && backlog * 5 >= frames;
+    const bool congested = linkKnown && recvFps < m_serverFps * 0.6;
+    const bool clean     = backlog * 20 <= frames && (!linkKnown || recvFps >= m_serverFps * 0.85);
+    m_bad  = (backedUp || congested) ? m_bad + 1 : 0;
+    m_good = clean ? m_good + 1 : 0;
+
+    if(m_bad >= m_params.downSec){
+        if(!backedUp && m_congestRecv > 0 && recvFps <= m_congestRecv * 1.1){
+            // 혼잡으로 내렸는데 수신 fps가 그대로 → 병목은 링크가 아니라 서버(추론 속도 등).
+            // 혼잡 판단을 끄고 그 단계는 되돌림
+            m_serverBound = true;
+            m_congestRecv = 0;
+            m_bad = m_good = 0;
+            if(m_level == 0) return false;
+            --m_level;
+            return true;
+        }
+        if(m_level < kMaxLevel){
+            ++m_level;
+            m_congestRecv = backedUp ? 0 : recvFps;
+            m_bad = m_good = 0;
+            return true;
+        }
+    }
+    if(m_good >= m_params.upSec && m_level > 0){
+        --m_level;
+        m_congestRecv = 0;
+        m_bad = m_good = 0;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file stream_quality.h
+ * @brief 스트림 품질 협상(요청 파라미터 w/fps/q) 및 자동 단계 조정.
+ *
+ * 배경
+ *  - 썸네일 타일과 확대 보기가 같은 640×480 · 품질 65 스트림을 받았다. 작은 타일은 받은 뒤 버리고,
+ *    혼잡한 화재 카메라 링크에서는 큰 프레임이 밀려 지연과 드롭이 같이 늘었다.
+ *
+ * 요청(stream_server.py가 쿼리로 받음, 적용값은 응답 헤더 X-Stream-Params로 돌려줌)
+ *  - w  : 구독자 최대 표시 폭을 단계(320/480/640/960/1280)로 올림 — 크기 변경마다 재연결하지 않도록
+ *         원본 이상이면 생략(서버는 키우지 않음)
+ *  - fps: 구독자/전역 예산 fps 상한(StreamSource::fpsCap)을 단계로 올림, 없으면 생략
+ *  - q  : 자동 단계가 정함(0단계는 생략 = 서버 기본)
+ *  소스는 카메라당 하나이므로 파라미터는 "가장 많이 요구하는 구독자" 기준이다.
+ *
+ * 자동 단계(1초 표본, sample())
+ *  - 내림: 디코드가 밀림(수신 프레임의 20% 이상이 디코드 대기 중 덮어써짐) 또는
+ *          링크 혼잡(수신 fps < 서버가 약속한 fps의 60%)이 down_sec 연속
+ *  - 올림: 둘 다 깨끗한 상태가 up_sec 연속(내릴 때보다 훨씬 보수적으로)
+ *  - 단계: 0(요청 그대로) → 1(q50) → 2(q40, 한 단계 작게) → 3(q35, fps 절반) → 4(q30, 두 단계 작게)
+ *  - 혼잡으로 내렸는데 수신 fps가 나아지지 않으면 병목이 서버(추론 속도 등)이므로 되돌리고 혼잡 판단을 끔
+ *  - 서버가 X-Stream-Params를 보내지 않으면(파라미터를 모르는 서버) 단계를 바꾸지 않음
+ *
+ * 설정(admin_client.ini [stream], fromSettings()로 읽음)
+ *  - adaptive(기본 true, false면 쿼리 없이 예전처럼 요청), adaptive_down_sec(기본 3), adaptive_up_sec(기본 20)
+ */
+
+#include <QByteArray>
+#include <QSize>
+#include <QString>
+#include <QUrlQuery>
+
+class StreamQuality {
+public:
+    struct Params {
+        bool enabled = true;
+        int downSec = 3;
+        int upSec = 20;
+    };
+    static constexpr int kMaxLevel = 4;
+
+    /// admin_client.ini [stream] 값(파일/키가 없으면 기본값)
+    static Params fromSettings(const QString &iniPath);
+    void setParams(const Params &p) { m_params = p; }
+    bool enabled() const { return m_params.enabled; }
+
+    /**
+     * @brief 요청 쿼리(w/fps/q)
+     * @param box    구독자 최대 표시 크기(invalid = 모름 → 원본)
+     * @param fpsCap 디코드 fps 상한(0 = 없음)
+     */
+    QUrlQuery query(const QSize &box, int fpsCap) const;
+
+    /// 응답 헤더 X-Stream-Params 값 반영(없으면 빈 값 → 협상 미지원 서버)
+    void setAdvertised(const QByteArray &value);
+    bool negotiated() const { return !m_advertised.isEmpty(); }
+    /// 서버가 적용한 값("w=320;h=240;fps=8;q=50")
+    QString advertised() const { return QString::fromLatin1(m_advertised); }
+    /// 서버가 약속한 fps(모르면 0)
+    double serverFps() const { return m_serverFps; }
+
+    /**
+     * @brief 1초 표본 → 단계를 바꿨으면 true(호출자가 새 쿼리로 재연결)
+     * @param frames  이번 구간 수신 완성 프레임
+     * @param backlog 디코드가 바빠서 덮어쓴(버린) 프레임
+     * @param recvFps 수신 fps
+     */
+    bool sample(int frames, int backlog, double recvFps);
+    /// 새 연결 시작: 연속 카운터 초기화, 첫 표본(연결 직후 불완전 구간)은 건너뜀
+    void restart();
+
+    int level() const { return m_level; }
+
+private:
+    Params m_params;
+    int m_level = 0;
+    int m_bad = 0;                  ///< 나쁜 표본 연속 수
+    int m_good = 0;                 ///< 깨끗한 표본 연속 수
+    bool m_skip = true;             ///< 다음 표본 무시
+    QByteArray m_advertised;
+    double m_serverFps = 0;
+    double m_maxServerFps = 0;      ///< 지금까지 서버가 약속한 최대 fps(= 서버 기본, fps 절반 단계의 기준)
+    double m_congestRecv = 0;       ///< 혼잡으로 단계를 내릴 때의 수신 fps(내린 효과 확인용, 0 = 해당 없음)
+    bool m_serverBound = false;     ///< 서버가 약속한 fps를 스스로 못 냄 → 혼잡 판단 끔(소스 수명 동안)
+};
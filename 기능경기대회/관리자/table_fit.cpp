@@ -0,0 +1,148 @@
+#include "table_fit.h"
+#include <QTableView>          // 대상 뷰(QTableWidget 포함)
+#include <QHeaderView>         // 열 모드/너비 조절
+#include <QAbstractItemModel>  // 행/열 수, 표시 텍스트 조회
+#include <QFontMetrics>        // 글자 폭 측정
+
+namespace {
+constexpr int kCellPadding = 24;   // 셀 좌우 패딩(QSS padding 4px 8px + 그리드/포커스 여유)
+constexpr int kHeadPadding = 28;   // 헤더 좌우 패딩(굵은 글꼴 + 정렬 표시 여유)
+constexpr int kMinWidth    = 48;   // 자동 맞춤 하한
+}
+
+TableColumnFitter::TableColumnFitter(QTableView* view)
+    : QObject(view), view_(view)
+{
+    idle_.setSingleShot(true);
+    idle_.setInterval(300);
+    connect(&idle_, &QTimer::timeout, this, [this]{ fit(false); });
+
+    // 사용자가 헤더 경계를 끌어서 바꾼 열은 자동 맞춤에서 제외
+    connect(view->horizontalHeader(), &QHeaderView::sectionResized, this,
+            [this](int logical, int, int){ if (!resizing_) userSized_.insert(logical); });
+    // 헤더 더블클릭 = 명시적 재맞춤 요청
+    connect(view->horizontalHeader(), &QHeaderView::sectionDoubleClicked, this, &TableColumnFitter::fitNow);
+
+    rewatchModel();
+}
+
+TableColumnFitter* TableColumnFitter::install(QTableView* view)
+{
+    if (!view) return nullptr;
+    if (auto* existing = view->findChild<TableColumnFitter*>(QString(), Qt::FindDirectChildrenOnly))
+        return existing;
+    auto* f = new TableColumnFitter(view);
+    f->fitNow();
+    return f;
+}
+
+void TableColumnFitter::rewatchModel()
+{
+    if (model_) disconnect(model_, nullptr, this, nullptr);
+    model_ = view_ ? view_->model() : nullptr;
+    if (!model_) return;
+
+    // 행 추가/값 변경/리셋은 모두 "유휴 후 1회"로 합친다(행마다 재측정하지 않음)
+    connect(model_, &QAbstractItemModel::rowsInserted, this, &TableColumnFitter::scheduleFit);
+    connect(model_, &QAbstractItemModel::dataChanged,  this, &TableColumnFitter::scheduleFit);
+    connect(model_, &QAbstractItemModel::modelReset,   this, &TableColumnFitter::scheduleFit);
+    connect(model_, &QAbstractItemModel::layoutChanged,this, &TableColumnFitter::scheduleFit);
+}
+
+void TableColumnFitter::scheduleFit()
+{
+    if (!idle_.isActive()) pendingSince_.start();
+    // 폭주(초당 수십 행) 중에도 상한 시간이 지나면 한 번은 맞춘다
+    if (pendingSince_.isValid() && pendingSince_.elapsed() >= maxLatencyMs_) {
+        fit(false);
+        return;
+    }
+    idle_.start();
+}
+
+void TableColumnFitter::fitNow()
+{
+    userSized_.clear();
+    fit(true);
+}
+
+void TableColumnFitter::fit(bool force)
+{
+    idle_.stop();
+    pendingSince_.invalidate();
+    if (!view_) return;
+    if (view_->model() != model_) rewatchModel();   // setModel() 이후 호출 누락 대비
+    auto* model = view_->model();
+    auto* hh    = view_->horizontalHeader();
+    if (!model || !hh) return;
+
+    const int cols = model->columnCount();
+    const QVector<int> rows = pickSampleRows(model->rowCount());
+
+    resizing_ = true;
+    for (int c = 0; c < cols; ++c) {
+        if (hh->isSectionHidden(c)) continue;
+        if (hh->sectionResizeMode(c) == QHeaderView::Stretch) continue;
+        if (hh->stretchLastSection() && c == cols - 1) continue;
+        if (!force && userSized_.contains(c)) continue;
+        hh->resizeSection(c, estimateColumn(c, rows));
+    }
+    resizing_ = false;
+}
+
+/**
+ * @brief 측정할 행 번호 선택
+ *  - 현재 뷰포트에 보이는 행을 우선(사용자가 실제로 보는 값 기준)
+ *  - 남는 표본 수는 전체 행에서 균등 간격으로 추출(긴 값의 분포 반영)
+ */
+QVector<int> TableColumnFitter::pickSampleRows(int rowCount) const
+{
+    QVector<int> out;
+    if (rowCount <= 0) return out;
+    if (rowCount <= sampleRows_) {
+        out.reserve(rowCount);
+        for (int r = 0; r < rowCount; ++r) out << r;
+        return out;
+    }
+
+    out.reserve(sampleRows_);
+    int first = view_->rowAt(0);
+    int last  = view_->rowAt(view_->viewport()->height() - 1);
+    if (first < 0) first = 0;
+    if (last  < 0) last  = qMin(rowCount - 1, first + sampleRows_ / 2);
+    for (int r = first; r <= last && out.size() < sampleRows_ / 2; ++r) out << r;
+
+    const int remain = sampleRows_ - out.size();
+    const double step = double(rowCount) / qMax(1, remain);
+    for (int i = 0; i < remain; ++i) {
+        const int r = qMin(rowCount - 1, int(i * step));
+        if (r < first || r > last) out << r;
+    }
+    return out;
+}
+
+int TableColumnFitter::estimateColumn(int col, const QVector<int>& rows) const
+{
+    auto* model = view_->model();
+    auto* hh    = view_->horizontalHeader();
+
+    const QFontMetrics fmCell(view_->font());
+    const QFontMetrics fmHead(hh->font());
+
+    // 상한 너비를 넘는 글자는 측정할 필요가 없음 → 필요한 글자 수까지만 잘라 측정
+    const int avg = qMax(1, fmCell.averageCharWidth());
+    const int maxChars = maxWidth_ / avg + 4;
+
+    const QString head = model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString();
+    int w = fmHead.horizontalAdvance(head) + kHeadPadding;
+
+    for (int r : rows) {
+        QString s = model->data(model->index(r, col), Qt::DisplayRole).toString();
+        if (s.size() > maxChars) s.truncate(maxChars);
+        const int nl = s.indexOf('\n');
+        if (nl >= 0) s.truncate(nl);       // 여러 줄 값은 첫 줄만(표에서는 한 줄로 표시)
+        w = qMax(w, fmCell.horizontalAdvance(s) + kCellPadding);
+        if (w >= maxWidth_) break;
+    }
+    return qBound(kMinWidth, w, maxWidth_);
+}
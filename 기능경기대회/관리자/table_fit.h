@@ -0,0 +1,68 @@
+#pragma once
+/**
+ * @file table_fit.h
+ * @brief 표(QTableView/QTableWidget) 열 너비를 "표본 행 + 폰트 메트릭"으로 추정하는 공용 헬퍼.
+ *
+ * 배경
+ *  - QHeaderView::ResizeToContents는 행이 추가/변경될 때마다 모든 행을 다시 측정한다.
+ *    설명 열에 긴 JSON 문자열이 들어오는 알람 테이블에서는 insertRow 한 번이 곧 전체 재측정이 된다.
+ *
+ * 동작
+ *  - 열 모드는 Interactive로 두고, 이 헬퍼가 일부 행(보이는 행 + 균등 간격 표본)만 측정해 너비를 정한다.
+ *  - 긴 문자열은 최대 너비에 필요한 글자 수까지만 잘라서 측정(수 KB JSON도 상수 비용).
+ *  - 모델 변경 시에는 즉시 측정하지 않고 유휴(idle) 타이머로 모아서 1회만 재계산.
+ *  - 사용자가 직접 조절한 열은 자동 재계산에서 제외, fitNow()(명시 요청/헤더 더블클릭)에서만 다시 맞춘다.
+ *  - Stretch 모드 열과 stretchLastSection의 마지막 열은 건드리지 않는다.
+ *
+ * 사용 예:
+ *   table->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+ *   table->horizontalHeader()->setStretchLastSection(true);
+ *   TableColumnFitter::install(table);
+ */
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QSet>
+
+class QTableView;
+class QAbstractItemModel;
+
+class TableColumnFitter : public QObject {
+    Q_OBJECT
+public:
+    explicit TableColumnFitter(QTableView* view);
+
+    /// 뷰에 헬퍼를 붙이고(소유자=뷰) 즉시 1회 맞춤. 이미 붙어 있으면 기존 인스턴스 반환.
+    static TableColumnFitter* install(QTableView* view);
+
+    void setSampleRows(int n)      { sampleRows_ = qMax(1, n); }   ///< 측정할 최대 표본 행 수
+    void setMaxColumnWidth(int px) { maxWidth_ = qMax(40, px); }   ///< 자동 맞춤 상한(px)
+    void setIdleDelay(int ms)      { idle_.setInterval(ms); }      ///< 변경 후 재계산까지 대기(ms)
+
+    /// 뷰의 모델이 교체된 뒤 호출(새 모델의 변경 신호를 다시 구독)
+    void rewatchModel();
+
+public slots:
+    /// 명시 요청: 사용자 조절 표시를 지우고 모든 열을 다시 맞춤
+    void fitNow();
+    /// 유휴 재계산 예약(연속 변경은 하나로 합침, 최대 지연 상한 있음)
+    void scheduleFit();
+
+private:
+    void fit(bool force);
+    QVector<int> pickSampleRows(int rowCount) const;
+    int  estimateColumn(int col, const QVector<int>& rows) const;
+
+    QPointer<QTableView>         view_;
+    QPointer<QAbstractItemModel> model_;
+    QTimer        idle_;                 ///< 유휴 타이머(싱글샷)
+    QElapsedTimer pendingSince_;         ///< 첫 예약 시각(폭주 시에도 maxLatencyMs_ 안에는 1회 맞춤)
+    QSet<int>     userSized_;            ///< 사용자가 직접 조절한 열(자동 맞춤 제외)
+    bool          resizing_ = false;     ///< 내부 resizeSection 중 여부(사용자 조절과 구분)
+    int           sampleRows_   = 48;
+    int           maxWidth_     = 360;
+    int           maxLatencyMs_ = 2000;
+};
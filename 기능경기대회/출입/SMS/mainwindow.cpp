@@ -67,6 +67,16 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent){
     applyTheme();
 
     nam = new QNetworkAccessManager(this);
+
+    // 스트림 재연결: 지터 있는 지수 백오프 + 프레임 끊김 감지(관리자 클라이언트와 같은 정책)
+    mjpegRetry = new ReconnectPolicy(this);
+    connect(mjpegRetry, &ReconnectPolicy::retryRequested, this, &MainWindow::startMjpegStream);
+    connect(mjpegRetry, &ReconnectPolicy::stalled,        this, &MainWindow::retryMjpegLater);
+    connect(mjpegRetry, &ReconnectPolicy::healthChanged,  this, [this](ReconnectPolicy::Health h){
+        videoTitle->setText(h == ReconnectPolicy::Health::Live
+                                ? QString::fromUtf8("실시간 모니터링")
+                                : QString::fromUtf8("실시간 모니터링 · ") + ReconnectPolicy::healthText(h));
+    });
     startMjpegStream();
 
     statusTimer = new QTimer(this);
@@ -325,6 +335,10 @@ void MainWindow::drawFrame(const QPixmap &pix){
 
 /* ───────── MJPEG 스트림 & 상태 폴링 ───────── */
 void MainWindow::startMjpegStream(){
+    stopMjpegStream();
+    mjpegParser.reset();
+    mjpegTypeSeen = false;
+    mjpegRetry->connecting();
     QNetworkRequest req(serverBase + "/mjpeg");
     mjpegReply = nam->get(req);
     connect(mjpegReply, &QNetworkReply::readyRead,     this, &MainWindow::onMjpegReadyRead);
@@ -332,25 +346,41 @@ void MainWindow::startMjpegStream(){
     connect(mjpegReply, &QNetworkReply::errorOccurred, this, &MainWindow::onMjpegError);
 }
 void MainWindow::stopMjpegStream(){
-    if(mjpegReply){ mjpegReply->abort(); mjpegReply->deleteLater(); mjpegReply=nullptr; }
+    if(!mjpegReply) return;
+    disconnect(mjpegReply, nullptr, this, nullptr);   // abort()가 finished/error를 다시 부르지 않도록
+    mjpegReply->abort();
+    mjpegReply->deleteLater();
+    mjpegReply = nullptr;
+}
+void MainWindow::onMjpegError(QNetworkReply::NetworkError){ retryMjpegLater(); }
+void MainWindow::onMjpegFinished(){ retryMjpegLater(); }
+
+void MainWindow::retryMjpegLater(){
+    stopMjpegStream();
+    mjpegRetry->failed();
+    // 아직 한 장도 못 받았으면 빈 화면 대신 안내 문구(받은 적 있으면 마지막 프레임 유지)
+    if(lastFrame.isNull())
+        videoLabel->setText(QString::fromUtf8("영상 서버 연결 실패 · %1초 후 재시도")
+                                .arg((mjpegRetry->remainingMs() + 999) / 1000));
 }
-void MainWindow::onMjpegError(QNetworkReply::NetworkError){ }
-void MainWindow::onMjpegFinished(){ }
 
 void MainWindow::onMjpegReadyRead(){
-    mjpegBuf += mjpegReply->readAll();
-    while(true){
-        int soi = mjpegBuf.indexOf(QByteArray::fromHex("FFD8"));
-        if(soi < 0){ mjpegBuf.clear(); break; }
-        int eoi = mjpegBuf.indexOf(QByteArray::fromHex("FFD9"), soi+2);
-        if(eoi < 0) break;
-
-        QByteArray jpg = mjpegBuf.mid(soi, eoi - soi + 2);
-        mjpegBuf.remove(0, eoi + 2);
-
-        QPixmap pix; pix.loadFromData(jpg, "JPG");
-        if(!pix.isNull()){ lastFrame = pix; drawFrame(pix); }
+    if(!mjpegTypeSeen){
+        // 첫 조각: 응답 헤더의 boundary로 파서 모드 결정
+        mjpegParser.setContentType(mjpegReply->header(QNetworkRequest::ContentTypeHeader).toByteArray());
+        mjpegTypeSeen = true;
     }
+    mjpegParser.readFrom(mjpegReply);     // 소켓 → 파서 청크로 바로
+
+    // 완성 파트 중 최신 것만 표시(밀린 프레임은 디코드하지 않음)
+    MjpegParser::Part part, latest;
+    while(mjpegParser.next(&part)) latest = std::move(part);
+    if(latest.jpeg.isEmpty()) return;
+    mjpegRetry->frameArrived();
+
+    QPixmap pix;
+    pix.loadFromData(reinterpret_cast<const uchar *>(latest.jpeg.data()), uint(latest.jpeg.size()), "JPG");
+    if(!pix.isNull()){ lastFrame = pix; drawFrame(pix); }
 }
 
 void MainWindow::updateStatus(){
@@ -14,6 +14,8 @@
 #include <QPixmap>
 #include <QDialog>
 #include <QPushButton>
+#include "mjpeg_parser.h"   // 관리자/mjpeg_parser.h(CMake에서 include 경로 추가)
+#include "reconnect_policy.h" // 관리자/reconnect_policy.h(재연결 백오프/정지 감지 공용)
 
 // QJsonObject를 헤더에서 파라미터로 사용하므로 전방 선언만 필요
 class QJsonObject;
@@ -127,7 +129,9 @@ private: // ──────────────────────
     QString serverBase = "http://192.168.0.7:8000";   // 서버 베이스 URL (필요 시 여기만 수정)
     QNetworkAccessManager *nam = nullptr;           // HTTP 요청 전송자
     QNetworkReply *mjpegReply = nullptr;            // /mjpeg 응답 스트림
-    QByteArray mjpegBuf;                            // MJPEG 바운더리 버퍼
+    MjpegParser mjpegParser;                        // multipart 증분 파서(관리자 클라이언트와 공용)
+    bool mjpegTypeSeen = false;                     // 이번 연결의 Content-Type을 파서에 알렸는지
+    ReconnectPolicy *mjpegRetry = nullptr;          // 끊김/오류/프레임 끊김 시 백오프 재연결
     QPixmap lastFrame;                              // 마지막 프레임(리사이즈 시 재그리기)
 
     // 주기 상태 업데이트 타이머
@@ -168,6 +172,7 @@ private:
     void onMjpegReadyRead();
     void onMjpegFinished();
     void onMjpegError(QNetworkReply::NetworkError);
+    void retryMjpegLater();                   // 스트림 정리 후 백오프 예약(오류/종료/프레임 끊김 공통)
 
     // 상태 폴링 및 UI 반영
     void updateStatus();                      // /status GET 후 내부 상태 갱신
@@ -0,0 +1,248 @@
+# attendance_tools.py
+# - gate_check 원본 → daily_attendance 요약 테이블 관리용 오프라인 도구
+# - backfill: 기존 gate_check 기록으로 요약을 채움(트리거 도입 전 데이터, 1회성)
+# - compact : 같은 사원이 짧은 간격(QR 반복 판독)으로 여러 번 남긴 gate_check 행을 1건으로 압축
+#
+# 사용 예:
+#   python3 attendance_tools.py backfill                      # gate_check 전체 기간
+#   python3 attendance_tools.py backfill --from 2025-09-01 --to 2025-09-30
+#   python3 attendance_tools.py backfill --chunk-days 7       # 트랜잭션 하나가 다루는 일수
+#   python3 attendance_tools.py compact --dry-run             # 지울 행 수만 확인
+#   python3 attendance_tools.py compact --window 10           # 10초 안의 반복은 첫 행만 남김
+#
+# 접속 정보는 stream_server.py와 같은 환경변수(DB_HOST/DB_PORT/DB_USER/DB_PASS/DB_NAME)를 사용.
+# 요약 테이블/트리거 DDL은 ../daily_attendance.sql 참고.
+
+import os, sys, argparse                # 환경변수, 종료 코드, 명령행 파싱
+from collections import Counter         # 지울 행 값별 개수
+from datetime import date, datetime, timedelta
+import mysql.connector                  # MySQL 파이썬 커넥터(stream_server.py와 동일)
+
+DB_HOST = os.getenv("DB_HOST", "192.168.0.15")
+DB_PORT = int(os.getenv("DB_PORT", "3306"))
+DB_USER = os.getenv("DB_USER", "user1")
+DB_PASS = os.getenv("DB_PASS", "1234")
+DB_NAME = os.getenv("DB_NAME", "safetydb")
+GATE_DEDUP_SEC = float(os.getenv("GATE_DEDUP_SEC", "10"))  # stream_server.py 기록 시 중복 창과 같은 기본값
+
+
+def db_connect():
+    """ MySQL 연결 생성(자동 커밋 끔 → 구간별 트랜잭션으로 묶는다). """
+    con = mysql.connector.connect(
+        host=DB_HOST, port=DB_PORT, user=DB_USER, password=DB_PASS, database=DB_NAME
+    )
+    con.autocommit = False
+    return con
+
+
+def parse_day(s: str) -> date:
+    return datetime.strptime(s, "%Y-%m-%d").date()
+
+
+def gate_check_span(con):
+    """ gate_check에 기록이 있는 첫/마지막 날짜. 비어 있으면 (None, None). """
+    cur = con.cursor()
+    cur.execute("SELECT MIN(check_time), MAX(check_time) FROM gate_check")
+    lo, hi = cur.fetchone()
+    cur.close()
+    if lo is None:
+        return None, None
+    return lo.date(), hi.date()
+
+
+def day_chunks(d0: date, d1: date, days: int):
+    """ [d0, d1] 폐구간을 days일 단위 [a, b] 구간으로 나눔. """
+    a = d0
+    while a <= d1:
+        b = min(d1, a + timedelta(days=days - 1))
+        yield a, b
+        a = b + timedelta(days=1)
+
+
+# 원본 → 요약 집계 SQL
+# - check_time 범위 조건(인덱스 사용) + DATE() 그룹(요약 1행 = 하루 × 1인)
+# - 이미 있는 행은 트리거가 넣은 값과 병합(LEAST/GREATEST) → 백필과 실시간 삽입이 겹쳐도 안전
+# - check_count는 원본 기준 재계산 값으로 교체
+UPSERT_SQL = """
+INSERT INTO daily_attendance (day, emp_id, first_in, last_out, worked_sec, check_count)
+SELECT * FROM (
+    SELECT DATE(check_time) AS d, emp_id AS e,
+           MIN(check_time) AS fi, MAX(check_time) AS lo,
+           TIMESTAMPDIFF(SECOND, MIN(check_time), MAX(check_time)) AS ws,
+           COUNT(*) AS cnt
+      FROM gate_check
+     WHERE check_time >= %s AND check_time < %s
+     GROUP BY DATE(check_time), emp_id
+) AS s
+ON DUPLICATE KEY UPDATE
+    first_in    = LEAST(first_in, s.fi),
+    last_out    = GREATEST(last_out, s.lo),
+    worked_sec  = TIMESTAMPDIFF(SECOND, first_in, last_out),
+    check_count = s.cnt
+"""
+
+
+def rebuild_summary(con, d0: date, d1: date, replace: bool = False) -> int:
+    """
+    [d0, d1] 기간의 요약을 gate_check 원본으로 다시 계산(호출측 트랜잭션 안에서 실행).
+    - replace=True: 기간의 요약 행을 먼저 지우고 새로 채움(원본 행이 삭제/압축된 뒤 사용)
+    반환: 영향 행 수(MySQL 기준, 갱신 행은 2로 셈)
+    """
+    cur = con.cursor()
+    if replace:
+        cur.execute("DELETE FROM daily_attendance WHERE day BETWEEN %s AND %s", (d0, d1))
+    cur.execute(UPSERT_SQL, (d0, d1 + timedelta(days=1)))
+    n = cur.rowcount
+    cur.close()
+    return n
+
+
+def cmd_backfill(args) -> int:
+    with db_connect() as con:
+        span_lo, span_hi = gate_check_span(con)
+        if span_lo is None:
+            print("[backfill] gate_check가 비어 있음")
+            return 0
+        d0 = parse_day(args.date_from) if args.date_from else span_lo
+        d1 = parse_day(args.date_to) if args.date_to else span_hi
+
+        total = 0
+        for a, b in day_chunks(d0, d1, args.chunk_days):
+            try:
+                n = rebuild_summary(con, a, b)
+                con.commit()                      # 구간 단위 커밋(긴 트랜잭션/락 방지)
+            except mysql.connector.Error as e:
+                con.rollback()
+                print(f"[backfill] {a}~{b} 실패: {e}")
+                return 1
+            total += n
+            print(f"[backfill] {a}~{b} 반영 {n}")
+        print(f"[backfill] 완료: {d0}~{d1}, 영향 행 {total}")
+    return 0
+
+
+def find_duplicates(rows, window_sec: float, kept=None):
+    """
+    rows: (check_time, emp_id, name, department) — 사원별로 check_time 순이면 됨(emp_id, check_time 정렬)
+    같은 사원의 연속 기록에서 "마지막으로 남긴 행"과의 간격이 window_sec 미만이면 중복.
+    (클러스터의 첫 행만 남기고, 간격은 남긴 행 기준이라 긴 반복 구간도 window마다 1건은 남는다)
+    kept: {emp_id: 마지막으로 남긴 시각} — 앞 구간에서 이어받고 이 구간 결과로 갱신됨
+          → 날짜/구간 경계(자정)를 걸친 중복도 앞 행과 비교된다
+    반환: Counter{행 값 튜플: 지울 개수}
+    """
+    if kept is None:
+        kept = {}
+    drop = Counter()
+    for row in rows:
+        t, emp = row[0], row[1]
+        kept_at = kept.get(emp)
+        if kept_at is not None and (t - kept_at).total_seconds() < window_sec:
+            drop[row] += 1
+            continue
+        kept[emp] = t
+    return drop
+
+
+def seed_kept(con, a: date, window_sec: float) -> dict:
+    """
+    첫 구간 시작(a) 직전 window_sec 안의 기록으로 사원별 "남긴 행" 시각을 미리 채움.
+    그 앞 기록은 보지 않으므로 이 짧은 구간 안에서는 첫 행을 남긴 것으로 본다.
+    """
+    cur = con.cursor()
+    start = datetime.combine(a, datetime.min.time())
+    cur.execute(
+        "SELECT check_time, emp_id, name, department FROM gate_check "
+        " WHERE check_time >= %s AND check_time < %s ORDER BY emp_id, check_time",
+        (start - timedelta(seconds=window_sec), start))
+    kept = {}
+    find_duplicates(cur.fetchall(), window_sec, kept)
+    cur.close()
+    return kept
+
+
+def compact_range(con, a: date, b: date, window_sec: float, dry_run: bool, kept: dict) -> int:
+    """
+    [a, b] 기간의 중복 행 삭제 + 요약 재계산을 한 트랜잭션에서 수행.
+    - kept: 앞 구간까지의 사원별 마지막 남긴 시각(find_duplicates 참고, 이 구간 결과로 갱신)
+    - gate_check에는 PK가 없으므로 값이 같은 행을 DELETE … LIMIT k로 지운다(남길 1건은 보존)
+    - SELECT … FOR UPDATE로 구간을 잠가 압축 중 새 기록과 섞이지 않게 한다
+    """
+    cur = con.cursor()
+    cur.execute(
+        "SELECT check_time, emp_id, name, department FROM gate_check "
+        " WHERE check_time >= %s AND check_time < %s "
+        " ORDER BY emp_id, check_time FOR UPDATE",
+        (a, b + timedelta(days=1)))
+    drop = find_duplicates(cur.fetchall(), window_sec, kept)
+    removed = sum(drop.values())
+    if dry_run or removed == 0:
+        cur.close()
+        return removed
+
+    for (t, emp, name, dept), k in drop.items():
+        # name/department가 NULL인 행도 있으므로 NULL-safe 비교(<=>)
+        cur.execute(
+            "DELETE FROM gate_check "
+            " WHERE check_time = %s AND emp_id = %s AND name <=> %s AND department <=> %s "
+            " LIMIT %s",
+            (t, emp, name, dept, k))
+    cur.close()
+    rebuild_summary(con, a, b, replace=True)   # check_count/last_out이 바뀌므로 요약도 다시 계산
+    return removed
+
+
+def cmd_compact(args) -> int:
+    with db_connect() as con:
+        span_lo, span_hi = gate_check_span(con)
+        if span_lo is None:
+            print("[compact] gate_check가 비어 있음")
+            return 0
+        d0 = parse_day(args.date_from) if args.date_from else span_lo
+        d1 = parse_day(args.date_to) if args.date_to else span_hi
+
+        total = 0
+        kept = seed_kept(con, d0, args.window)   # 구간 사이(자정 포함)로 이어지는 비교 상태
+        for a, b in day_chunks(d0, d1, args.chunk_days):
+            try:
+                n = compact_range(con, a, b, args.window, args.dry_run, kept)
+                if args.dry_run:
+                    con.rollback()                # 잠금만 풀고 아무것도 바꾸지 않음
+                else:
+                    con.commit()
+            except mysql.connector.Error as e:
+                con.rollback()
+                print(f"[compact] {a}~{b} 실패: {e}")
+                return 1
+            total += n
+            if n:
+                print(f"[compact] {a}~{b} 중복 {n}건" + (" (dry-run)" if args.dry_run else " 삭제"))
+        print(f"[compact] 완료: {d0}~{d1}, 중복 {total}건"
+              + (" (dry-run, 변경 없음)" if args.dry_run else " 삭제"))
+    return 0
+
+
+def main(argv=None) -> int:
+    p = argparse.ArgumentParser(description="gate_check / daily_attendance 관리 도구")
+    sub = p.add_subparsers(dest="cmd", required=True)
+
+    bf = sub.add_parser("backfill", help="gate_check 기존 기록으로 daily_attendance 채우기")
+    bf.add_argument("--from", dest="date_from", help="시작일 YYYY-MM-DD(기본: 가장 이른 기록)")
+    bf.add_argument("--to", dest="date_to", help="종료일 YYYY-MM-DD(기본: 가장 늦은 기록)")
+    bf.add_argument("--chunk-days", type=int, default=7, help="트랜잭션 하나가 다루는 일수(기본 7)")
+    bf.set_defaults(func=cmd_backfill)
+
+    cp = sub.add_parser("compact", help="짧은 간격의 중복 gate_check 행을 1건으로 압축")
+    cp.add_argument("--from", dest="date_from", help="시작일 YYYY-MM-DD(기본: 가장 이른 기록)")
+    cp.add_argument("--to", dest="date_to", help="종료일 YYYY-MM-DD(기본: 가장 늦은 기록)")
+    cp.add_argument("--window", type=float, default=GATE_DEDUP_SEC,
+                    help=f"같은 사원 기록을 중복으로 볼 간격(초, 기본 {GATE_DEDUP_SEC:g})")
+    cp.add_argument("--chunk-days", type=int, default=1, help="트랜잭션 하나가 다루는 일수(기본 1)")
+    cp.add_argument("--dry-run", action="store_true", help="지울 행 수만 출력")
+    cp.set_defaults(func=cmd_compact)
+
+    args = p.parse_args(argv)
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -51,12 +51,16 @@ DB_NAME = os.getenv("DB_NAME", "safetydb")       # DB 스키마명
 QR_DEBOUNCE_SEC = float(os.getenv("QR_DEBOUNCE_SEC", "1.2"))  # 같은 QR 문자열의 재검출 무시 시간(디바운스)
 INFER_IMGSZ     = int(os.getenv("INFER_IMGSZ", "480"))        # YOLO 입력 해상도(작을수록 빠름, 정확도는 하락)
 STREAM_FPS      = float(os.getenv("STREAM_FPS", "12.0"))      # MJPEG 출력 프레임레이트 상한
+STREAM_QUALITY  = int(os.getenv("STREAM_QUALITY", "65"))      # 기본 JPEG 품질(클라이언트가 q로 낮출 수 있음)
+GATE_DEDUP_SEC  = float(os.getenv("GATE_DEDUP_SEC", "10"))    # 같은 사원의 gate_check 재기록 무시 시간(초, 0=끄기)
 
 # --- [NEW] 락 & 최근 QR 상태(중복 차단용) ---
 qr_lock     = threading.Lock()   # QR 처리 임계영역 보호용 락(다중 스레드 경쟁 방지)
 infer_lock  = threading.Lock()   # YOLO 추론 단일화 락(동시 추론 방지로 자원 보호)
 _last_qr_text = None             # 최근 처리한 QR 텍스트(디바운스 비교)
 _last_qr_at   = 0.0              # 최근 QR 처리 시각(epoch 초)
+gate_lock     = threading.Lock() # gate_check 중복 차단 상태 보호용 락
+_last_gate_at = {}               # emp_id → 마지막 gate_check 기록 시각(monotonic 초)
 # ---------------------------------------------------------------
 
 app = FastAPI()                  # FastAPI 앱 인스턴스 생성(라우팅/수명주기 관리)
@@ -123,27 +127,72 @@ def set_qr_to_emp(emp_id: int, qr_text: str):
         return cur.rowcount == 1               # 정확히 1건 갱신되면 True
 
 # [추가] QR 성공 시 게이트 기록
+# 중복 차단 SQL: 같은 사원의 기록이 최근 N초 안에 이미 있으면 아무것도 넣지 않음
+#  - 서버 재시작/게이트 서버 여러 대인 경우까지 DB 기준으로 한 번 더 거른다((emp_id, check_time) 인덱스 사용)
+#  - NOT EXISTS 검사와 INSERT 사이에 다른 게이트가 끼어들 수 있으므로(REPEATABLE READ에서도 둘 다 통과)
+#    사원별 이름 잠금(GET_LOCK) 안에서 실행하고, 커밋한 뒤에 잠금을 푼다
+#  - 창은 마이크로초 단위(GATE_DEDUP_SEC 소수 허용)
+GATE_LOCK_SQL    = "SELECT GET_LOCK(CONCAT('gate_check:', %s), %s)"
+GATE_UNLOCK_SQL  = "SELECT RELEASE_LOCK(CONCAT('gate_check:', %s))"
+GATE_LOCK_WAIT_SEC = 5                          # 다른 게이트가 같은 사원을 기록 중일 때 기다릴 최대 시간
+GATE_INSERT_DEDUP_SQL = """
+INSERT INTO gate_check (check_time, emp_id, name, department)
+SELECT NOW(), %s, %s, %s FROM DUAL
+ WHERE NOT EXISTS (
+       SELECT 1 FROM gate_check
+        WHERE emp_id = %s AND check_time >= NOW(6) - INTERVAL %s MICROSECOND)
+"""
+
 def log_gate_check(worker: dict):
     """
     gate_check(check_time, emp_id, name, department)에 1건 추가
     - check_time: NOW()
     - emp_id / name / department: employee 조회값 그대로 입력
-    DB 에러는 서비스 중단을 막기 위해 캣치 후 False 반환.
+    - 같은 사원이 GATE_DEDUP_SEC 안에 다시 인식되면 기록하지 않음(QR 반복 판독으로 인한 중복 행 방지)
+      1차: 프로세스 메모리(DB 왕복 없음), 2차: 사원별 GET_LOCK 안에서 INSERT … WHERE NOT EXISTS(DB 기준)
+    DB 에러는 서비스 중단을 막기 위해 캣치 후 False 반환. 중복으로 생략한 경우도 False.
     """
     if not worker:
         return False                           # 방어적 코딩: None 입력 시 무시
-    sql = """
-    INSERT INTO gate_check (check_time, emp_id, name, department)
-    VALUES (NOW(), %s, %s, %s)
-    """
+    emp_id = worker["emp_id"]
+
+    if GATE_DEDUP_SEC > 0:
+        now = time.monotonic()
+        with gate_lock:
+            last = _last_gate_at.get(emp_id)
+            if last is not None and now - last < GATE_DEDUP_SEC:
+                return False                   # 창 안의 반복 인식 → DB까지 가지 않음
+            _last_gate_at[emp_id] = now
+
     try:
         with db_connect() as con:
             cur = con.cursor()
-            cur.execute(sql, (worker["emp_id"], worker["name"], worker["department"]))
+            if GATE_DEDUP_SEC > 0:
+                cur.execute(GATE_LOCK_SQL, (emp_id, GATE_LOCK_WAIT_SEC))
+                (locked,) = cur.fetchone()
+                if locked != 1:
+                    raise mysql.connector.Error(msg=f"GET_LOCK timeout (emp_id={emp_id})")
+                try:
+                    con.commit()               # 잠금을 얻은 뒤 새 트랜잭션에서 검사(다른 게이트의 커밋이 보이게)
+                    cur.execute(GATE_INSERT_DEDUP_SQL,
+                                (emp_id, worker["name"], worker["department"], emp_id,
+                                 int(round(GATE_DEDUP_SEC * 1_000_000))))
+                    inserted = cur.rowcount == 1
+                    con.commit()               # 커밋 후 잠금 해제 → 다음 게이트는 이 행을 봄
+                finally:
+                    cur.execute(GATE_UNLOCK_SQL, (emp_id,))
+                    cur.fetchone()
+                return inserted                # False면 DB 기준 중복으로 생략됨
+            else:
+                cur.execute("INSERT INTO gate_check (check_time, emp_id, name, department) "
+                            "VALUES (NOW(), %s, %s, %s)",
+                            (emp_id, worker["name"], worker["department"]))
             con.commit()
-        return True
+            return cur.rowcount == 1
     except mysql.connector.Error as e:
         print(f"[gate_check] insert error: {e}")  # 오류 로깅만 하고 서비스 지속
+        with gate_lock:
+            _last_gate_at.pop(emp_id, None)    # 기록 실패 → 다음 인식 때 다시 시도
         return False
 
 # -------------------- 유틸 --------------------
@@ -275,12 +324,16 @@ def shutdown():
     except Exception: pass
 
 # -------------------- 메인 렌더 --------------------
-def render_frame():
-    """ 한 프레임을 캡처→오버레이/추론/판정→JPEG 인코딩하여 bytes 반환. 실패 시 None. """
+def render_frame(out_size=None, quality=STREAM_QUALITY, meta=None):
+    """ 한 프레임을 캡처→오버레이/추론/판정→JPEG 인코딩하여 bytes 반환. 실패 시 None.
+        out_size=(w,h)면 오버레이까지 그린 뒤 축소(INTER_AREA)해서 인코딩, quality는 JPEG 품질.
+        meta(dict)를 주면 meta["ts"]에 캡처 시각(epoch ms)을 채움(X-Capture-Ts 헤더용). """
     global _tracker, last_raw_frame, state_now, state_since, last_counts, PHASE, current_worker, last_qr_event
 
     with cap_lock:                                 # 스레드 안전한 캡처
         ok, frame = cap.read()
+    if meta is not None:
+        meta["ts"] = time.time() * 1000.0           # 캡처 직후 시각(추론/인코딩/전송 지연을 클라이언트가 잴 수 있게)
     if not ok or frame is None:                    # 캡처 실패 시 None 반환(상위에서 건너뜀)
         return None
     last_raw_frame = frame.copy()                   # 스냅샷 용으로 원본 보존
@@ -369,7 +422,9 @@ def render_frame():
                 last_counts = {"person": 0, "helmet_pass": 0}
                 last_qr_event = None                   # 최근 QR 이벤트 초기화
 
-    ok, jpg = cv2.imencode(".jpg", frame, [int(cv2.IMWRITE_JPEG_QUALITY), 65])  # JPEG 인코딩(품질65)
+    if out_size and out_size != (W, H):            # 클라이언트 요청 크기(추론/판정은 원본 기준 그대로)
+        frame = cv2.resize(frame, out_size, interpolation=cv2.INTER_AREA)
+    ok, jpg = cv2.imencode(".jpg", frame, [int(cv2.IMWRITE_JPEG_QUALITY), int(quality)])  # JPEG 인코딩
     return jpg.tobytes() if ok else None               # 성공 시 bytes, 실패 시 None 반환
 
 # -------------------- QR 처리 --------------------
@@ -393,6 +448,37 @@ def handle_qr_detected(qr_text: str):
     else:
         last_qr_event = {"type":"fail","id":last_qr_event_id,"qr":qr_text}     # 실패 이벤트 기록
 
+# -------------------- 스트림 파라미터 협상 --------------------
+def stream_params(w: int = 0, h: int = 0, fps: float = 0, q: int = 0):
+    """
+    쿼리 파라미터(w/h/fps/q) → 실제 적용값 dict(size, fps, quality).
+    - w/h: 하나만 오면 비율 유지. 원본보다 키우지 않음(0/생략 = 원본)
+    - fps: STREAM_FPS 이하(0/생략 = STREAM_FPS)
+    - q  : 20~95(0/생략 = STREAM_QUALITY)
+    잘못된 값은 오류 대신 가장 가까운 허용값으로 맞춘다(오래된 클라이언트/손으로 친 URL 대비).
+    """
+    if last_raw_frame is not None:
+        H, W = last_raw_frame.shape[:2]
+    else:
+        W = int(cap.get(cv2.CAP_PROP_FRAME_WIDTH) or 640) if cap else 640
+        H = int(cap.get(cv2.CAP_PROP_FRAME_HEIGHT) or 480) if cap else 480
+    scale = 1.0
+    if w > 0: scale = min(scale, w / W)
+    if h > 0: scale = min(scale, h / H)
+    size = (max(16, int(round(W * scale)) & ~1), max(16, int(round(H * scale)) & ~1))  # 짝수(크로마 서브샘플링)
+    if scale >= 1.0: size = (W, H)
+    out_fps = STREAM_FPS if fps <= 0 else min(STREAM_FPS, max(0.5, fps))
+    quality = STREAM_QUALITY if q <= 0 else min(95, max(20, q))
+    return {"size": size, "fps": out_fps, "quality": quality}
+
+def capture_ts_header(meta):
+    """ 캡처 시각 헤더 값(X-Capture-Ts: epoch ms, 소수 3자리). 클라이언트는 /clock으로 시계 차를 보정 """
+    return f"{meta.get('ts', time.time() * 1000.0):.3f}"
+
+def params_header(p):
+    """ 적용값을 클라이언트에 알리는 응답 헤더 값(X-Stream-Params: w=320;h=240;fps=8;q=50) """
+    return f"w={p['size'][0]};h={p['size'][1]};fps={p['fps']:g};q={p['quality']}"
+
 # -------------------- HTTP --------------------
 @app.get("/", response_class=HTMLResponse)
 def index():
@@ -402,27 +488,43 @@ def index():
 </body></html>'
 
 @app.get("/mjpeg")
-def mjpeg():
-    """ 실시간 MJPEG 스트림 엔드포인트. multipart/x-mixed-replace 사용. """
+def mjpeg(w: int = 0, h: int = 0, fps: float = 0, q: int = 0):
+    """ 실시간 MJPEG 스트림 엔드포인트. multipart/x-mixed-replace 사용.
+        ?w=&h=&fps=&q= 로 해상도/프레임레이트/품질을 낮춰 받을 수 있음(썸네일, 혼잡한 링크). """
+    p = stream_params(w, h, fps, q)
     def gen():
-        target_fps = STREAM_FPS               # 출력 FPS 상한
+        target_fps = p["fps"]                 # 출력 FPS 상한(요청값, STREAM_FPS 이하)
         period = 1.0/target_fps; last = time.time()
         while True:
-            jpg = render_frame()              # 프레임 생성(JPEG)
+            meta = {}
+            jpg = render_frame(p["size"], p["quality"], meta)  # 프레임 생성(JPEG)
             if jpg is None:
                 time.sleep(0.01); continue   # 프레임 실패 시 잠시 대기
             now=time.time(); sleep=period-(now-last)
             if sleep>0: time.sleep(sleep)     # FPS 유지
             last=time.time()
-            yield (b"--frame\r\nContent-Type: image/jpeg\r\n\r\n"+jpg+b"\r\n")  # 파트 경계와 함께 전송
-    return StreamingResponse(gen(), media_type="multipart/x-mixed-replace; boundary=frame")
+            # 파트 경계 + Content-Length(클라이언트가 본문을 검색 없이 바로 잘라낼 수 있게)
+            # + X-Capture-Ts(캡처 시각, 종단 지연 측정용)
+            yield (b"--frame\r\nContent-Type: image/jpeg\r\nContent-Length: "
+                   + str(len(jpg)).encode() + b"\r\nX-Capture-Ts: " + capture_ts_header(meta).encode()
+                   + b"\r\n\r\n" + jpg + b"\r\n")
+    return StreamingResponse(gen(), media_type="multipart/x-mixed-replace; boundary=frame",
+                             headers={"X-Stream-Params": params_header(p)})
 
 @app.get("/frame.jpg")
-def frame_jpg():
-    """ 단일 스냅샷 JPEG 반환(모니터링/디버그). 프레임 없으면 503. """
-    jpg = render_frame()
+def frame_jpg(w: int = 0, h: int = 0, q: int = 0):
+    """ 단일 스냅샷 JPEG 반환(모니터링/디버그). 프레임 없으면 503. w/h/q는 /mjpeg와 같음. """
+    p = stream_params(w, h, 0, q)
+    meta = {}
+    jpg = render_frame(p["size"], p["quality"], meta)
     if jpg is None: return Response(status_code=503)
-    return Response(jpg, media_type="image/jpeg")
+    return Response(jpg, media_type="image/jpeg",
+                    headers={"X-Stream-Params": params_header(p), "X-Capture-Ts": capture_ts_header(meta)})
+
+@app.get("/clock", response_class=PlainTextResponse)
+def clock():
+    """ 서버 현재 시각(epoch ms, 소수 3자리). 클라이언트가 X-Capture-Ts를 자기 시계로 옮길 때 씀 """
+    return f"{time.time() * 1000.0:.3f}"
 
 @app.get("/health", response_class=PlainTextResponse)
 def health():